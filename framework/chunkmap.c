@@ -0,0 +1,632 @@
+// chunkmap.c
+#include "chunkmap.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <limits.h>
+#include <zlib.h>
+#include <libxml/xmlreader.h>
+
+#define CHUNK_DEFAULT_SIZE 16
+#define CHUNK_INITIAL_BUCKETS 64
+
+// Division entière arrondie vers -infini (les cartes infinies ont des coordonnées négatives)
+static int floor_div(int a, int b)
+{
+    return (a >= 0) ? a / b : -((-a + b - 1) / b);
+}
+
+static unsigned chunk_hash(int x, int y)
+{
+    return ((unsigned)x * 73856093u) ^ ((unsigned)y * 19349663u);
+}
+
+static MapChunk *layer_find(ChunkLayer *layer, int x, int y)
+{
+    MapChunk *c = layer->buckets[chunk_hash(x, y) & (layer->bucket_count - 1)];
+    while (c)
+    {
+        if (c->x == x && c->y == y)
+            return c;
+        c = c->next;
+    }
+    return NULL;
+}
+
+static bool layer_insert(ChunkLayer *layer, MapChunk *chunk)
+{
+    // Agrandir la table si elle est trop chargée
+    if ((layer->chunk_count + 1) * 4 > layer->bucket_count * 3)
+    {
+        int new_count = layer->bucket_count * 2;
+        MapChunk **new_buckets = calloc(new_count, sizeof(MapChunk *));
+        if (!new_buckets)
+            return false;
+        for (int i = 0; i < layer->bucket_count; i++)
+        {
+            MapChunk *c = layer->buckets[i];
+            while (c)
+            {
+                MapChunk *next = c->next;
+                unsigned b = chunk_hash(c->x, c->y) & (new_count - 1);
+                c->next = new_buckets[b];
+                new_buckets[b] = c;
+                c = next;
+            }
+        }
+        free(layer->buckets);
+        layer->buckets = new_buckets;
+        layer->bucket_count = new_count;
+    }
+
+    unsigned b = chunk_hash(chunk->x, chunk->y) & (layer->bucket_count - 1);
+    chunk->next = layer->buckets[b];
+    layer->buckets[b] = chunk;
+    layer->chunk_count++;
+    return true;
+}
+
+static void extend_bounds(ChunkedMap *cm, MapChunk *chunk)
+{
+    if (chunk->x < cm->min_x)
+        cm->min_x = chunk->x;
+    if (chunk->y < cm->min_y)
+        cm->min_y = chunk->y;
+    if (chunk->x + chunk->width > cm->max_x)
+        cm->max_x = chunk->x + chunk->width;
+    if (chunk->y + chunk->height > cm->max_y)
+        cm->max_y = chunk->y + chunk->height;
+}
+
+static int base64_value(char c)
+{
+    if (c >= 'A' && c <= 'Z')
+        return c - 'A';
+    if (c >= 'a' && c <= 'z')
+        return c - 'a' + 26;
+    if (c >= '0' && c <= '9')
+        return c - '0' + 52;
+    if (c == '+')
+        return 62;
+    if (c == '/')
+        return 63;
+    return -1;
+}
+
+// Décode du base64 (les espaces sont ignorés), retourne la taille décodée
+static size_t base64_decode(const char *in, unsigned char *out, size_t out_size)
+{
+    size_t len = 0;
+    unsigned buffer = 0;
+    int bits = 0;
+    for (const char *p = in; *p && *p != '='; p++)
+    {
+        int v = base64_value(*p);
+        if (v < 0)
+            continue;
+        buffer = (buffer << 6) | (unsigned)v;
+        bits += 6;
+        if (bits >= 8)
+        {
+            bits -= 8;
+            if (len < out_size)
+                out[len] = (unsigned char)(buffer >> bits);
+            len++;
+        }
+    }
+    return len;
+}
+
+// Convertit les données encodées du chunk en cellules TMX (GID + bits de flip)
+static bool decode_cells(ChunkLayer *layer, MapChunk *chunk, uint32_t *cells, size_t count)
+{
+    if (!chunk->encoded)
+    {
+        memset(cells, 0, count * sizeof(uint32_t));
+        return true;
+    }
+
+    if (layer->encoding != CHUNK_ENCODING_BASE64)
+    {
+        const char *p = chunk->encoded;
+        for (size_t i = 0; i < count; i++)
+        {
+            char *end;
+            cells[i] = (uint32_t)strtoul(p, &end, 10);
+            if (end == p)
+                return false;
+            p = end;
+            while (*p == ',' || isspace((unsigned char)*p))
+                p++;
+        }
+        return true;
+    }
+
+    size_t encoded_len = strlen(chunk->encoded);
+    size_t raw_capacity = encoded_len * 3 / 4 + 3;
+    unsigned char *raw = malloc(raw_capacity);
+    if (!raw)
+        return false;
+    size_t raw_len = base64_decode(chunk->encoded, raw, raw_capacity);
+
+    unsigned char *bytes = raw;
+    unsigned char *inflated = NULL;
+    size_t byte_count = raw_len;
+
+    if (layer->compression == CHUNK_COMPRESSION_ZLIB)
+    {
+        inflated = malloc(count * 4);
+        if (!inflated)
+        {
+            free(raw);
+            return false;
+        }
+
+        z_stream strm;
+        memset(&strm, 0, sizeof(strm));
+        strm.next_in = raw;
+        strm.avail_in = (uInt)raw_len;
+        strm.next_out = inflated;
+        strm.avail_out = (uInt)(count * 4);
+
+        // 15 + 32 : détection automatique de l'en-tête zlib ou gzip
+        if (inflateInit2(&strm, 15 + 32) != Z_OK)
+        {
+            free(raw);
+            free(inflated);
+            return false;
+        }
+        int ret = inflate(&strm, Z_FINISH);
+        byte_count = strm.total_out;
+        inflateEnd(&strm);
+
+        if (ret != Z_STREAM_END)
+        {
+            free(raw);
+            free(inflated);
+            return false;
+        }
+        bytes = inflated;
+    }
+
+    bool ok = byte_count >= count * 4;
+    if (ok)
+    {
+        // Les GID sont stockés en little-endian
+        for (size_t i = 0; i < count; i++)
+        {
+            const unsigned char *b = &bytes[i * 4];
+            cells[i] = (uint32_t)b[0] | ((uint32_t)b[1] << 8) | ((uint32_t)b[2] << 16) | ((uint32_t)b[3] << 24);
+        }
+    }
+
+    free(raw);
+    free(inflated);
+    return ok;
+}
+
+static bool add_resident(ChunkedMap *cm, MapChunk *chunk)
+{
+    if (cm->resident_count >= cm->resident_capacity)
+    {
+        int new_capacity = (cm->resident_capacity == 0) ? 32 : cm->resident_capacity * 2;
+        MapChunk **resident = realloc(cm->resident, new_capacity * sizeof(MapChunk *));
+        if (!resident)
+            return false;
+        cm->resident = resident;
+        cm->resident_capacity = new_capacity;
+    }
+    chunk->resident_index = cm->resident_count;
+    cm->resident[cm->resident_count++] = chunk;
+    return true;
+}
+
+// Décode un chunk et l'ajoute à la liste des chunks résidents
+static bool load_chunk(ChunkedMap *cm, ChunkLayer *layer, MapChunk *chunk)
+{
+    if (chunk->gids)
+        return true;
+
+    size_t count = (size_t)chunk->width * chunk->height;
+    uint32_t *cells = malloc(count * sizeof(uint32_t));
+    chunk->gids = malloc(count * sizeof(uint32_t));
+    chunk->transforms = malloc(count * sizeof(uint8_t));
+
+    bool ok = cells && chunk->gids && chunk->transforms && decode_cells(layer, chunk, cells, count);
+    if (ok)
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            Tile_decodeCell(cells[i], &chunk->gids[i], &chunk->transforms[i]);
+        }
+        ok = add_resident(cm, chunk);
+    }
+    else
+    {
+        fprintf(stderr, "Erreur de décodage du chunk (%d, %d) du calque '%s'.\n", chunk->x, chunk->y, layer->name);
+        chunk->failed = true;
+    }
+
+    free(cells);
+    if (!ok)
+    {
+        free(chunk->gids);
+        free(chunk->transforms);
+        chunk->gids = NULL;
+        chunk->transforms = NULL;
+    }
+    return ok;
+}
+
+static void unload_chunk(ChunkedMap *cm, MapChunk *chunk)
+{
+    int index = chunk->resident_index;
+    if (index < 0)
+        return;
+
+    // Retrait par échange avec le dernier élément
+    MapChunk *last = cm->resident[--cm->resident_count];
+    cm->resident[index] = last;
+    last->resident_index = index;
+
+    free(chunk->gids);
+    free(chunk->transforms);
+    chunk->gids = NULL;
+    chunk->transforms = NULL;
+    chunk->resident_index = -1;
+}
+
+static int attr_int(xmlTextReaderPtr reader, const char *name, int default_value)
+{
+    xmlChar *value = xmlTextReaderGetAttribute(reader, BAD_CAST name);
+    if (!value)
+        return default_value;
+    int result = atoi((const char *)value);
+    xmlFree(value);
+    return result;
+}
+
+static char *attr_strdup(xmlTextReaderPtr reader, const char *name)
+{
+    xmlChar *value = xmlTextReaderGetAttribute(reader, BAD_CAST name);
+    if (!value)
+        return NULL;
+    char *result = strdup((const char *)value);
+    xmlFree(value);
+    return result;
+}
+
+static ChunkLayer *create_layer(const char *name)
+{
+    ChunkLayer *layer = calloc(1, sizeof(ChunkLayer));
+    if (!layer)
+        return NULL;
+    layer->name = strdup(name ? name : "");
+    layer->bucket_count = CHUNK_INITIAL_BUCKETS;
+    layer->buckets = calloc(layer->bucket_count, sizeof(MapChunk *));
+    if (!layer->name || !layer->buckets)
+    {
+        free(layer->name);
+        free(layer->buckets);
+        free(layer);
+        return NULL;
+    }
+    return layer;
+}
+
+static void parse_data_attributes(xmlTextReaderPtr reader, ChunkLayer *layer)
+{
+    char *encoding = attr_strdup(reader, "encoding");
+    char *compression = attr_strdup(reader, "compression");
+
+    // Sans attribut 'encoding' : balises <tile>, converties en csv par parse_chunk
+    layer->encoding = !encoding                       ? CHUNK_ENCODING_XML
+                      : strcmp(encoding, "base64") == 0 ? CHUNK_ENCODING_BASE64
+                                                        : CHUNK_ENCODING_CSV;
+    if (!compression)
+        layer->compression = CHUNK_COMPRESSION_NONE;
+    else if (strcmp(compression, "zlib") == 0 || strcmp(compression, "gzip") == 0)
+        layer->compression = CHUNK_COMPRESSION_ZLIB;
+    else
+    {
+        fprintf(stderr, "Compression '%s' non supportée pour le calque infini '%s'.\n", compression, layer->name);
+        layer->compression = CHUNK_COMPRESSION_UNSUPPORTED;
+    }
+
+    free(encoding);
+    free(compression);
+}
+
+// Lit les balises <tile gid="..."/> du chunk courant et les écrit en csv ;
+// les cellules absentes en fin de chunk sont vides
+static char *read_xml_tiles(xmlTextReaderPtr reader, size_t count)
+{
+    char *csv = malloc(count * 11 + 1); // 10 chiffres max par GID, plus la virgule
+    if (!csv)
+        return NULL;
+    size_t len = 0, n = 0;
+    csv[0] = '\0';
+
+    int depth = xmlTextReaderDepth(reader);
+    if (!xmlTextReaderIsEmptyElement(reader))
+    {
+        while (xmlTextReaderRead(reader) == 1 && xmlTextReaderDepth(reader) > depth)
+        {
+            if (xmlTextReaderNodeType(reader) != XML_READER_TYPE_ELEMENT ||
+                strcmp((const char *)xmlTextReaderConstName(reader), "tile") != 0 || n >= count)
+                continue;
+            xmlChar *gid = xmlTextReaderGetAttribute(reader, BAD_CAST "gid");
+            unsigned long value = gid ? strtoul((const char *)gid, NULL, 10) : 0;
+            xmlFree(gid);
+            len += sprintf(csv + len, n++ ? ",%lu" : "%lu", value);
+        }
+    }
+    for (; n < count; n++)
+        len += sprintf(csv + len, n ? ",0" : "0");
+    return csv;
+}
+
+static bool parse_chunk(xmlTextReaderPtr reader, ChunkedMap *cm, ChunkLayer *layer)
+{
+    if (layer->compression == CHUNK_COMPRESSION_UNSUPPORTED)
+        return true;
+
+    MapChunk *chunk = calloc(1, sizeof(MapChunk));
+    if (!chunk)
+        return false;
+
+    chunk->x = attr_int(reader, "x", 0);
+    chunk->y = attr_int(reader, "y", 0);
+    chunk->width = attr_int(reader, "width", CHUNK_DEFAULT_SIZE);
+    chunk->height = attr_int(reader, "height", CHUNK_DEFAULT_SIZE);
+    chunk->resident_index = -1;
+
+    // Tous les chunks d'une carte ont la même taille, le premier la fixe
+    if (cm->chunk_width == 0)
+    {
+        cm->chunk_width = chunk->width;
+        cm->chunk_height = chunk->height;
+    }
+
+    // Seules les données encodées sont conservées, le décodage est différé
+    xmlChar *content = NULL;
+    if (layer->encoding == CHUNK_ENCODING_XML)
+    {
+        chunk->encoded = read_xml_tiles(reader, (size_t)chunk->width * chunk->height);
+        if (!chunk->encoded)
+        {
+            free(chunk);
+            return false;
+        }
+    }
+    else
+        content = xmlTextReaderReadString(reader);
+    if (content)
+    {
+        const char *start = (const char *)content;
+        while (isspace((unsigned char)*start))
+            start++;
+        chunk->encoded = strdup(start);
+        xmlFree(content);
+    }
+
+    if (!layer_insert(layer, chunk))
+    {
+        free(chunk->encoded);
+        free(chunk);
+        return false;
+    }
+    extend_bounds(cm, chunk);
+    return true;
+}
+
+ChunkedMap *ChunkedMap_load(const char *filePath)
+{
+    xmlTextReaderPtr reader = xmlReaderForFile(filePath, NULL, XML_PARSE_NONET);
+    if (!reader)
+    {
+        fprintf(stderr, "Erreur libxml2: impossible d'ouvrir '%s'\n", filePath);
+        return NULL;
+    }
+
+    ChunkedMap *cm = NULL;
+    ChunkLayer *current = NULL;
+    ChunkLayer **tail = NULL;
+    bool ok = true;
+
+    while (ok && xmlTextReaderRead(reader) == 1)
+    {
+        if (xmlTextReaderNodeType(reader) != XML_READER_TYPE_ELEMENT)
+            continue;
+
+        const char *name = (const char *)xmlTextReaderConstName(reader);
+
+        if (!cm)
+        {
+            if (strcmp(name, "map") != 0)
+                continue;
+            // Carte finie : libTMX s'en occupe seul
+            if (attr_int(reader, "infinite", 0) != 1)
+                break;
+
+            cm = calloc(1, sizeof(ChunkedMap));
+            if (!cm)
+                break;
+            cm->tile_width = attr_int(reader, "tilewidth", 16);
+            cm->tile_height = attr_int(reader, "tileheight", 16);
+            cm->min_x = cm->min_y = INT_MAX;
+            cm->max_x = cm->max_y = INT_MIN;
+            tail = &cm->layers;
+        }
+        else if (strcmp(name, "layer") == 0)
+        {
+            xmlChar *layer_name = xmlTextReaderGetAttribute(reader, BAD_CAST "name");
+            current = create_layer((const char *)layer_name);
+            xmlFree(layer_name);
+            if (!current)
+            {
+                ok = false;
+                break;
+            }
+            *tail = current;
+            tail = &current->next;
+        }
+        else if (strcmp(name, "data") == 0 && current)
+        {
+            parse_data_attributes(reader, current);
+        }
+        else if (strcmp(name, "chunk") == 0 && current)
+        {
+            ok = parse_chunk(reader, cm, current);
+        }
+        else if (strcmp(name, "objectgroup") == 0 || strcmp(name, "imagelayer") == 0)
+        {
+            current = NULL;
+        }
+    }
+
+    xmlFreeTextReader(reader);
+
+    if (cm && !ok)
+    {
+        fprintf(stderr, "Erreur lors de l'indexation des chunks de '%s'\n", filePath);
+        ChunkedMap_free(cm);
+        return NULL;
+    }
+    if (cm && cm->chunk_width == 0)
+    {
+        cm->chunk_width = CHUNK_DEFAULT_SIZE;
+        cm->chunk_height = CHUNK_DEFAULT_SIZE;
+    }
+    return cm;
+}
+
+void ChunkedMap_free(ChunkedMap *cm)
+{
+    if (!cm)
+        return;
+
+    ChunkLayer *layer = cm->layers;
+    while (layer)
+    {
+        ChunkLayer *next_layer = layer->next;
+        for (int i = 0; i < layer->bucket_count; i++)
+        {
+            MapChunk *c = layer->buckets[i];
+            while (c)
+            {
+                MapChunk *next = c->next;
+                free(c->encoded);
+                free(c->gids);
+                free(c->transforms);
+                free(c);
+                c = next;
+            }
+        }
+        free(layer->buckets);
+        free(layer->name);
+        free(layer);
+        layer = next_layer;
+    }
+    free(cm->resident);
+    free(cm);
+}
+
+ChunkLayer *ChunkedMap_findLayer(ChunkedMap *cm, const char *name)
+{
+    if (!cm || !name)
+        return NULL;
+    for (ChunkLayer *layer = cm->layers; layer; layer = layer->next)
+    {
+        if (strcmp(layer->name, name) == 0)
+            return layer;
+    }
+    return NULL;
+}
+
+void ChunkedMap_update(ChunkedMap *cm, SDL_Rect view, int prefetchRadius)
+{
+    if (!cm)
+        return;
+
+    int cw = cm->chunk_width, ch = cm->chunk_height;
+
+    // Plage de chunks couverte par la vue, en indices de chunk
+    int first_cx = floor_div(floor_div(view.x, cm->tile_width), cw) - prefetchRadius;
+    int first_cy = floor_div(floor_div(view.y, cm->tile_height), ch) - prefetchRadius;
+    int last_cx = floor_div(floor_div(view.x + view.w - 1, cm->tile_width), cw) + prefetchRadius;
+    int last_cy = floor_div(floor_div(view.y + view.h - 1, cm->tile_height), ch) + prefetchRadius;
+
+    for (ChunkLayer *layer = cm->layers; layer; layer = layer->next)
+    {
+        for (int cy = first_cy; cy <= last_cy; cy++)
+        {
+            for (int cx = first_cx; cx <= last_cx; cx++)
+            {
+                MapChunk *chunk = layer_find(layer, cx * cw, cy * ch);
+                if (chunk && !chunk->gids && !chunk->failed)
+                {
+                    load_chunk(cm, layer, chunk);
+                }
+            }
+        }
+    }
+
+    // Libérer les chunks sortis de la zone (un chunk de marge pour éviter les allers-retours)
+    for (int i = cm->resident_count - 1; i >= 0; i--)
+    {
+        MapChunk *chunk = cm->resident[i];
+        if (chunk->modified)
+            continue;
+        int cx = floor_div(chunk->x, cw);
+        int cy = floor_div(chunk->y, ch);
+        if (cx < first_cx - 1 || cx > last_cx + 1 || cy < first_cy - 1 || cy > last_cy + 1)
+        {
+            unload_chunk(cm, chunk);
+        }
+    }
+}
+
+MapChunk *ChunkLayer_getChunk(ChunkedMap *cm, ChunkLayer *layer, int chunkX, int chunkY)
+{
+    if (!cm || !layer)
+        return NULL;
+    return layer_find(layer, chunkX, chunkY);
+}
+
+bool ChunkLayer_setTile(ChunkedMap *cm, ChunkLayer *layer, int x, int y, uint32_t cell)
+{
+    if (!cm || !layer)
+        return false;
+
+    int origin_x = floor_div(x, cm->chunk_width) * cm->chunk_width;
+    int origin_y = floor_div(y, cm->chunk_height) * cm->chunk_height;
+
+    MapChunk *chunk = layer_find(layer, origin_x, origin_y);
+    if (!chunk)
+    {
+        chunk = calloc(1, sizeof(MapChunk));
+        if (!chunk)
+            return false;
+        chunk->x = origin_x;
+        chunk->y = origin_y;
+        chunk->width = cm->chunk_width;
+        chunk->height = cm->chunk_height;
+        chunk->resident_index = -1;
+        if (!layer_insert(layer, chunk))
+        {
+            free(chunk);
+            return false;
+        }
+        extend_bounds(cm, chunk);
+    }
+
+    if (chunk->failed || !load_chunk(cm, layer, chunk))
+        return false;
+
+    int index = (y - chunk->y) * chunk->width + (x - chunk->x);
+    Tile_decodeCell(cell, &chunk->gids[index], &chunk->transforms[index]);
+    chunk->modified = true;
+    return true;
+}
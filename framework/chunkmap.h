@@ -0,0 +1,102 @@
+// chunkmap.h
+#ifndef CHUNKMAP_H
+#define CHUNKMAP_H
+
+#include <SDL2/SDL.h>
+#include <tmx.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+// Support des cartes TMX infinies (infinite="1") : chaque calque est découpé en chunks
+// stockés sous leur forme encodée (csv / base64, compressée ou non) et décodés
+// uniquement lorsqu'ils entrent dans le rayon de préchargement de la caméra.
+// Les chunks en XML (une balise <tile> par cellule) sont convertis en csv à l'indexation.
+
+// Nombre de chunks préchargés autour de la vue de la caméra
+#define CHUNK_PREFETCH_RADIUS 1
+
+typedef enum
+{
+    CHUNK_ENCODING_CSV,
+    CHUNK_ENCODING_BASE64,
+    CHUNK_ENCODING_XML // Converti en csv à l'indexation
+} ChunkEncoding;
+
+typedef enum
+{
+    CHUNK_COMPRESSION_NONE,
+    CHUNK_COMPRESSION_ZLIB, // zlib ou gzip (détection automatique)
+    CHUNK_COMPRESSION_UNSUPPORTED
+} ChunkCompression;
+
+typedef struct MapChunk
+{
+    int x, y;          // Position du chunk en tuiles (coin haut-gauche)
+    int width, height; // Taille en tuiles
+    char *encoded;     // Données telles que lues dans le TMX (NULL pour un chunk créé à la volée)
+
+    uint32_t *gids;      // GID sans bits de flip, NULL tant que le chunk n'est pas résident
+    uint8_t *transforms; // Index de flip/rotation par tuile
+    bool modified;       // Modifié par Map_setTile : reste résident jusqu'au freeMap
+    bool failed;         // Données invalides : le décodage n'est pas retenté
+    int resident_index;  // Position dans ChunkedMap::resident, -1 si non décodé
+
+    struct MapChunk *next; // Chaînage dans la table de hachage du calque
+} MapChunk;
+
+typedef struct ChunkLayer
+{
+    char *name;
+    ChunkEncoding encoding;
+    ChunkCompression compression;
+
+    MapChunk **buckets; // Table de hachage indexée par coordonnées de chunk
+    int bucket_count;   // Puissance de 2
+    int chunk_count;
+
+    struct ChunkLayer *next;
+} ChunkLayer;
+
+typedef struct
+{
+    ChunkLayer *layers;
+    int chunk_width, chunk_height; // Taille des chunks en tuiles (16x16 par défaut dans Tiled)
+    int tile_width, tile_height;
+
+    // Étendue connue de la carte, en tuiles (min > max tant qu'aucun chunk n'existe)
+    int min_x, min_y, max_x, max_y;
+
+    // Chunks actuellement décodés (tous calques confondus)
+    MapChunk **resident;
+    int resident_count;
+    int resident_capacity;
+} ChunkedMap;
+
+// Sépare le GID et les bits de flip TMX d'une cellule
+// 'transform' vaut (H << 2) | (V << 1) | D
+static inline void Tile_decodeCell(uint32_t cell, uint32_t *gid, uint8_t *transform)
+{
+    *gid = cell & TMX_FLIP_BITS_REMOVAL;
+    *transform = (uint8_t)((cell & ~(uint32_t)TMX_FLIP_BITS_REMOVAL) >> 29);
+}
+
+// Indexe les chunks d'une carte infinie, sans les décoder
+// Retourne NULL si la carte n'est pas infinie ou en cas d'erreur
+ChunkedMap *ChunkedMap_load(const char *filePath);
+
+void ChunkedMap_free(ChunkedMap *cm);
+
+ChunkLayer *ChunkedMap_findLayer(ChunkedMap *cm, const char *name);
+
+// Décode les chunks qui entrent dans la vue (+ rayon de préchargement, en chunks)
+// et libère ceux qui s'en sont éloignés
+void ChunkedMap_update(ChunkedMap *cm, SDL_Rect view, int prefetchRadius);
+
+// Retourne le chunk qui commence en (chunkX, chunkY) (en tuiles), NULL s'il n'existe pas
+MapChunk *ChunkLayer_getChunk(ChunkedMap *cm, ChunkLayer *layer, int chunkX, int chunkY);
+
+// Modifie une tuile (coordonnées en tuiles, éventuellement négatives)
+// Le chunk est créé et décodé si nécessaire
+bool ChunkLayer_setTile(ChunkedMap *cm, ChunkLayer *layer, int x, int y, uint32_t cell);
+
+#endif // CHUNKMAP_H
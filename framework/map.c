@@ -4,6 +4,10 @@
 #include <stdlib.h>
 #include <string.h>
 #include <SDL2/SDL_image.h>
+#include "../systems/resources.h"
+
+// PNJs par intervalle de la mise à jour parallèle
+#define PNJ_UPDATE_GRAIN 64
 
 // Global renderer pour le loader
 static SDL_Renderer *global_renderer = NULL;
@@ -11,12 +15,7 @@ static SDL_Renderer *global_renderer = NULL;
 // Callback pour charger les textures via SDL_Image
 static void *SDL_tex_loader(const char *path)
 {
-    SDL_Texture *tex = IMG_LoadTexture(global_renderer, path);
-    if (!tex)
-    {
-        fprintf(stderr, "Erreur SDL_Image: %s\n", IMG_GetError());
-    }
-    return tex;
+    return Resources_loadTexture(global_renderer, path);
 }
 
 // Callback pour libérer les textures
@@ -25,6 +24,74 @@ static void SDL_tex_deleter(void *res)
     SDL_DestroyTexture((SDL_Texture *)res);
 }
 
+// Avec un manifeste actif, tmx_load ne fait que relever les images : chaque
+// resource_image reçoit provisoirement l'index de son image + 1, remplacé par la
+// texture une fois toutes les images décodées en parallèle (resolve_images)
+static void *record_image(const char *path)
+{
+    int index = ResourceManifest_add(Resources_getActive(), path);
+    return index >= 0 ? (void *)(intptr_t)(index + 1) : NULL;
+}
+
+static void forget_image(void *res)
+{
+    (void)res;
+}
+
+// false si l'image n'a pas pu être décodée ; elle reçoit alors NULL, pour que
+// tmx_map_free ne prenne pas l'index pour une texture
+static bool resolve_image(tmx_image *image, ResourceManifest *resources)
+{
+    if (!image || !image->resource_image)
+        return true;
+    int index = (int)(intptr_t)image->resource_image - 1;
+    SDL_Surface *surface = ResourceManifest_surface(resources, index);
+    image->resource_image = surface ? SDL_CreateTextureFromSurface(global_renderer, surface) : NULL;
+    SDL_FreeSurface(surface);
+    return image->resource_image != NULL;
+}
+
+static bool resolve_layer_images(tmx_layer *layer, ResourceManifest *resources)
+{
+    bool ok = true;
+    for (; layer; layer = layer->next)
+    {
+        if (layer->type == L_IMAGE)
+            ok = resolve_image(layer->content.image, resources) && ok;
+        else if (layer->type == L_GROUP)
+            ok = resolve_layer_images(layer->content.group_head, resources) && ok;
+    }
+    return ok;
+}
+
+// Toutes les images sont résolues même après un échec : la carte peut alors être libérée
+static bool resolve_images(tmx_map *tmx, ResourceManifest *resources)
+{
+    bool ok = true;
+    for (tmx_tileset_list *ts = tmx->ts_head; ts; ts = ts->next)
+    {
+        tmx_tileset *tileset = ts->tileset;
+        ok = resolve_image(tileset->image, resources) && ok;
+        for (unsigned int i = 0; tileset->tiles && i < tileset->tilecount; i++)
+            ok = resolve_image(tileset->tiles[i].image, resources) && ok;
+    }
+    return resolve_layer_images(tmx->ly_head, resources) && ok;
+}
+
+// Feuilles des PNJs (propriété "sprite"), décodées avec les tilesets
+static void record_pnj_sheets(tmx_map *tmx, ResourceManifest *resources)
+{
+    tmx_layer *layer = tmx_find_layer_by_name(tmx, "PNJObject");
+    if (!layer || layer->type != L_OBJGR)
+        return;
+    for (tmx_object *o = layer->content.objgr->head; o; o = o->next)
+    {
+        tmx_property *sprite_prop = tmx_get_property(o->properties, "sprite");
+        if (o->name && strncmp(o->name, "PNJ", 3) == 0 && sprite_prop && sprite_prop->type == PT_STRING)
+            ResourceManifest_add(resources, sprite_prop->value.string);
+    }
+}
+
 // Structure pour stocker les informations d'une tuile animée
 typedef struct
 {
@@ -40,13 +107,157 @@ static AnimatedTileInfo *animated_tiles_infos = NULL;
 static int animated_tiles_count = 0;
 static int animated_tiles_capacity = 0;
 
+// Transformation SDL équivalente aux bits de flip TMX (horizontal, vertical, diagonal)
+typedef struct
+{
+    SDL_RendererFlip flip;
+    double angle;
+} TileTransform;
+
+// Indexé par (H << 2) | (V << 1) | D. SDL applique le flip avant la rotation,
+// la diagonale TMX (transposition) devient donc un flip vertical + 90°
+static const TileTransform tile_transforms[8] = {
+    {SDL_FLIP_NONE, 0.0},                                            // -
+    {SDL_FLIP_VERTICAL, 90.0},                                       // D
+    {SDL_FLIP_VERTICAL, 0.0},                                        // V
+    {SDL_FLIP_NONE, 270.0},                                          // V + D
+    {SDL_FLIP_HORIZONTAL, 0.0},                                      // H
+    {SDL_FLIP_NONE, 90.0},                                           // H + D
+    {(SDL_RendererFlip)(SDL_FLIP_HORIZONTAL | SDL_FLIP_VERTICAL), 0.0}, // H + V
+    {SDL_FLIP_HORIZONTAL, 90.0},                                     // H + V + D
+};
+
+// Cache d'un calque de tuiles, décodé une seule fois au chargement
+// (stocké dans layer->user_data.pointer)
+typedef struct
+{
+    uint32_t *gids;      // GID sans les bits de flip
+    uint8_t *transforms; // Index dans tile_transforms
+
+    // Carte infinie : les tuiles sont dans les chunks, 'gids' et 'transforms' restent NULL
+    ChunkedMap *chunked;
+    ChunkLayer *chunk_layer;
+
+    // Calque "ysort" : ses tuiles passent par la file de rendu, triées avec les entités
+    bool ysort;
+    int sort_layer;  // Layer de rendu (propriété "layer", 1 par défaut comme les entités)
+    int32_t *foot_y; // Bas (en pixels) de la colonne de tuiles contiguës contenant chaque cellule
+} TileLayerCache;
+
 // Déclarations des fonctions statiques
-static void draw_tile(SDL_Renderer *ren, tmx_tile *tile, int dx, int dy, int tile_width, int tile_height, int offsetX, int offsetY);
-static void draw_layer(SDL_Renderer *ren, tmx_map *m, tmx_layer *layer, uint32_t current_time, int offsetX, int offsetY);
+static void draw_tile(SDL_Renderer *ren, tmx_tile *tile, uint8_t transform, int dx, int dy, int tile_width, int tile_height, int offsetX, int offsetY);
+static void draw_cell(SDL_Renderer *ren, tmx_map *m, uint32_t gid, uint8_t transform, int dx, int dy, int offsetX, int offsetY);
+static void draw_layer(SDL_Renderer *ren, tmx_map *m, tmx_layer *layer, int offsetX, int offsetY);
+static void draw_chunked_layer(SDL_Renderer *ren, tmx_map *m, TileLayerCache *cache, int offsetX, int offsetY);
 static void draw_objects(SDL_Renderer *ren, tmx_object_group *og, int offsetX, int offsetY);
 static void draw_image_layer(SDL_Renderer *ren, tmx_image *img, int offsetX, int offsetY);
-static void recurse_layers(SDL_Renderer *ren, tmx_map *m, tmx_layer *layer, uint32_t current_time, int offsetX, int offsetY);
+static void recurse_layers(SDL_Renderer *ren, tmx_map *m, tmx_layer *layer, int offsetX, int offsetY);
 static void add_animated_tile_info(tmx_tile *tile, uint32_t first_gid);
+static void init_layer_caches(Map *map, tmx_layer *layer);
+static void init_ysort(Map *map, tmx_layer *layer, TileLayerCache *cache);
+static void update_ysort_column(tmx_map *m, TileLayerCache *cache, unsigned x);
+static tmx_tile *resolve_tile(tmx_map *m, uint32_t gid);
+static void queue_ysorted_layers(RenderQueue *queue, tmx_map *m, tmx_layer *layer, Camera *camera);
+static Pathfinder *build_navigation(Map *map);
+static void print_pnj_line(void *user, void *owner, const char *text);
+static bool walk_pnj_to(void *user, void *owner, int tileX, int tileY);
+static void cancel_pnj_walk(void *user, void *owner);
+static EncounterMap *load_encounters(Map *map);
+
+// Prépare un calque marqué "ysort" : chaque tuile est triée selon le bas de
+// l'objet auquel elle appartient (colonne de tuiles non vides contiguës)
+static void init_ysort(Map *map, tmx_layer *layer, TileLayerCache *cache)
+{
+    tmx_property *ysort_prop = tmx_get_property(layer->properties, "ysort");
+    if (!ysort_prop || ysort_prop->type != PT_BOOL || !ysort_prop->value.boolean)
+        return;
+
+    tmx_map *m = map->tmx_map;
+    cache->foot_y = Arena_alloc(map->arena, (size_t)m->width * m->height * sizeof(int32_t));
+    if (!cache->foot_y)
+        return;
+
+    cache->ysort = true;
+    cache->sort_layer = 1;
+    tmx_property *layer_prop = tmx_get_property(layer->properties, "layer");
+    if (layer_prop && layer_prop->type == PT_INT)
+        cache->sort_layer = layer_prop->value.integer;
+
+    for (unsigned x = 0; x < m->width; x++)
+        update_ysort_column(m, cache, x);
+}
+
+// Clés de tri de la colonne 'x' : une tuile posée ou effacée déplace le bas de
+// toute la colonne contiguë au-dessus d'elle
+static void update_ysort_column(tmx_map *m, TileLayerCache *cache, unsigned x)
+{
+    int32_t foot = 0;
+    for (int y = (int)m->height - 1; y >= 0; y--)
+    {
+        unsigned index = y * m->width + x;
+        if (cache->gids[index] == 0)
+        {
+            foot = 0;
+            continue;
+        }
+        if (foot == 0)
+            foot = (y + 1) * m->tile_height; // Bas d'un nouvel objet
+        cache->foot_y[index] = foot;
+    }
+}
+
+// Construit le cache de chaque calque de tuiles (récursif pour les groupes)
+// Les caches sont alloués dans l'arena de la carte
+static void init_layer_caches(Map *map, tmx_layer *layer)
+{
+    tmx_map *m = map->tmx_map;
+    while (layer)
+    {
+        ChunkLayer *chunk_layer = NULL;
+        if (layer->type == L_LAYER)
+            chunk_layer = ChunkedMap_findLayer(map->chunks, layer->name);
+
+        if (layer->type == L_GROUP)
+        {
+            init_layer_caches(map, layer->content.group_head);
+        }
+        else if (chunk_layer)
+        {
+            TileLayerCache *cache = Arena_calloc(map->arena, 1, sizeof(TileLayerCache));
+            if (cache)
+            {
+                cache->chunked = map->chunks;
+                cache->chunk_layer = chunk_layer;
+            }
+            layer->user_data.pointer = cache;
+        }
+        else if (layer->type == L_LAYER && layer->content.gids)
+        {
+            size_t count = (size_t)m->width * m->height;
+            TileLayerCache *cache = Arena_calloc(map->arena, 1, sizeof(TileLayerCache));
+            if (cache)
+            {
+                cache->gids = Arena_alloc(map->arena, count * sizeof(uint32_t));
+                cache->transforms = Arena_alloc(map->arena, count * sizeof(uint8_t));
+                if (!cache->gids || !cache->transforms)
+                {
+                    fprintf(stderr, "Erreur d'allocation mémoire pour le cache du calque '%s'.\n", layer->name);
+                    cache = NULL;
+                }
+                else
+                {
+                    for (size_t i = 0; i < count; i++)
+                    {
+                        Tile_decodeCell(layer->content.gids[i], &cache->gids[i], &cache->transforms[i]);
+                    }
+                    init_ysort(map, layer, cache);
+                }
+            }
+            layer->user_data.pointer = cache;
+        }
+        layer = layer->next;
+    }
+}
 
 // Fonction utilitaire pour ajouter une tuile animée à notre liste
 static void add_animated_tile_info(tmx_tile *tile, uint32_t first_gid)
@@ -109,32 +320,67 @@ void DeBugMap(Map *map)
 Map *loadMap(const char *filePath, SDL_Renderer *renderer)
 {
     global_renderer = renderer;
-    tmx_img_load_func = SDL_tex_loader;
-    tmx_img_free_func = SDL_tex_deleter;
+    ResourceManifest *resources = Resources_getActive();
+    tmx_img_load_func = resources ? record_image : SDL_tex_loader;
+    tmx_img_free_func = resources ? forget_image : SDL_tex_deleter;
+
+    // Toute la mémoire de durée de vie de la carte vient de cette arena, y compris Map
+    Arena *arena = Arena_create(64 * 1024);
+    if (!arena)
+        return NULL;
 
-    Map *map = malloc(sizeof(Map));
+    Map *map = Arena_calloc(arena, 1, sizeof(Map));
     if (!map)
+    {
+        Arena_free(arena);
         return NULL;
+    }
+    map->arena = arena;
 
     map->tmx_map = tmx_load(filePath);
+    tmx_img_free_func = SDL_tex_deleter;
     if (!map->tmx_map)
     {
         fprintf(stderr, "Erreur libTMX: %s\n", tmx_strerr());
-        free(map);
+        Arena_free(arena);
         return NULL;
     }
+    if (resources)
+    {
+        record_pnj_sheets(map->tmx_map, resources);
+        ResourceManifest_decode(resources);
+        // Comme avec le chargeur de libTMX, une image illisible fait échouer la carte
+        if (!resolve_images(map->tmx_map, resources))
+        {
+            fprintf(stderr, "Erreur: images de la carte %s non chargées\n", filePath);
+            tmx_map_free(map->tmx_map);
+            Arena_free(arena);
+            return NULL;
+        }
+    }
+
+    // NULL pour une carte finie
+    map->chunks = ChunkedMap_load(filePath);
 
     map->default_x_spawn = map->default_y_spawn = 0.0f;
     Map_getPlayerSpawn(map, &map->default_x_spawn, &map->default_y_spawn);
 
     map->collisions = Map_getCollisionObjects(map, "CollisionObject", &map->collision_count);
+    map->pathfinder = build_navigation(map);
+    map->encounters = load_encounters(map);
 
     map->pnjs = NULL;
     map->pnj_count = 0;
+    map->script_host = (ScriptHost){NULL, NULL, NULL, print_pnj_line, walk_pnj_to, cancel_pnj_walk};
+    map->entities = EntityStore_create(16);
+    map->spatial = SpatialHash_create(32, SPATIAL_CELL_SIZE);
+    if (map->entities)
+        EntityStore_setSpatialHash(map->entities, map->spatial);
     Map_initPNJs(map, renderer);
 
     // DeBugMap(map);
     Map_initAnimations(map);
+    init_layer_caches(map, map->tmx_map->ly_head);
 
     return map;
 }
@@ -143,36 +389,25 @@ void freeMap(Map *map)
 {
     if (map)
     {
-        if (map->collisions)
-        {
-            for (int i = 0; i < map->collision_count; i++)
-            {
-                free(map->collisions[i].name);
-                free(map->collisions[i].type);
-                // Libérer les points des polygones
-                if (map->collisions[i].polygon_points)
-                {
-                    free(map->collisions[i].polygon_points);
-                }
-            }
-            free(map->collisions);
-        }
+        // Les recherches en cours sur les threads référencent la grille et les PNJs
+        Pathfinder_detachJobs(map->pathfinder);
 
-        // Libérer les PNJs
-        if (map->pnjs)
+        // Les PNJs possèdent des textures SDL, le reste de leur mémoire est dans l'arena
+        for (int i = 0; i < map->pnj_count; i++)
         {
-            for (int i = 0; i < map->pnj_count; i++)
+            if (map->pnjs[i])
             {
-                if (map->pnjs[i])
-                {
-                    freePNJ(map->pnjs[i]);
-                }
+                freePNJ(map->pnjs[i]);
             }
-            free(map->pnjs);
         }
+        EntityStore_free(map->entities);
+        SpatialHash_free(map->spatial);
 
+        ChunkedMap_free(map->chunks);
         tmx_map_free(map->tmx_map);
-        free(map);
+
+        // Collisions, PNJs, caches de calques et la structure Map elle-même
+        Arena_free(map->arena);
     }
     if (animated_tiles_infos)
     {
@@ -183,8 +418,52 @@ void freeMap(Map *map)
     }
 }
 
+// Vrai si l'image 'source' (relative au fichier TMX/TSX, "../tileset/...") désigne 'path'
+static bool image_matches(const tmx_image *image, const char *path)
+{
+    if (!image || !image->source || !image->resource_image)
+        return false;
+    const char *source = image->source;
+    while (strncmp(source, "../", 3) == 0)
+        source += 3;
+    size_t path_len = strlen(path), source_len = strlen(source);
+    if (source_len > path_len || strcmp(path + path_len - source_len, source) != 0)
+        return false;
+    return source_len == path_len || path[path_len - source_len - 1] == '/';
+}
+
+static bool reload_image(tmx_image *image, const char *path, SDL_Renderer *renderer)
+{
+    SDL_Texture *tex = Resources_loadTexture(renderer, path);
+    if (!tex)
+        return false;
+    SDL_DestroyTexture((SDL_Texture *)image->resource_image);
+    image->resource_image = tex;
+    return true;
+}
+
+int Map_reloadImage(Map *map, const char *path, SDL_Renderer *renderer)
+{
+    int reloaded = 0;
+    for (tmx_tileset_list *ts = map->tmx_map->ts_head; ts; ts = ts->next)
+    {
+        tmx_tileset *tileset = ts->tileset;
+        if (image_matches(tileset->image, path))
+            reloaded += reload_image(tileset->image, path, renderer);
+
+        // Tilesets "collection d'images" : une image par tuile
+        for (unsigned int i = 0; tileset->tiles && i < tileset->tilecount; i++)
+        {
+            if (image_matches(tileset->tiles[i].image, path))
+                reloaded += reload_image(tileset->tiles[i].image, path, renderer);
+        }
+    }
+    return reloaded;
+}
+
 // Modification de draw_tile pour accepter un tmx_tile* qui est la frame actuelle et offsets
-static void draw_tile(SDL_Renderer *ren, tmx_tile *tile, int dx, int dy, int tile_width, int tile_height, int offsetX, int offsetY)
+// 'transform' est l'index du flip/rotation décodé au chargement
+static void draw_tile(SDL_Renderer *ren, tmx_tile *tile, uint8_t transform, int dx, int dy, int tile_width, int tile_height, int offsetX, int offsetY)
 {
     if (!tile)
         return;
@@ -196,64 +475,108 @@ static void draw_tile(SDL_Renderer *ren, tmx_tile *tile, int dx, int dy, int til
 
     SDL_Rect src = {tile->ul_x, tile->ul_y, tile->width, tile->height};
     SDL_Rect dst = {dx + offsetX, dy + offsetY, tile_width, tile_height}; // Apply offsets
-    SDL_RenderCopy(ren, tex, &src, &dst);
+    if (transform == 0)
+    {
+        SDL_RenderCopy(ren, tex, &src, &dst);
+    }
+    else
+    {
+        const TileTransform *t = &tile_transforms[transform];
+        SDL_RenderCopyEx(ren, tex, &src, &dst, t->angle, NULL, t->flip);
+    }
+}
+
+// Retourne la tuile à afficher pour un GID, en tenant compte de son animation
+static tmx_tile *resolve_tile(tmx_map *m, uint32_t gid)
+{
+    tmx_tile *tile = m->tiles[gid]; // Obtient la tuile originale
+    if (!tile)
+        return NULL;
+
+    // Tuile animée : la frame courante est choisie par Map_updateAnimations
+    if (tile->animation && tile->user_data.pointer)
+        return tile->user_data.pointer;
+    return tile;
+}
+
+// Dessine une cellule de calque en résolvant son animation éventuelle
+static void draw_cell(SDL_Renderer *ren, tmx_map *m, uint32_t gid, uint8_t transform, int dx, int dy, int offsetX, int offsetY)
+{
+    tmx_tile *tile_to_draw = resolve_tile(m, gid);
+    if (!tile_to_draw)
+        return;
+    draw_tile(ren, tile_to_draw, transform, dx, dy, m->tile_width, m->tile_height, offsetX, offsetY);
 }
 
-// La fonction draw_layer prend maintenant un 'current_time' et offsets
-static void draw_layer(SDL_Renderer *ren, tmx_map *m, tmx_layer *layer, uint32_t current_time, int offsetX, int offsetY)
+// La fonction draw_layer prend les offsets de la caméra
+static void draw_layer(SDL_Renderer *ren, tmx_map *m, tmx_layer *layer, int offsetX, int offsetY)
 {
     if (!layer->visible || layer->type != L_LAYER)
         return;
+    TileLayerCache *cache = (TileLayerCache *)layer->user_data.pointer;
+    if (!cache)
+        return;
+    if (cache->chunk_layer)
+    {
+        draw_chunked_layer(ren, m, cache, offsetX, offsetY);
+        return;
+    }
+    if (cache->ysort)
+        return; // Dessiné via la file de rendu (Map_queueYSortedLayers)
     unsigned w = m->width, h = m->height;
 
     for (unsigned y = 0; y < h; y++)
     {
         for (unsigned x = 0; x < w; x++)
         {
-            uint32_t cell = layer->content.gids[y * w + x];
-            uint32_t gid = cell & TMX_FLIP_BITS_REMOVAL;
+            uint32_t gid = cache->gids[y * w + x];
 
             if (gid == 0)
                 continue; // Tuile vide
 
-            tmx_tile *tile = m->tiles[gid]; // Obtient la tuile originale
-            if (tile)
-            {
-                tmx_tile *tile_to_draw = tile;
+            draw_cell(ren, m, gid, cache->transforms[y * w + x], x * m->tile_width, y * m->tile_height, offsetX, offsetY);
+        }
+    }
+}
 
-                // Si la tuile a une animation, mettez à jour son index de frame
-                if (tile->animation && tile->animation_len > 0)
-                {
-                    // Chercher l'info d'animation pour cette tuile
-                    AnimatedTileInfo *info = NULL;
-                    for (int i = 0; i < animated_tiles_count; ++i)
-                    {
-                        uint32_t animated_tile_global_gid = animated_tiles_infos[i].tileset_first_gid + animated_tiles_infos[i].local_tile_id;
-                        if (animated_tile_global_gid == gid)
-                        {
-                            info = &animated_tiles_infos[i];
-                            break;
-                        }
-                    }
+// Carte infinie : seuls les chunks résidents qui recoupent l'écran sont dessinés
+static void draw_chunked_layer(SDL_Renderer *ren, tmx_map *m, TileLayerCache *cache, int offsetX, int offsetY)
+{
+    ChunkedMap *cm = cache->chunked;
+    int screen_w, screen_h;
+    if (SDL_GetRendererOutputSize(ren, &screen_w, &screen_h) != 0)
+        return;
 
-                    if (info) // Si on a trouvé l'info d'animation pour cette tuile
-                    {
-                        tmx_anim_frame current_frame_data = info->tmx_tile_ptr->animation[info->current_frame_index];
-
-                        if (current_time - info->frame_start_time >= current_frame_data.duration)
-                        {
-                            info->current_frame_index++;
-                            if (info->current_frame_index >= info->tmx_tile_ptr->animation_len)
-                            {
-                                info->current_frame_index = 0;
-                            }
-                            info->frame_start_time = current_time;
-                        }
-                        // Utiliser la GID de la frame actuelle pour obtenir la tuile à dessiner
-                        tile_to_draw = m->tiles[info->tileset_first_gid + info->tmx_tile_ptr->animation[info->current_frame_index].tile_id];
-                    }
+    int chunk_px_w = cm->chunk_width * cm->tile_width;
+    int chunk_px_h = cm->chunk_height * cm->tile_height;
+
+    // Zone visible en pixels monde (les offsets sont l'opposé de la position caméra)
+    int view_x = -offsetX, view_y = -offsetY;
+    int first_cx = (view_x >= 0 ? view_x / chunk_px_w : -((-view_x + chunk_px_w - 1) / chunk_px_w));
+    int first_cy = (view_y >= 0 ? view_y / chunk_px_h : -((-view_y + chunk_px_h - 1) / chunk_px_h));
+    int last_cx = first_cx + screen_w / chunk_px_w + 1;
+    int last_cy = first_cy + screen_h / chunk_px_h + 1;
+
+    for (int cy = first_cy; cy <= last_cy; cy++)
+    {
+        for (int cx = first_cx; cx <= last_cx; cx++)
+        {
+            MapChunk *chunk = ChunkLayer_getChunk(cm, cache->chunk_layer, cx * cm->chunk_width, cy * cm->chunk_height);
+            if (!chunk || !chunk->gids)
+                continue; // Absent ou pas encore décodé
+
+            for (int y = 0; y < chunk->height; y++)
+            {
+                for (int x = 0; x < chunk->width; x++)
+                {
+                    int index = y * chunk->width + x;
+                    uint32_t gid = chunk->gids[index];
+                    if (gid == 0)
+                        continue;
+                    draw_cell(ren, m, gid, chunk->transforms[index],
+                              (chunk->x + x) * m->tile_width, (chunk->y + y) * m->tile_height,
+                              offsetX, offsetY);
                 }
-                draw_tile(ren, tile_to_draw, x * m->tile_width, y * m->tile_height, m->tile_width, m->tile_height, offsetX, offsetY);
             }
         }
     }
@@ -287,7 +610,7 @@ static void draw_image_layer(SDL_Renderer *ren, tmx_image *img, int offsetX, int
     SDL_RenderCopy(ren, tex, NULL, &dst);
 }
 
-static void recurse_layers(SDL_Renderer *ren, tmx_map *m, tmx_layer *layer, uint32_t current_time, int offsetX, int offsetY)
+static void recurse_layers(SDL_Renderer *ren, tmx_map *m, tmx_layer *layer, int offsetX, int offsetY)
 {
     while (layer)
     {
@@ -296,10 +619,10 @@ static void recurse_layers(SDL_Renderer *ren, tmx_map *m, tmx_layer *layer, uint
             switch (layer->type)
             {
             case L_GROUP:
-                recurse_layers(ren, m, layer->content.group_head, current_time, offsetX, offsetY);
+                recurse_layers(ren, m, layer->content.group_head, offsetX, offsetY);
                 break;
             case L_LAYER:
-                draw_layer(ren, m, layer, current_time, offsetX, offsetY); // Pass offsets to draw_layer
+                draw_layer(ren, m, layer, offsetX, offsetY); // Pass offsets to draw_layer
                 break;
             case L_OBJGR:
                 draw_objects(ren, layer->content.objgr, offsetX, offsetY); // Pass offsets to draw_objects
@@ -316,15 +639,78 @@ static void recurse_layers(SDL_Renderer *ren, tmx_map *m, tmx_layer *layer, uint
 }
 
 // Renamed from Map_afficherGroup to Map_renderGroup
-void Map_renderGroup(SDL_Renderer *renderer, Map *map, const char *groupName, int offsetX, int offsetY, uint32_t current_time)
+void Map_renderGroup(SDL_Renderer *renderer, Map *map, const char *groupName, int offsetX, int offsetY)
 {
     tmx_layer *layer = tmx_find_layer_by_name(map->tmx_map, groupName);
     if (layer && layer->type == L_GROUP)
     {
-        recurse_layers(renderer, map->tmx_map, layer->content.group_head, current_time, offsetX, offsetY);
+        recurse_layers(renderer, map->tmx_map, layer->content.group_head, offsetX, offsetY);
     }
 }
 
+// Dépose les tuiles visibles des calques "ysort" dans la file de rendu
+static void queue_ysorted_layers(RenderQueue *queue, tmx_map *m, tmx_layer *layer, Camera *camera)
+{
+    for (; layer; layer = layer->next)
+    {
+        if (!layer->visible)
+            continue;
+        if (layer->type == L_GROUP)
+        {
+            queue_ysorted_layers(queue, m, layer->content.group_head, camera);
+            continue;
+        }
+
+        TileLayerCache *cache = (layer->type == L_LAYER) ? (TileLayerCache *)layer->user_data.pointer : NULL;
+        if (!cache || !cache->ysort)
+            continue;
+
+        // Seules les cellules dans la vue de la caméra
+        SDL_Rect view = camera->view_rect;
+        int first_x = view.x / (int)m->tile_width;
+        int first_y = view.y / (int)m->tile_height;
+        int last_x = (view.x + view.w) / (int)m->tile_width;
+        int last_y = (view.y + view.h) / (int)m->tile_height;
+        if (first_x < 0)
+            first_x = 0;
+        if (first_y < 0)
+            first_y = 0;
+        if (last_x >= (int)m->width)
+            last_x = m->width - 1;
+        if (last_y >= (int)m->height)
+            last_y = m->height - 1;
+
+        for (int y = first_y; y <= last_y; y++)
+        {
+            for (int x = first_x; x <= last_x; x++)
+            {
+                unsigned index = y * m->width + x;
+                uint32_t gid = cache->gids[index];
+                if (gid == 0)
+                    continue;
+
+                tmx_tile *tile = resolve_tile(m, gid);
+                if (!tile)
+                    continue;
+                SDL_Texture *tex = (SDL_Texture *)(tile->image
+                                                       ? tile->image->resource_image
+                                                       : tile->tileset->image->resource_image);
+                SDL_Rect src = {tile->ul_x, tile->ul_y, tile->width, tile->height};
+                SDL_Rect dst = {x * m->tile_width - view.x, y * m->tile_height - view.y, m->tile_width, m->tile_height};
+                const TileTransform *t = &tile_transforms[cache->transforms[index]];
+                RenderQueue_push(queue, tex, &src, &dst, t->flip, t->angle, cache->sort_layer, (float)cache->foot_y[index]);
+            }
+        }
+    }
+}
+
+void Map_queueYSortedLayers(RenderQueue *queue, Map *map, Camera *camera)
+{
+    if (!queue || !map || !camera)
+        return;
+    queue_ysorted_layers(queue, map->tmx_map, map->tmx_map->ly_head, camera);
+}
+
 CollisionObject *Map_getCollisionObjects(Map *map, const char *objectGroupName, int *count)
 {
     *count = 0;
@@ -339,7 +725,9 @@ CollisionObject *Map_getCollisionObjects(Map *map, const char *objectGroupName,
     if (c == 0)
         return NULL;
 
-    CollisionObject *arr = malloc(c * sizeof(CollisionObject));
+    CollisionObject *arr = Arena_alloc(map->arena, c * sizeof(CollisionObject));
+    if (!arr)
+        return NULL;
     int i = 0;
     for (tmx_object *o = og->head; o; o = o->next)
     {
@@ -347,15 +735,15 @@ CollisionObject *Map_getCollisionObjects(Map *map, const char *objectGroupName,
         arr[i].rect.y = o->y;
         arr[i].rect.w = o->width;
         arr[i].rect.h = o->height;
-        arr[i].name = o->name ? strdup(o->name) : NULL;
-        arr[i].type = o->type ? strdup(o->type) : NULL;
+        arr[i].name = Arena_strdup(map->arena, o->name);
+        arr[i].type = Arena_strdup(map->arena, o->type);
 
         // Gérer les polygones
         if (o->obj_type == OT_POLYGON && o->content.shape->points_len > 0)
         {
             arr[i].is_polygon = true;
             arr[i].polygon_count = o->content.shape->points_len;
-            arr[i].polygon_points = malloc(arr[i].polygon_count * sizeof(Point));
+            arr[i].polygon_points = Arena_alloc(map->arena, arr[i].polygon_count * sizeof(Point));
 
             for (int j = 0; j < arr[i].polygon_count; j++)
             {
@@ -376,6 +764,86 @@ CollisionObject *Map_getCollisionObjects(Map *map, const char *objectGroupName,
     return arr;
 }
 
+// Un polygone touche la case si l'une de ses arêtes la traverse, ou s'il la
+// contient entièrement (centre de la case à l'intérieur, règle pair-impair)
+static bool polygon_overlaps_rect(const Point *polygon, int count, SDL_Rect rect)
+{
+    float cx = rect.x + rect.w / 2.0f, cy = rect.y + rect.h / 2.0f;
+    bool inside = false;
+    for (int i = 0, j = count - 1; i < count; j = i++)
+    {
+        int x1 = (int)polygon[j].x, y1 = (int)polygon[j].y;
+        int x2 = (int)polygon[i].x, y2 = (int)polygon[i].y;
+        if (SDL_IntersectRectAndLine(&rect, &x1, &y1, &x2, &y2))
+            return true;
+        if ((polygon[i].y > cy) != (polygon[j].y > cy) &&
+            cx < (polygon[j].x - polygon[i].x) * (cy - polygon[i].y) / (polygon[j].y - polygon[i].y) + polygon[i].x)
+            inside = !inside;
+    }
+    return inside;
+}
+
+// Une tuile est bloquée si un objet de collision empiète sur elle
+// (d'un pixel au moins, pour ignorer les bords qui se touchent)
+static Pathfinder *build_navigation(Map *map)
+{
+    // La grille commence à la tuile (0, 0) : la partie négative d'une carte infinie n'y figure pas
+    int tileSize = map->tmx_map->tile_width;
+    SDL_Rect bounds;
+    Map_getPixelBounds(map, &bounds);
+    int width = (bounds.x + bounds.w) / tileSize;
+    int height = (bounds.y + bounds.h) / map->tmx_map->tile_height;
+    if (width <= 0 || height <= 0)
+        return NULL;
+
+    Pathfinder *pf = Pathfinder_create(map->arena, width, height, tileSize);
+    if (!pf)
+        return NULL;
+
+    for (int i = 0; i < map->collision_count; i++)
+    {
+        CollisionObject *c = &map->collisions[i];
+        SDL_Rect r = c->rect;
+        if (c->is_polygon && c->polygon_count == 0)
+            continue;
+        if (c->is_polygon)
+        {
+            // Boîte englobante du polygone, puis test précis tuile par tuile
+            float minX = c->polygon_points[0].x, maxX = minX;
+            float minY = c->polygon_points[0].y, maxY = minY;
+            for (int p = 1; p < c->polygon_count; p++)
+            {
+                minX = SDL_min(minX, c->polygon_points[p].x);
+                maxX = SDL_max(maxX, c->polygon_points[p].x);
+                minY = SDL_min(minY, c->polygon_points[p].y);
+                maxY = SDL_max(maxY, c->polygon_points[p].y);
+            }
+            r = (SDL_Rect){(int)minX, (int)minY, (int)(maxX - minX) + 1, (int)(maxY - minY) + 1};
+        }
+
+        int x0 = SDL_max(r.x / tileSize, 0), x1 = SDL_min((r.x + r.w - 1) / tileSize, width - 1);
+        int y0 = SDL_max(r.y / tileSize, 0), y1 = SDL_min((r.y + r.h - 1) / tileSize, height - 1);
+        for (int ty = y0; ty <= y1; ty++)
+            for (int tx = x0; tx <= x1; tx++)
+            {
+                SDL_Rect cell = {tx * tileSize + 1, ty * tileSize + 1, tileSize - 2, tileSize - 2};
+                if (c->is_polygon && !polygon_overlaps_rect(c->polygon_points, c->polygon_count, cell))
+                    continue;
+                Pathfinder_setBlocked(pf, tx, ty, true);
+            }
+    }
+    return pf;
+}
+
+// Zones de rencontre sur la même grille que la navigation
+static EncounterMap *load_encounters(Map *map)
+{
+    SDL_Rect bounds;
+    Map_getPixelBounds(map, &bounds);
+    return EncounterMap_load(map->arena, map->tmx_map, (bounds.x + bounds.w) / map->tmx_map->tile_width,
+                             (bounds.y + bounds.h) / map->tmx_map->tile_height);
+}
+
 bool Map_getPlayerSpawn(Map *map, float *x, float *y)
 {
     tmx_layer *layer = tmx_find_layer_by_name(map->tmx_map, "PlayerObject");
@@ -398,13 +866,161 @@ bool Map_setTile(Map *map, const char *layerName, int x, int y, int gid)
     tmx_layer *layer = tmx_find_layer_by_name(map->tmx_map, layerName);
     if (!layer || layer->type != L_LAYER)
         return false;
+
+    // Carte infinie : pas de bornes, le chunk est créé au besoin
+    TileLayerCache *chunk_cache = (TileLayerCache *)layer->user_data.pointer;
+    if (chunk_cache && chunk_cache->chunk_layer)
+        return ChunkLayer_setTile(chunk_cache->chunked, chunk_cache->chunk_layer, x, y, (uint32_t)gid);
     if (x < 0 || y < 0 || x >= map->tmx_map->width || y >= map->tmx_map->height)
         return false;
 
-    layer->content.gids[y * map->tmx_map->width + x] = gid;
+    int index = y * map->tmx_map->width + x;
+    layer->content.gids[index] = gid;
+
+    // Garder le cache de rendu synchronisé (les bits de flip de 'gid' sont respectés)
+    TileLayerCache *cache = (TileLayerCache *)layer->user_data.pointer;
+    if (cache)
+    {
+        Tile_decodeCell((uint32_t)gid, &cache->gids[index], &cache->transforms[index]);
+        if (cache->ysort)
+            update_ysort_column(map->tmx_map, cache, (unsigned)x);
+    }
     return true;
 }
 
+void Map_setJobSystem(Map *map, JobSystem *jobs)
+{
+    if (!map || !jobs)
+        return;
+    map->jobs = jobs;
+    if (map->pathfinder && !Pathfinder_attachJobs(map->pathfinder, map->arena, jobs))
+        fprintf(stderr, "Recherches de chemin sur le thread principal.\n");
+}
+
+void Map_setScriptHost(Map *map, const ScriptHost *host)
+{
+    if (!map || !host)
+        return;
+    map->script_host = *host;
+    if (!map->script_host.say)
+        map->script_host.say = print_pnj_line;
+    if (!map->script_host.walk_to)
+        map->script_host.walk_to = walk_pnj_to;
+    if (!map->script_host.cancel_walk)
+        map->script_host.cancel_walk = cancel_pnj_walk;
+
+    // Les flags des routines déjà chargées sont résolus auprès du nouveau host
+    for (int i = 0; map->entities && i < map->entities->count; i++)
+        Script_bindFlags(map->entities->script[i], &map->script_host);
+}
+
+void Map_updatePlayerHitbox(Map *map, Hitbox hitbox)
+{
+    if (map && map->spatial)
+        SpatialHash_update(map->spatial, SPATIAL_ID_PLAYER, hitbox);
+}
+
+bool Map_entityBlocked(Map *map, Hitbox from, Hitbox to, int self)
+{
+    if (!map || !map->spatial)
+        return false;
+    return SpatialHash_blocked(map->spatial, from, to, self);
+}
+
+PNJ *Map_findPNJ(Map *map, Hitbox area)
+{
+    if (!map || !map->spatial)
+        return NULL;
+
+    int ids[8];
+    int count = SpatialHash_query(map->spatial, area, ids, 8);
+    for (int k = 0; k < count; k++)
+    {
+        if (ids[k] == SPATIAL_ID_PLAYER)
+            continue;
+        uint32_t slot = (uint32_t)ids[k] - 1;
+        for (int i = 0; i < map->pnj_count; i++)
+        {
+            if (map->pnjs[i] && map->pnjs[i]->handle.slot == slot)
+                return map->pnjs[i];
+        }
+    }
+    return NULL;
+}
+
+bool Map_checkEncounter(Map *map, Hitbox feet, uint32_t current_time, Encounter *out)
+{
+    if (!map || !map->encounters)
+        return false;
+    return EncounterMap_step(map->encounters, feet.x + feet.width / 2, feet.y + feet.height / 2, current_time, out);
+}
+
+void Map_seedEncounters(Map *map, uint64_t seed)
+{
+    if (map)
+        EncounterMap_seed(map->encounters, seed);
+}
+
+void Map_renderEncounterEffects(SDL_Renderer *renderer, Map *map, Camera *camera)
+{
+    if (map)
+        EncounterMap_renderEffects(map->encounters, renderer, camera);
+}
+
+void Map_updateChunks(Map *map, Camera *camera)
+{
+    if (!map || !map->chunks || !camera)
+        return;
+    ChunkedMap_update(map->chunks, camera->view_rect, CHUNK_PREFETCH_RADIUS);
+}
+
+void Map_getPixelBounds(Map *map, SDL_Rect *bounds)
+{
+    ChunkedMap *cm = map->chunks;
+    if (cm && cm->min_x <= cm->max_x)
+    {
+        *bounds = (SDL_Rect){cm->min_x * cm->tile_width, cm->min_y * cm->tile_height,
+                             (cm->max_x - cm->min_x) * cm->tile_width, (cm->max_y - cm->min_y) * cm->tile_height};
+        return;
+    }
+    *bounds = (SDL_Rect){0, 0, 0, 0};
+    if (!cm)
+    {
+        bounds->w = map->tmx_map->width * map->tmx_map->tile_width;
+        bounds->h = map->tmx_map->height * map->tmx_map->tile_height;
+    }
+}
+
+void Map_updateAnimations(Map *map, uint32_t current_time)
+{
+    if (!map)
+        return;
+
+    for (int i = 0; i < animated_tiles_count; ++i)
+    {
+        AnimatedTileInfo *info = &animated_tiles_infos[i];
+        tmx_tile *tile = info->tmx_tile_ptr;
+
+        // Rattraper plusieurs frames si la mise à jour a pris du retard
+        uint32_t duration = tile->animation[info->current_frame_index].duration;
+        while (duration > 0 && current_time - info->frame_start_time >= duration)
+        {
+            info->frame_start_time += duration;
+            info->current_frame_index++;
+            if (info->current_frame_index >= (int)tile->animation_len)
+            {
+                info->current_frame_index = 0;
+            }
+            duration = tile->animation[info->current_frame_index].duration;
+        }
+        if (duration == 0)
+            info->frame_start_time = current_time;
+
+        // Lu par resolve_tile pendant le rendu
+        tile->user_data.pointer = map->tmx_map->tiles[info->tileset_first_gid + tile->animation[info->current_frame_index].tile_id];
+    }
+}
+
 void Map_initAnimations(Map *map)
 {
     // Clear previous animated tiles info if map is reloaded
@@ -489,10 +1105,43 @@ void Map_drawCollisionsInCamera(SDL_Renderer *renderer, Map *map, Camera *camera
     SDL_SetRenderDrawColor(renderer, r, g, b, a);
 }
 
+// Compile la routine d'un objet PNJ, NULL s'il n'en a pas
+static const Script *load_pnj_script(Map *map, tmx_object *o)
+{
+    const Script *script = NULL;
+    tmx_property *script_prop = tmx_get_property(o->properties, "script");
+    tmx_property *file_prop = tmx_get_property(o->properties, "script_file");
+    if (script_prop && script_prop->type == PT_STRING)
+        script = Script_compile(map->arena, script_prop->value.string, o->name);
+    else if (file_prop && (file_prop->type == PT_STRING || file_prop->type == PT_FILE))
+        script = Script_compileFile(map->arena, file_prop->value.string);
+
+    Script_bindFlags(script, &map->script_host);
+    return script;
+}
+
+// Réplique par défaut, tant que le jeu n'a pas fourni d'affichage
+static void print_pnj_line(void *user, void *owner, const char *text)
+{
+    printf("PNJ %p: %s\n", owner, text);
+}
+
+// "walkto" : recherche sur la grille de la carte du PNJ
+static bool walk_pnj_to(void *user, void *owner, int tileX, int tileY)
+{
+    PNJ *pnj = owner;
+    return pnj && walkPNJTo(pnj, pnj->pathfinder, tileX, tileY);
+}
+
+static void cancel_pnj_walk(void *user, void *owner)
+{
+    cancelPNJPath(owner);
+}
+
 void Map_initPNJs(Map *map, SDL_Renderer *renderer)
 {
     printf("=== DEBUG PNJs ===\n");
-    if (!map || !renderer)
+    if (!map || !renderer || !map->entities)
         return;
 
     // Chercher le layer "PNJObject" ou similaire
@@ -518,7 +1167,9 @@ void Map_initPNJs(Map *map, SDL_Renderer *renderer)
     }
 
     // Allouer le tableau de PNJs
-    map->pnjs = malloc(count * sizeof(PNJ *));
+    map->pnjs = Arena_calloc(map->arena, count, sizeof(PNJ *));
+    if (!map->pnjs)
+        return;
     map->pnj_count = count;
 
     int i = 0;
@@ -541,10 +1192,12 @@ void Map_initPNJs(Map *map, SDL_Renderer *renderer)
             }
 
             // Créer le PNJ
-            map->pnjs[i] = createPNJ(o->x, o->y, spritePath, renderer);
+            map->pnjs[i] = createPNJ(map->entities, map->arena, o->x, o->y, spritePath, renderer);
 
             if (map->pnjs[i])
             {
+                map->pnjs[i]->name = Arena_strdup(map->arena, o->name);
+                map->pnjs[i]->pathfinder = map->pathfinder;
                 // Sauvegarder les valeurs par défaut
                 map->pnjs[i]->default_x_spawn = o->x;
                 map->pnjs[i]->default_y_spawn = o->y;
@@ -558,6 +1211,7 @@ void Map_initPNJs(Map *map, SDL_Renderer *renderer)
                 }
 
                 setPNJDirection(map->pnjs[i], map->pnjs[i]->default_dir);
+                setPNJScript(map->pnjs[i], load_pnj_script(map, o));
                 map->pnjs[i]->aEteInit = true;
             }
             i++;
@@ -565,30 +1219,48 @@ void Map_initPNJs(Map *map, SDL_Renderer *renderer)
     }
 }
 
-void Map_renderPNJs(SDL_Renderer *renderer, Map *map, Camera *camera)
+void Map_queuePNJs(RenderQueue *queue, Map *map, Camera *camera)
 {
-    if (!map || !renderer || !camera)
+    if (!map || !queue || !camera)
         return;
 
-    for (int i = 0; i < map->pnj_count; i++)
-    {
-        if (map->pnjs[i])
-        {
-            renderPNJ(map->pnjs[i], renderer, camera);
-        }
-    }
+    EntityStore_queue(map->entities, queue, camera);
 }
 
-void UpdatePNJs(Map *map, float deltaTime)
+// Contexte d'une mise à jour parallèle des PNJs
+typedef struct
 {
-    if (!map)
+    EntityStore *store;
+    Uint32 currentTime;
+} PNJUpdateContext;
+
+static void update_pnj_range(void *data, int begin, int end)
+{
+    PNJUpdateContext *ctx = data;
+    EntityStore_updateList(ctx->store, ctx->store->tick_list, begin, end, ctx->currentTime);
+}
+
+void UpdatePNJs(Map *map, Camera *camera)
+{
+    if (!map || !map->entities || !camera)
         return;
 
+    if (map->pathfinder)
+        Pathfinder_update(map->pathfinder, PATHFINDER_NODES_PER_FRAME);
     for (int i = 0; i < map->pnj_count; i++)
-    {
-        if (map->pnjs[i])
-        {
-            updatePNJ(map->pnjs[i], deltaTime);
-        }
-    }
+        resumePNJRoute(map->pnjs[i]);
+
+    // Seuls les PNJs proches de la vue, ou occupés hors écran, sont mis à jour
+    EntityStore *store = map->entities;
+    PNJUpdateContext ctx = {store, SDL_GetTicks()};
+    EntityStore_schedule(store, camera->view_rect, ctx.currentTime);
+    EntityStore_runScripts(store, store->tick_list, store->tick_count, ctx.currentTime, &map->script_host);
+
+    // Même temps pour tous les PNJs : le résultat ne dépend pas du découpage
+    JobSystem_parallelFor(map->jobs, store->tick_count, PNJ_UPDATE_GRAIN, update_pnj_range, &ctx);
+
+    // Les nouvelles positions ne sont visibles des collisions qu'à la frame suivante
+    EntityStore_syncSpatial(store, store->tick_list, store->tick_count);
+    for (int k = 0; k < store->tick_count && !store->changed; k++)
+        store->changed = store->moving[store->tick_list[k]];
 }
\ No newline at end of file
@@ -8,6 +8,10 @@
 #include <stdint.h>
 #include "../systems/camera.h"
 #include "../game/pnj.h"
+#include "../game/encounter.h"
+#include "chunkmap.h"
+#include "../systems/arena.h"
+#include "../systems/render_queue.h"
 
 typedef struct
 {
@@ -29,12 +33,20 @@ typedef struct
 // Structure pour stocker les informations de la carte
 typedef struct
 {
+    Arena *arena; // Mémoire de durée de vie de la carte (collisions, PNJs, caches), libérée d'un coup
     tmx_map *tmx_map;
+    ChunkedMap *chunks; // Chunks des calques d'une carte infinie, NULL sinon
     float default_x_spawn;
     float default_y_spawn;
     CollisionObject *collisions;
     int collision_count;
+    Pathfinder *pathfinder; // Grille de navigation construite à partir des collisions
+    EncounterMap *encounters; // Zones de rencontre par tuile, NULL si la carte n'en a pas
 
+    EntityStore *entities; // Données des PNJs (SoA), mises à jour par UpdatePNJs, dessinées via la file de rendu (Map_queuePNJs)
+    SpatialHash *spatial;  // Hitbox du joueur et des PNJs, pour les collisions entre entités
+    JobSystem *jobs;       // Mise à jour parallèle des PNJs, NULL : sur le thread principal
+    ScriptHost script_host; // Flags et dialogues pour les routines des PNJs
     PNJ **pnjs;
     int pnj_count;
 
@@ -47,22 +59,66 @@ Map *loadMap(const char *filePath, SDL_Renderer *renderer);
 void freeMap(Map *map);
 
 // Affiche un groupe de calques spécifique de la carte, décalé par offsetX, offsetY
-// 'current_time' est ajouté pour la gestion des animations par le groupe
-void Map_renderGroup(SDL_Renderer *renderer, Map *map, const char *groupName, int offsetX, int offsetY, uint32_t current_time);
+// Les tuiles animées sont dessinées à la frame choisie par Map_updateAnimations
+void Map_renderGroup(SDL_Renderer *renderer, Map *map, const char *groupName, int offsetX, int offsetY);
 
-// Récupère les objets de collision d'un groupe d'objets spécifique
+// Dépose dans la file de rendu les tuiles des calques ayant la propriété "ysort",
+// pour qu'elles soient triées en profondeur avec les entités
+void Map_queueYSortedLayers(RenderQueue *queue, Map *map, Camera *camera);
+
+// Récupère les objets de collision d'un groupe d'objets spécifique (alloués dans l'arena de la carte)
 CollisionObject *Map_getCollisionObjects(Map *map, const char *objectGroupName, int *count);
 
 // Récupère la position de spawn du joueur depuis la carte
 bool Map_getPlayerSpawn(Map *map, float *x, float *y);
 
 // Modifie le tile à des coordonnées spécifiques (x, y) dans un calque donné
+// Le gid peut contenir les bits de flip TMX (TMX_FLIPPED_*)
 // Retourne true si la modification a réussi, false sinon
 bool Map_setTile(Map *map, const char *layerName, int x, int y, int gid);
 
+// Résout les recherches de chemin et met à jour les PNJs sur les threads de 'jobs'
+void Map_setJobSystem(Map *map, JobSystem *jobs);
+
+// Services (flags, dialogues) utilisés par les routines de comportement des PNJs
+void Map_setScriptHost(Map *map, const ScriptHost *host);
+
+// Met à jour la hitbox du joueur dans la table spatiale (bloque les PNJs)
+void Map_updatePlayerHitbox(Map *map, Hitbox hitbox);
+
+// Vrai si une entité bloque le déplacement de 'from' à 'to' ('self' : identifiant dans map->spatial)
+bool Map_entityBlocked(Map *map, Hitbox from, Hitbox to, int self);
+
+// PNJ dont la hitbox chevauche 'area' (interaction du joueur), NULL si aucun
+PNJ *Map_findPNJ(Map *map, Hitbox area);
+
+// Zones de rencontre : tire une rencontre si les pieds du joueur ('feet') viennent
+// d'entrer dans une nouvelle tuile d'une zone. Retourne true et remplit 'out' le cas échéant.
+bool Map_checkEncounter(Map *map, Hitbox feet, uint32_t current_time, Encounter *out);
+
+// Graine du tirage des rencontres (même graine, mêmes rencontres)
+void Map_seedEncounters(Map *map, uint64_t seed);
+
+// Dessine les effets de passage dans les hautes herbes
+void Map_renderEncounterEffects(SDL_Renderer *renderer, Map *map, Camera *camera);
+
+// Carte infinie : décode les chunks proches de la caméra et libère les chunks éloignés
+void Map_updateChunks(Map *map, Camera *camera);
+
+// Étendue de la carte en pixels ; celle d'une carte infinie (ses chunks) peut
+// commencer en coordonnées négatives
+void Map_getPixelBounds(Map *map, SDL_Rect *bounds);
+
+// Rechargement à chaud : remplace la texture des images de tilesets dont le fichier
+// est 'path' (chemin depuis la racine du jeu). Retourne le nombre d'images rechargées.
+int Map_reloadImage(Map *map, const char *path, SDL_Renderer *renderer);
+
 // Initialise les informations d'animation pour toutes les tuiles animées de la carte
 void Map_initAnimations(Map *map);
 
+// Avance les animations de tuiles (appelé pendant la mise à jour, pas au rendu)
+void Map_updateAnimations(Map *map, uint32_t current_time);
+
 // Debug
 void DeBugMap(Map *map);
 
@@ -72,11 +128,15 @@ void Map_drawCollisionsInCamera(SDL_Renderer *renderer, Map *map, Camera *camera
 // fonctions PNJ ( add, remove, update, render, etc. )
 
 // Initializes PNJs from the map's object layers
+// La routine d'un PNJ vient de sa propriété "script" (texte) ou "script_file" (chemin)
 void Map_initPNJs(Map *map, SDL_Renderer *renderer);
 
-// Renders all PNJs in the map
-void Map_renderPNJs(SDL_Renderer *renderer, Map *map, Camera *camera);
+// Dépose les PNJs visibles dans la file de rendu triée
+void Map_queuePNJs(RenderQueue *queue, Map *map, Camera *camera);
 
-void UpdatePNJs(Map *map, float deltaTime);
+// Traite les recherches de chemin en attente, exécute les routines puis met à jour les PNJs
+// (par intervalles en parallèle si la carte a un JobSystem). Les PNJs éloignés de la
+// caméra sont mis à jour moins souvent ou endormis.
+void UpdatePNJs(Map *map, Camera *camera);
 
 #endif // MAP_H
\ No newline at end of file
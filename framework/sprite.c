@@ -1,11 +1,12 @@
 #include "sprite.h"
+#include "../systems/resources.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
 Sprite *createSprite(const char *texture_path, int frame_width, int frame_height, SDL_Renderer *renderer)
 {
-    SDL_Surface *surface = IMG_Load(texture_path);
+    SDL_Surface *surface = Resources_loadSurface(texture_path);
     if (!surface)
     {
         fprintf(stderr, "Erreur chargement sprite: %s\n", texture_path);
@@ -14,6 +15,7 @@ Sprite *createSprite(const char *texture_path, int frame_width, int frame_height
 
     Sprite *sprite = calloc(1, sizeof(Sprite));
     sprite->texture = SDL_CreateTextureFromSurface(renderer, surface);
+    sprite->path = strdup(texture_path);
     sprite->sheet_width = surface->w;
     sprite->sheet_height = surface->h;
     sprite->frame_width = frame_width;
@@ -30,7 +32,7 @@ Sprite *createSprite(const char *texture_path, int frame_width, int frame_height
 
 Sprite *createSpriteWithColumns(const char *texture_path, int columns, int rows, int frame_width, int frame_height, SDL_Renderer *renderer)
 {
-    SDL_Surface *surface = IMG_Load(texture_path);
+    SDL_Surface *surface = Resources_loadSurface(texture_path);
     if (!surface)
     {
         fprintf(stderr, "Erreur chargement sprite: %s\n", texture_path);
@@ -39,6 +41,39 @@ Sprite *createSpriteWithColumns(const char *texture_path, int columns, int rows,
 
     Sprite *sprite = calloc(1, sizeof(Sprite));
     sprite->texture = SDL_CreateTextureFromSurface(renderer, surface);
+    sprite->path = strdup(texture_path);
+    sprite->sheet_width = surface->w;
+    sprite->sheet_height = surface->h;
+    sprite->columns = columns;
+    sprite->rows = rows;
+    sprite->frame_width = frame_width;
+    sprite->frame_height = frame_height;
+    sprite->current_animation = -1;
+    sprite->playing = false;
+    sprite->paused = false;
+
+    SDL_FreeSurface(surface);
+    return sprite;
+}
+
+Sprite *createSpriteInArena(Arena *arena, const char *texture_path, int columns, int rows, int frame_width, int frame_height, SDL_Renderer *renderer)
+{
+    SDL_Surface *surface = Resources_loadSurface(texture_path);
+    if (!surface)
+    {
+        fprintf(stderr, "Erreur chargement sprite: %s\n", texture_path);
+        return NULL;
+    }
+
+    Sprite *sprite = Arena_calloc(arena, 1, sizeof(Sprite));
+    if (!sprite)
+    {
+        SDL_FreeSurface(surface);
+        return NULL;
+    }
+    sprite->arena = arena;
+    sprite->texture = SDL_CreateTextureFromSurface(renderer, surface);
+    sprite->path = Arena_strdup(arena, texture_path);
     sprite->sheet_width = surface->w;
     sprite->sheet_height = surface->h;
     sprite->columns = columns;
@@ -61,24 +96,98 @@ void freeSprite(Sprite *sprite)
     if (sprite->texture)
     {
         SDL_DestroyTexture(sprite->texture);
+        sprite->texture = NULL;
     }
 
+    // La mémoire sera rendue avec l'arena
+    if (sprite->arena)
+        return;
+
     for (int i = 0; i < sprite->animation_count; i++)
     {
         free(sprite->animations[i].name);
         free(sprite->animations[i].frames);
     }
     free(sprite->animations);
+    free(sprite->path);
     free(sprite);
 }
 
+bool reloadSpriteTexture(Sprite *sprite, SDL_Renderer *renderer)
+{
+    if (!sprite || !sprite->path)
+        return false;
+
+    SDL_Surface *surface = Resources_loadSurface(sprite->path);
+    if (!surface)
+    {
+        fprintf(stderr, "Erreur rechargement sprite: %s\n", sprite->path);
+        return false;
+    }
+    SDL_Texture *texture = SDL_CreateTextureFromSurface(renderer, surface);
+    if (!texture)
+    {
+        fprintf(stderr, "Erreur rechargement sprite: %s\n", SDL_GetError());
+        SDL_FreeSurface(surface);
+        return false;
+    }
+
+    // Les frames restent décrites par leur taille : seule la feuille change
+    SDL_DestroyTexture(sprite->texture);
+    sprite->texture = texture;
+    sprite->sheet_width = surface->w;
+    sprite->sheet_height = surface->h;
+    SDL_FreeSurface(surface);
+    return true;
+}
+
 void addAnimation(Sprite *sprite, const char *name, int *frame_indices, int frame_count, int frame_duration, bool loop)
 {
-    sprite->animations = realloc(sprite->animations, (sprite->animation_count + 1) * sizeof(Animation));
+    if (sprite->animation_count >= sprite->animation_capacity)
+    {
+        int capacity = (sprite->animation_capacity == 0) ? 8 : sprite->animation_capacity * 2;
+        Animation *animations;
+        if (sprite->arena)
+        {
+            // Pas de realloc dans une arena : copier dans un tableau plus grand
+            animations = Arena_alloc(sprite->arena, capacity * sizeof(Animation));
+            if (animations && sprite->animation_count > 0)
+                memcpy(animations, sprite->animations, sprite->animation_count * sizeof(Animation));
+        }
+        else
+        {
+            animations = realloc(sprite->animations, capacity * sizeof(Animation));
+        }
+        if (!animations)
+        {
+            fprintf(stderr, "Erreur d'allocation mémoire pour l'animation %s\n", name);
+            return;
+        }
+        sprite->animations = animations;
+        sprite->animation_capacity = capacity;
+    }
     Animation *anim = &sprite->animations[sprite->animation_count];
 
-    anim->name = strdup(name);
-    anim->frames = calloc(frame_count, sizeof(Frame));
+    if (sprite->arena)
+    {
+        anim->name = Arena_strdup(sprite->arena, name);
+        anim->frames = Arena_calloc(sprite->arena, frame_count, sizeof(Frame));
+    }
+    else
+    {
+        anim->name = strdup(name);
+        anim->frames = calloc(frame_count, sizeof(Frame));
+    }
+    if (!anim->name || !anim->frames)
+    {
+        fprintf(stderr, "Erreur d'allocation mémoire pour l'animation %s\n", name);
+        if (!sprite->arena)
+        {
+            free(anim->name);
+            free(anim->frames);
+        }
+        return;
+    }
     anim->frame_count = frame_count;
     anim->loop = loop;
 
@@ -226,6 +335,19 @@ void renderSpriteFlipped(Sprite *sprite, SDL_Renderer *renderer, int x, int y, S
     SDL_RenderCopyEx(renderer, sprite->texture, &src_rect, &dst_rect, 0, NULL, flip);
 }
 
+void renderSpriteFrame(Sprite *sprite, SDL_Renderer *renderer, int animation, int frame, int x, int y)
+{
+    if (!sprite->texture || animation < 0 || animation >= sprite->animation_count)
+        return;
+
+    Frame *f = &sprite->animations[animation].frames[frame];
+
+    SDL_Rect src_rect = {f->x, f->y, f->width, f->height};
+    SDL_Rect dst_rect = {x, y, f->width, f->height};
+
+    SDL_RenderCopy(renderer, sprite->texture, &src_rect, &dst_rect);
+}
+
 bool isAnimationPlaying(Sprite *sprite)
 {
     return sprite->playing && !sprite->paused;
@@ -243,4 +365,29 @@ const char *getCurrentAnimationName(Sprite *sprite)
 int getCurrentFrame(Sprite *sprite)
 {
     return sprite->current_frame;
+}
+
+int findAnimation(Sprite *sprite, const char *name)
+{
+    for (int i = 0; i < sprite->animation_count; i++)
+    {
+        if (strcmp(sprite->animations[i].name, name) == 0)
+        {
+            return i;
+        }
+    }
+    return -1;
+}
+
+bool getFrameRect(Sprite *sprite, int animation, int frame, SDL_Rect *src)
+{
+    if (!sprite || animation < 0 || animation >= sprite->animation_count)
+        return false;
+    Animation *anim = &sprite->animations[animation];
+    if (frame < 0 || frame >= anim->frame_count)
+        return false;
+
+    Frame *f = &anim->frames[frame];
+    *src = (SDL_Rect){f->x, f->y, f->width, f->height};
+    return true;
 }
\ No newline at end of file
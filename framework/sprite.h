@@ -4,6 +4,7 @@
 #include <SDL2/SDL.h>
 #include <SDL2/SDL_image.h>
 #include <stdbool.h>
+#include "../systems/arena.h"
 
 // Structure pour une frame d'animation
 typedef struct {
@@ -23,12 +24,16 @@ typedef struct {
 // Structure principale du sprite
 typedef struct {
     SDL_Texture *texture;       // Texture de la spritesheet
+    char *path;                 // Fichier de la spritesheet (rechargement à chaud)
     int sheet_width, sheet_height; // Taille de la spritesheet
     int frame_width, frame_height; // Taille d'une frame
     int columns, rows;          // Nombre de colonnes/lignes
     
     Animation *animations;      // Tableau des animations
     int animation_count;        // Nombre d'animations
+    int animation_capacity;     // Taille allouée du tableau
+
+    Arena *arena;               // Si non NULL, la mémoire du sprite vient de cette arena
     
     // État actuel
     int current_animation;      // Index de l'animation courante
@@ -41,7 +46,12 @@ typedef struct {
 // Fonctions de création et destruction
 Sprite* createSprite(const char *texture_path, int frame_width, int frame_height, SDL_Renderer *renderer);
 Sprite* createSpriteWithColumns(const char *texture_path, int columns, int rows, int frame_width, int frame_height, SDL_Renderer *renderer);
+// Variante dont le sprite et ses animations sont alloués dans une arena (seule la texture est libérée par freeSprite)
+Sprite* createSpriteInArena(Arena *arena, const char *texture_path, int columns, int rows, int frame_width, int frame_height, SDL_Renderer *renderer);
 void freeSprite(Sprite *sprite);
+// Relit la spritesheet depuis son fichier et remplace la texture (animations conservées).
+// En cas d'erreur, l'ancienne texture est gardée.
+bool reloadSpriteTexture(Sprite *sprite, SDL_Renderer *renderer);
 
 // Fonctions d'animation
 void addAnimation(Sprite *sprite, const char *name, int *frame_indices, int frame_count, int frame_duration, bool loop);
@@ -57,10 +67,16 @@ void updateSprite(Sprite *sprite);
 void renderSprite(Sprite *sprite, SDL_Renderer *renderer, int x, int y);
 void renderSpriteScaled(Sprite *sprite, SDL_Renderer *renderer, int x, int y, int width, int height);
 void renderSpriteFlipped(Sprite *sprite, SDL_Renderer *renderer, int x, int y, SDL_RendererFlip flip);
+// Rendu d'une frame donnée, l'état d'animation étant stocké hors du sprite
+void renderSpriteFrame(Sprite *sprite, SDL_Renderer *renderer, int animation, int frame, int x, int y);
 
 // Fonctions utilitaires
 bool isAnimationPlaying(Sprite *sprite);
 const char* getCurrentAnimationName(Sprite *sprite);
 int getCurrentFrame(Sprite *sprite);
+// Rectangle source d'une frame dans la spritesheet, false si la frame n'existe pas
+bool getFrameRect(Sprite *sprite, int animation, int frame, SDL_Rect *src);
+// Index d'une animation par son nom (-1 si introuvable), à résoudre une seule fois
+int findAnimation(Sprite *sprite, const char *name);
 
 #endif
\ No newline at end of file
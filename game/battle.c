@@ -0,0 +1,357 @@
+#include "battle.h"
+#include <stdio.h>
+#include <string.h>
+
+#define STRUGGLE_POWER 50 // Attaque sans type quand il ne reste plus de PP
+#define CRITICAL_CHANCE 16 // 1 chance sur 16
+
+// Efficacité x2 (0 : sans effet, 1 : pas très efficace, 2 : normal, 4 : super efficace),
+// indexée par [type de l'attaque][type du défenseur]
+static const uint8_t type_chart[TYPE_COUNT][TYPE_COUNT] = {
+    {2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2}, // none
+    {2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 1, 0, 2, 2, 1, 2}, // normal
+    {2, 2, 1, 1, 4, 2, 4, 2, 2, 2, 2, 2, 4, 1, 2, 1, 2, 4, 2}, // fire
+    {2, 2, 4, 1, 1, 2, 2, 2, 2, 4, 2, 2, 2, 4, 2, 1, 2, 2, 2}, // water
+    {2, 2, 1, 4, 1, 2, 2, 2, 1, 4, 1, 2, 1, 4, 2, 1, 2, 1, 2}, // grass
+    {2, 2, 2, 4, 1, 1, 2, 2, 2, 0, 4, 2, 2, 2, 2, 1, 2, 2, 2}, // electric
+    {2, 2, 1, 1, 4, 2, 1, 2, 2, 4, 4, 2, 2, 2, 2, 4, 2, 1, 2}, // ice
+    {2, 4, 2, 2, 2, 2, 4, 2, 1, 2, 1, 1, 1, 4, 0, 2, 4, 4, 1}, // fighting
+    {2, 2, 2, 2, 4, 2, 2, 2, 1, 1, 2, 2, 2, 1, 1, 2, 2, 0, 4}, // poison
+    {2, 2, 4, 2, 1, 4, 2, 2, 4, 2, 0, 2, 1, 4, 2, 2, 2, 4, 2}, // ground
+    {2, 2, 2, 2, 4, 1, 2, 4, 2, 2, 2, 2, 4, 1, 2, 2, 2, 1, 2}, // flying
+    {2, 2, 2, 2, 2, 2, 2, 4, 4, 2, 2, 1, 2, 2, 2, 2, 0, 1, 2}, // psychic
+    {2, 2, 1, 2, 4, 2, 2, 1, 1, 2, 1, 4, 2, 2, 1, 2, 4, 1, 1}, // bug
+    {2, 2, 4, 2, 2, 2, 4, 1, 2, 1, 4, 2, 4, 2, 2, 2, 2, 1, 2}, // rock
+    {2, 0, 2, 2, 2, 2, 2, 2, 2, 2, 2, 4, 2, 2, 4, 2, 1, 2, 2}, // ghost
+    {2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 4, 2, 1, 0}, // dragon
+    {2, 2, 2, 2, 2, 2, 2, 1, 2, 2, 2, 4, 2, 2, 4, 2, 1, 2, 1}, // dark
+    {2, 2, 1, 1, 2, 1, 4, 2, 2, 2, 2, 2, 2, 4, 2, 2, 2, 1, 4}, // steel
+    {2, 2, 1, 2, 2, 2, 2, 4, 1, 2, 2, 2, 2, 2, 2, 4, 4, 1, 2}, // fairy
+};
+
+int Battle_typeEffectiveness(ElementType attack, ElementType defense)
+{
+    if (attack < 0 || attack >= TYPE_COUNT || defense < 0 || defense >= TYPE_COUNT)
+        return 2;
+    return type_chart[attack][defense];
+}
+
+// Efficacité contre les deux types du défenseur (x4)
+static int effectiveness(int moveType, const BattlePokemon *target)
+{
+    return Battle_typeEffectiveness(moveType, target->types[0]) * Battle_typeEffectiveness(moveType, target->types[1]);
+}
+
+bool BattlePokemon_init(BattlePokemon *pokemon, uint16_t species, int level)
+{
+    const SpeciesData *data = Species_get(species);
+    if (!pokemon || !data)
+        return false;
+
+    memset(pokemon, 0, sizeof(BattlePokemon));
+    level = SDL_max(1, SDL_min(level, 100));
+    pokemon->species = species;
+    pokemon->level = (uint8_t)level;
+    pokemon->types[0] = data->types[0];
+    pokemon->types[1] = data->types[1];
+
+    // Formules des jeux, sans IV ni EV
+    pokemon->stats[STAT_HP] = (uint16_t)(2 * data->base[STAT_HP] * level / 100 + level + 10);
+    for (int s = STAT_ATTACK; s < STAT_COUNT; s++)
+        pokemon->stats[s] = (uint16_t)(2 * data->base[s] * level / 100 + 5);
+    pokemon->hp = (int16_t)pokemon->stats[STAT_HP];
+
+    for (int m = 0; m < SPECIES_MAX_MOVES; m++)
+    {
+        const MoveData *move = Move_get(data->moves[m]);
+        pokemon->moves[m] = move ? move->id : 0;
+        pokemon->pp[m] = move ? move->pp : 0;
+    }
+    return true;
+}
+
+void Battle_init(Battle *battle, const BattlePokemon *player, const BattlePokemon *opponent, uint64_t seed)
+{
+    memset(battle, 0, sizeof(Battle));
+    battle->sides[BATTLE_PLAYER] = *player;
+    battle->sides[BATTLE_OPPONENT] = *opponent;
+    Random_seed(&battle->rng, seed);
+    battle->result = BATTLE_ONGOING;
+}
+
+static void push_event(Battle *battle, BattleEventType type, int side, uint16_t move, int value)
+{
+    if (battle->event_count >= BATTLE_MAX_EVENTS)
+        return;
+    battle->events[battle->event_count++] = (BattleEvent){type, (uint8_t)side, move, value};
+}
+
+static bool has_pp(const BattlePokemon *p)
+{
+    for (int m = 0; m < SPECIES_MAX_MOVES; m++)
+    {
+        if (p->moves[m] && p->pp[m] > 0)
+            return true;
+    }
+    return false;
+}
+
+BattleAction Battle_chooseAction(Battle *battle, int side)
+{
+    const BattlePokemon *self = &battle->sides[side];
+    const BattlePokemon *target = &battle->sides[1 - side];
+    BattleAction action = {ACTION_MOVE, -1}; // -1 : Lutte
+
+    int usable[SPECIES_MAX_MOVES], usable_count = 0;
+    int best[SPECIES_MAX_MOVES], best_count = 0, best_score = -1;
+    for (int m = 0; m < SPECIES_MAX_MOVES; m++)
+    {
+        const MoveData *move = Move_get(self->moves[m]);
+        if (!move || self->pp[m] == 0)
+            continue;
+        usable[usable_count++] = m;
+
+        // Dégâts espérés à un facteur près : puissance x efficacité x STAB x précision
+        int score = move->power * effectiveness(move->type, target);
+        if (move->type == self->types[0] || move->type == self->types[1])
+            score = score * 3 / 2;
+        score = score * (move->accuracy ? move->accuracy : 100) / 100;
+        if (score > best_score)
+        {
+            best_score = score;
+            best_count = 0;
+        }
+        if (score == best_score)
+            best[best_count++] = m;
+    }
+    if (usable_count == 0)
+        return action;
+
+    // Une fois sur quatre, une attaque au hasard (comme un Pokémon sauvage)
+    if (Random_chance(&battle->rng, 1, 4))
+        action.move = usable[Random_range(&battle->rng, usable_count)];
+    else
+        action.move = best[Random_range(&battle->rng, best_count)];
+    return action;
+}
+
+static int action_priority(const Battle *battle, int side, BattleAction action)
+{
+    if (action.type == ACTION_RUN)
+        return 8; // Avant toute attaque
+    if (action.move < 0)
+        return 0;
+    const MoveData *move = Move_get(battle->sides[side].moves[action.move]);
+    return move ? move->priority : 0;
+}
+
+static void faint_check(Battle *battle, int side)
+{
+    if (battle->sides[side].hp > 0)
+        return;
+    battle->sides[side].hp = 0;
+    push_event(battle, EVENT_FAINT, side, 0, 0);
+    battle->result = side == BATTLE_OPPONENT ? BATTLE_WON : BATTLE_LOST;
+}
+
+static void use_move(Battle *battle, int side, int slot)
+{
+    BattlePokemon *self = &battle->sides[side];
+    BattlePokemon *target = &battle->sides[1 - side];
+
+    // Plus de PP nulle part : Lutte, sans type
+    int power = STRUGGLE_POWER, type = TYPE_NONE, accuracy = 0;
+    MoveCategory category = MOVE_PHYSICAL;
+    uint16_t moveId = 0;
+    if (slot >= 0 && has_pp(self))
+    {
+        const MoveData *move = Move_get(self->moves[slot]);
+        if (!move || self->pp[slot] == 0)
+        {
+            push_event(battle, EVENT_NO_PP, side, self->moves[slot], 0);
+            return;
+        }
+        self->pp[slot]--;
+        moveId = move->id;
+        power = move->power;
+        type = move->type;
+        accuracy = move->accuracy;
+        category = move->category;
+    }
+    push_event(battle, EVENT_MOVE, side, moveId, 0);
+
+    if (accuracy && !Random_chance(&battle->rng, accuracy, 100))
+    {
+        push_event(battle, EVENT_MISS, side, moveId, 0);
+        return;
+    }
+    // Les attaques de statut n'ont pas encore d'effet
+    if (category == MOVE_STATUS || power == 0)
+        return;
+
+    int eff = effectiveness(type, target);
+    if (eff == 0)
+    {
+        push_event(battle, EVENT_EFFECTIVE, side, moveId, 0);
+        return;
+    }
+
+    int attack = category == MOVE_SPECIAL ? self->stats[STAT_SP_ATTACK] : self->stats[STAT_ATTACK];
+    int defense = category == MOVE_SPECIAL ? target->stats[STAT_SP_DEFENSE] : target->stats[STAT_DEFENSE];
+    int damage = ((2 * self->level / 5 + 2) * power * attack / SDL_max(defense, 1)) / 50 + 2;
+
+    // Ordre des tirages fixe : critique puis variation aléatoire
+    bool critical = Random_chance(&battle->rng, 1, CRITICAL_CHANCE);
+    if (critical)
+        damage = damage * 3 / 2;
+    damage = damage * Random_between(&battle->rng, 85, 100) / 100;
+    if (type != TYPE_NONE && (type == self->types[0] || type == self->types[1]))
+        damage = damage * 3 / 2;
+    damage = SDL_max(damage * eff / 4, 1);
+
+    target->hp = (int16_t)SDL_max(target->hp - damage, 0);
+    if (critical)
+        push_event(battle, EVENT_CRITICAL, side, moveId, 0);
+    if (eff != 4)
+        push_event(battle, EVENT_EFFECTIVE, side, moveId, eff);
+    push_event(battle, EVENT_DAMAGE, 1 - side, moveId, damage);
+    faint_check(battle, 1 - side);
+}
+
+static void try_flee(Battle *battle, int side)
+{
+    const BattlePokemon *self = &battle->sides[side];
+    const BattlePokemon *other = &battle->sides[1 - side];
+    battle->flee_attempts++;
+
+    int odds = self->stats[STAT_SPEED] * 128 / SDL_max(other->stats[STAT_SPEED], 1) + 30 * battle->flee_attempts;
+    if (self->stats[STAT_SPEED] >= other->stats[STAT_SPEED] || odds > 255 || (int)Random_range(&battle->rng, 256) < odds)
+    {
+        push_event(battle, EVENT_FLEE, side, 0, 0);
+        battle->result = BATTLE_FLED;
+        return;
+    }
+    push_event(battle, EVENT_FLEE_FAILED, side, 0, 0);
+}
+
+BattleResult Battle_resolveTurn(Battle *battle, BattleAction player, BattleAction opponent)
+{
+    if (battle->result != BATTLE_ONGOING)
+        return battle->result;
+
+    battle->event_count = 0;
+    battle->turn++;
+
+    // Priorité de l'action, puis vitesse, égalité départagée au hasard
+    BattleAction actions[2] = {player, opponent};
+    int p0 = action_priority(battle, BATTLE_PLAYER, player);
+    int p1 = action_priority(battle, BATTLE_OPPONENT, opponent);
+    int s0 = battle->sides[BATTLE_PLAYER].stats[STAT_SPEED];
+    int s1 = battle->sides[BATTLE_OPPONENT].stats[STAT_SPEED];
+    int first;
+    if (p0 != p1)
+        first = p0 > p1 ? BATTLE_PLAYER : BATTLE_OPPONENT;
+    else if (s0 != s1)
+        first = s0 > s1 ? BATTLE_PLAYER : BATTLE_OPPONENT;
+    else
+        first = (int)Random_range(&battle->rng, 2);
+
+    for (int k = 0; k < 2 && battle->result == BATTLE_ONGOING; k++)
+    {
+        int side = k == 0 ? first : 1 - first;
+        if (actions[side].type == ACTION_RUN)
+            try_flee(battle, side);
+        else
+            use_move(battle, side, actions[side].move);
+    }
+    return battle->result;
+}
+
+BattleResult Battle_simulate(Battle *battle)
+{
+    while (battle->result == BATTLE_ONGOING)
+    {
+        if (battle->turn >= BATTLE_MAX_TURNS)
+        {
+            battle->result = BATTLE_DRAW;
+            break;
+        }
+        BattleAction player = Battle_chooseAction(battle, BATTLE_PLAYER);
+        BattleAction opponent = Battle_chooseAction(battle, BATTLE_OPPONENT);
+        Battle_resolveTurn(battle, player, opponent);
+    }
+    return battle->result;
+}
+
+static void simulate_range(void *data, int begin, int end)
+{
+    BattleSim *sims = data;
+    for (int i = begin; i < end; i++)
+    {
+        BattleSim *sim = &sims[i];
+        BattlePokemon a, b;
+        if (!BattlePokemon_init(&a, sim->species[0], sim->level[0]) || !BattlePokemon_init(&b, sim->species[1], sim->level[1]))
+        {
+            sim->result = BATTLE_DRAW;
+            sim->turns = 0;
+            continue;
+        }
+
+        Battle battle;
+        Battle_init(&battle, &a, &b, sim->seed);
+        sim->result = Battle_simulate(&battle);
+        sim->turns = battle.turn;
+    }
+}
+
+void Battle_simulateBatch(JobSystem *jobs, BattleSim *sims, int count)
+{
+    if (!sims || count <= 0)
+        return;
+    if (!jobs)
+    {
+        simulate_range(sims, 0, count);
+        return;
+    }
+    JobSystem_parallelFor(jobs, count, BATTLE_SIM_GRAIN, simulate_range, sims);
+}
+
+void Battle_describeEvent(const Battle *battle, const BattleEvent *event, char *buffer, int size)
+{
+    const char *name = Species_name(Species_get(battle->sides[event->side].species));
+    const char *suffix = event->side == BATTLE_OPPONENT ? " ennemi" : "";
+    const char *move = event->move ? Move_name(Move_get(event->move)) : "Lutte";
+
+    switch (event->type)
+    {
+    case EVENT_MOVE:
+        snprintf(buffer, size, "%s%s utilise %s !", name, suffix, move);
+        break;
+    case EVENT_MISS:
+        snprintf(buffer, size, "%s%s rate son attaque !", name, suffix);
+        break;
+    case EVENT_DAMAGE:
+        snprintf(buffer, size, "%s%s perd %d PV.", name, suffix, event->value);
+        break;
+    case EVENT_EFFECTIVE:
+        snprintf(buffer, size, "%s", event->value == 0  ? "Ça n'a aucun effet..."
+                                     : event->value < 4 ? "Ce n'est pas très efficace..."
+                                                        : "C'est super efficace !");
+        break;
+    case EVENT_CRITICAL:
+        snprintf(buffer, size, "Coup critique !");
+        break;
+    case EVENT_NO_PP:
+        snprintf(buffer, size, "Plus de PP pour %s !", move);
+        break;
+    case EVENT_FAINT:
+        snprintf(buffer, size, "%s%s est K.O. !", name, suffix);
+        break;
+    case EVENT_FLEE:
+        snprintf(buffer, size, "Vous prenez la fuite !");
+        break;
+    case EVENT_FLEE_FAILED:
+        snprintf(buffer, size, "Impossible de fuir !");
+        break;
+    }
+}
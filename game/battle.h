@@ -0,0 +1,124 @@
+#ifndef BATTLE_H
+#define BATTLE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "database.h"
+#include "../systems/random.h"
+#include "../systems/jobs.h"
+
+// Moteur de combat séparé du rendu : l'état d'un combat est une simple structure
+// (copiable, sans pointeur ni allocation), les dégâts sont calculés en entiers et
+// tout l'aléa vient du Random du combat. Un même combat (Pokémon, graine, actions)
+// donne donc le même résultat en jeu, en simulation, sur n'importe quel thread.
+//
+// La base de données (Database_load) doit être chargée : elle n'est que lue.
+
+#define BATTLE_PLAYER 0
+#define BATTLE_OPPONENT 1
+#define BATTLE_MAX_EVENTS 16 // Événements d'un tour, pour l'affichage
+#define BATTLE_MAX_TURNS 200 // Simulation : combat déclaré nul au-delà
+#define BATTLE_SIM_GRAIN 256 // Combats par intervalle de Battle_simulateBatch
+
+// Pokémon au combat (stats calculées depuis l'espèce et le niveau)
+typedef struct
+{
+    uint16_t species;
+    uint8_t level;
+    uint8_t types[2];
+    uint16_t stats[STAT_COUNT]; // stats[STAT_HP] : PV max
+    int16_t hp;
+    uint16_t moves[SPECIES_MAX_MOVES]; // 0 : emplacement vide
+    uint8_t pp[SPECIES_MAX_MOVES];
+} BattlePokemon;
+
+typedef enum
+{
+    ACTION_MOVE,
+    ACTION_RUN
+} BattleActionType;
+
+typedef struct
+{
+    BattleActionType type;
+    int move; // Emplacement de l'attaque (ACTION_MOVE)
+} BattleAction;
+
+typedef enum
+{
+    BATTLE_ONGOING,
+    BATTLE_WON,  // L'adversaire est K.O.
+    BATTLE_LOST, // Le Pokémon du joueur est K.O.
+    BATTLE_FLED,
+    BATTLE_DRAW // Simulation arrêtée après BATTLE_MAX_TURNS
+} BattleResult;
+
+typedef enum
+{
+    EVENT_MOVE,        // 'side' lance 'move'
+    EVENT_MISS,
+    EVENT_DAMAGE,      // 'value' PV perdus par la cible
+    EVENT_EFFECTIVE,   // 'value' : efficacité (x4 : 0 = sans effet, 4 = normal, 8 = super efficace)
+    EVENT_CRITICAL,
+    EVENT_NO_PP,
+    EVENT_FAINT,       // 'side' est K.O.
+    EVENT_FLEE,
+    EVENT_FLEE_FAILED
+} BattleEventType;
+
+typedef struct
+{
+    BattleEventType type;
+    uint8_t side;
+    uint16_t move;
+    int value;
+} BattleEvent;
+
+typedef struct
+{
+    BattlePokemon sides[2]; // BATTLE_PLAYER, BATTLE_OPPONENT
+    Random rng;
+    int turn;
+    int flee_attempts;
+    BattleResult result;
+
+    BattleEvent events[BATTLE_MAX_EVENTS]; // Événements du dernier tour
+    int event_count;
+} Battle;
+
+// Entrée / sortie d'une simulation sans affichage
+typedef struct
+{
+    uint16_t species[2];
+    uint8_t level[2];
+    uint64_t seed;
+
+    BattleResult result;
+    int turns;
+} BattleSim;
+
+// Remplit un Pokémon à partir de la base, false si l'espèce n'existe pas
+bool BattlePokemon_init(BattlePokemon *pokemon, uint16_t species, int level);
+
+void Battle_init(Battle *battle, const BattlePokemon *player, const BattlePokemon *opponent, uint64_t seed);
+
+// Efficacité d'un type d'attaque contre un type de défenseur (x2 : 0, 1, 2 ou 4)
+int Battle_typeEffectiveness(ElementType attack, ElementType defense);
+
+// Choix de l'IA pour 'side' (utilise le Random du combat)
+BattleAction Battle_chooseAction(Battle *battle, int side);
+
+// Résout un tour ; les événements du tour sont dans battle->events
+BattleResult Battle_resolveTurn(Battle *battle, BattleAction player, BattleAction opponent);
+
+// Combat complet IA contre IA sur le thread appelant
+BattleResult Battle_simulate(Battle *battle);
+
+// Simule 'count' combats indépendants (chacun avec sa graine) en parallèle sur 'jobs'
+// (NULL : sur le thread appelant) ; remplit 'result' et 'turns' de chaque entrée
+void Battle_simulateBatch(JobSystem *jobs, BattleSim *sims, int count);
+
+// Texte d'un événement ("Pikachu utilise Éclair !"), pour le journal et les dialogues
+void Battle_describeEvent(const Battle *battle, const BattleEvent *event, char *buffer, int size);
+
+#endif
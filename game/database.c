@@ -0,0 +1,282 @@
+#include "database.h"
+#include <stdio.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+static const char *type_names[TYPE_COUNT] = {
+    "none", "normal", "fire", "water", "grass", "electric", "ice", "fighting", "poison", "ground",
+    "flying", "psychic", "bug", "rock", "ghost", "dragon", "dark", "steel", "fairy"};
+
+static const char *category_names[ITEM_CATEGORY_COUNT] = {"pokeball", "medicine", "key", "misc"};
+
+// Base projetée (une seule à la fois) : pointeurs vers les tables dans le fichier
+static struct
+{
+    void *data;
+    size_t size;
+
+    const SpeciesData *species;
+    const MoveData *moves;
+    const ItemData *items;
+    const uint16_t *species_index;
+    const uint16_t *move_index;
+    const uint16_t *item_index;
+    const char *strings;
+    const DatabaseHeader *header;
+} db;
+
+// Une table [offset, offset + count * size[ doit tenir dans le fichier
+static bool table_fits(size_t fileSize, uint32_t offset, uint32_t count, size_t size, size_t align)
+{
+    return offset % align == 0 && offset <= fileSize && (uint64_t)count * size <= fileSize - offset;
+}
+
+static bool validate(const DatabaseHeader *h, size_t size)
+{
+    if (h->magic != DATABASE_MAGIC || h->version != DATABASE_VERSION)
+        return false;
+    if (!table_fits(size, h->species_offset, h->species_count, sizeof(SpeciesData), 4) ||
+        !table_fits(size, h->move_offset, h->move_count, sizeof(MoveData), 4) ||
+        !table_fits(size, h->species_index_offset, h->species_index_count, sizeof(uint16_t), 2) ||
+        !table_fits(size, h->move_index_offset, h->move_index_count, sizeof(uint16_t), 2) ||
+        !table_fits(size, h->item_offset, h->item_count, sizeof(ItemData), 4) ||
+        !table_fits(size, h->item_index_offset, h->item_index_count, sizeof(uint16_t), 2) ||
+        !table_fits(size, h->strings_offset, h->strings_size, 1, 1))
+        return false;
+
+    // La table de chaînes se termine par un zéro : toute chaîne y est bornée
+    const char *strings = (const char *)h + h->strings_offset;
+    if (h->strings_size == 0 || strings[h->strings_size - 1] != '\0')
+        return false;
+
+    const SpeciesData *species = (const void *)((const char *)h + h->species_offset);
+    for (uint32_t i = 0; i < h->species_count; i++)
+    {
+        if (species[i].name >= h->strings_size || species[i].sprite >= h->strings_size)
+            return false;
+    }
+    const MoveData *moves = (const void *)((const char *)h + h->move_offset);
+    for (uint32_t i = 0; i < h->move_count; i++)
+    {
+        if (moves[i].name >= h->strings_size)
+            return false;
+    }
+    const ItemData *items = (const void *)((const char *)h + h->item_offset);
+    for (uint32_t i = 0; i < h->item_count; i++)
+    {
+        if (items[i].name >= h->strings_size || items[i].category >= ITEM_CATEGORY_COUNT)
+            return false;
+    }
+
+    // Les index ne pointent que vers des enregistrements existants
+    const uint16_t *index = (const void *)((const char *)h + h->species_index_offset);
+    for (uint32_t i = 0; i < h->species_index_count; i++)
+    {
+        if (index[i] != DATABASE_NO_INDEX && index[i] >= h->species_count)
+            return false;
+    }
+    index = (const void *)((const char *)h + h->move_index_offset);
+    for (uint32_t i = 0; i < h->move_index_count; i++)
+    {
+        if (index[i] != DATABASE_NO_INDEX && index[i] >= h->move_count)
+            return false;
+    }
+    index = (const void *)((const char *)h + h->item_index_offset);
+    for (uint32_t i = 0; i < h->item_index_count; i++)
+    {
+        if (index[i] != DATABASE_NO_INDEX && index[i] >= h->item_count)
+            return false;
+    }
+    return true;
+}
+
+bool Database_load(const char *path)
+{
+    Database_unload();
+
+    int fd = open(path, O_RDONLY);
+    if (fd < 0)
+    {
+        fprintf(stderr, "Impossible d'ouvrir la base de données %s\n", path);
+        return false;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(DatabaseHeader))
+    {
+        fprintf(stderr, "Base de données %s vide ou illisible\n", path);
+        close(fd);
+        return false;
+    }
+
+    void *data = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED)
+    {
+        fprintf(stderr, "Impossible de projeter la base de données %s\n", path);
+        return false;
+    }
+
+    const DatabaseHeader *h = data;
+    if (!validate(h, st.st_size))
+    {
+        fprintf(stderr, "Base de données %s invalide (version attendue %d), relancer tools/dbcompile\n", path, DATABASE_VERSION);
+        munmap(data, st.st_size);
+        return false;
+    }
+
+    const char *base = data;
+    db.data = data;
+    db.size = st.st_size;
+    db.header = h;
+    db.species = (const void *)(base + h->species_offset);
+    db.moves = (const void *)(base + h->move_offset);
+    db.species_index = (const void *)(base + h->species_index_offset);
+    db.move_index = (const void *)(base + h->move_index_offset);
+    db.items = (const void *)(base + h->item_offset);
+    db.item_index = (const void *)(base + h->item_index_offset);
+    db.strings = base + h->strings_offset;
+    return true;
+}
+
+void Database_unload(void)
+{
+    if (db.data)
+        munmap(db.data, db.size);
+    memset(&db, 0, sizeof(db));
+}
+
+bool Database_isLoaded(void)
+{
+    return db.data != NULL;
+}
+
+const SpeciesData *Species_get(uint16_t id)
+{
+    if (!db.data || id >= db.header->species_index_count || db.species_index[id] == DATABASE_NO_INDEX)
+        return NULL;
+    return &db.species[db.species_index[id]];
+}
+
+const MoveData *Move_get(uint16_t id)
+{
+    if (!db.data || id >= db.header->move_index_count || db.move_index[id] == DATABASE_NO_INDEX)
+        return NULL;
+    return &db.moves[db.move_index[id]];
+}
+
+const ItemData *Item_get(uint16_t id)
+{
+    if (!db.data || id >= db.header->item_index_count || db.item_index[id] == DATABASE_NO_INDEX)
+        return NULL;
+    return &db.items[db.item_index[id]];
+}
+
+const SpeciesData *Species_find(const char *name)
+{
+    if (!db.data || !name)
+        return NULL;
+    for (uint32_t i = 0; i < db.header->species_count; i++)
+    {
+        if (strcmp(db.strings + db.species[i].name, name) == 0)
+            return &db.species[i];
+    }
+    return NULL;
+}
+
+const MoveData *Move_find(const char *name)
+{
+    if (!db.data || !name)
+        return NULL;
+    for (uint32_t i = 0; i < db.header->move_count; i++)
+    {
+        if (strcmp(db.strings + db.moves[i].name, name) == 0)
+            return &db.moves[i];
+    }
+    return NULL;
+}
+
+const ItemData *Item_find(const char *name)
+{
+    if (!db.data || !name)
+        return NULL;
+    for (uint32_t i = 0; i < db.header->item_count; i++)
+    {
+        if (strcmp(db.strings + db.items[i].name, name) == 0)
+            return &db.items[i];
+    }
+    return NULL;
+}
+
+const char *Species_name(const SpeciesData *species)
+{
+    return species && db.data ? db.strings + species->name : "";
+}
+
+const char *Species_sprite(const SpeciesData *species)
+{
+    return species && db.data ? db.strings + species->sprite : "";
+}
+
+const char *Move_name(const MoveData *move)
+{
+    return move && db.data ? db.strings + move->name : "";
+}
+
+const char *Item_name(const ItemData *item)
+{
+    return item && db.data ? db.strings + item->name : "";
+}
+
+int Species_count(void)
+{
+    return db.data ? (int)db.header->species_count : 0;
+}
+
+int Move_count(void)
+{
+    return db.data ? (int)db.header->move_count : 0;
+}
+
+int Item_count(void)
+{
+    return db.data ? (int)db.header->item_count : 0;
+}
+
+int Item_idLimit(void)
+{
+    return db.data ? (int)db.header->item_index_count : 0;
+}
+
+const char *ElementType_name(ElementType type)
+{
+    return (type >= 0 && type < TYPE_COUNT) ? type_names[type] : type_names[TYPE_NONE];
+}
+
+ElementType ElementType_parse(const char *name)
+{
+    for (int t = 0; t < TYPE_COUNT; t++)
+    {
+        if (name && strcmp(name, type_names[t]) == 0)
+            return (ElementType)t;
+    }
+    return TYPE_NONE;
+}
+
+const char *ItemCategory_name(ItemCategory category)
+{
+    return (category >= 0 && category < ITEM_CATEGORY_COUNT) ? category_names[category] : "";
+}
+
+int ItemCategory_parse(const char *name)
+{
+    for (int c = 0; c < ITEM_CATEGORY_COUNT; c++)
+    {
+        if (name && strcmp(name, category_names[c]) == 0)
+            return c;
+    }
+    return -1;
+}
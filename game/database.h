@@ -0,0 +1,154 @@
+#ifndef DATABASE_H
+#define DATABASE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Base de données des espèces, des attaques et des objets. Les CSV de resources/data sont
+// compilés hors ligne par tools/dbcompile en un fichier binaire (en-tête, tables
+// d'enregistrements de taille fixe, index par identifiant, table de chaînes) que
+// le jeu projette en mémoire avec mmap : aucune analyse ni allocation au démarrage,
+// les accesseurs retournent des pointeurs directement dans le fichier.
+//
+// Le fichier est écrit dans l'ordre des octets de la machine qui le compile
+// (little-endian sur les cibles du jeu) ; Database_load refuse un fichier dont la
+// signature ou la version ne correspond pas.
+
+#define DATABASE_PATH "resources/data/pokedex.db"
+#define DATABASE_MAGIC 0x42444B50u // "PKDB"
+#define DATABASE_VERSION 2
+#define DATABASE_NO_INDEX 0xFFFFu  // Identifiant sans enregistrement
+#define SPECIES_MAX_MOVES 4
+
+typedef enum
+{
+    TYPE_NONE,
+    TYPE_NORMAL,
+    TYPE_FIRE,
+    TYPE_WATER,
+    TYPE_GRASS,
+    TYPE_ELECTRIC,
+    TYPE_ICE,
+    TYPE_FIGHTING,
+    TYPE_POISON,
+    TYPE_GROUND,
+    TYPE_FLYING,
+    TYPE_PSYCHIC,
+    TYPE_BUG,
+    TYPE_ROCK,
+    TYPE_GHOST,
+    TYPE_DRAGON,
+    TYPE_DARK,
+    TYPE_STEEL,
+    TYPE_FAIRY,
+    TYPE_COUNT
+} ElementType;
+
+typedef enum
+{
+    MOVE_PHYSICAL,
+    MOVE_SPECIAL,
+    MOVE_STATUS
+} MoveCategory;
+
+typedef enum
+{
+    STAT_HP,
+    STAT_ATTACK,
+    STAT_DEFENSE,
+    STAT_SP_ATTACK,
+    STAT_SP_DEFENSE,
+    STAT_SPEED,
+    STAT_COUNT
+} Stat;
+
+typedef enum
+{
+    ITEM_POKEBALL,
+    ITEM_MEDICINE, // Potions, soins
+    ITEM_KEY,      // Objets rares (ne se vendent pas, ne se jettent pas)
+    ITEM_MISC,
+    ITEM_CATEGORY_COUNT
+} ItemCategory;
+
+// Enregistrements tels qu'ils sont dans le fichier (chaînes : décalage dans la table de chaînes)
+typedef struct
+{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t species_count, species_offset;
+    uint32_t move_count, move_offset;
+    uint32_t species_index_count, species_index_offset; // uint16_t[id] -> enregistrement
+    uint32_t move_index_count, move_index_offset;
+    uint32_t item_count, item_offset;
+    uint32_t item_index_count, item_index_offset;
+    uint32_t strings_size, strings_offset;
+} DatabaseHeader;
+
+typedef struct
+{
+    uint16_t id;
+    uint8_t types[2]; // ElementType, TYPE_NONE pour le second type absent
+    uint8_t base[STAT_COUNT];
+    uint16_t moves[SPECIES_MAX_MOVES]; // Attaques de base, 0 : aucune
+    uint32_t name;
+    uint32_t sprite; // Chemin de l'image de combat
+} SpeciesData;
+
+typedef struct
+{
+    uint16_t id;
+    uint8_t type;     // ElementType
+    uint8_t category; // MoveCategory
+    uint8_t power;
+    uint8_t accuracy; // Sur 100, 0 : touche toujours
+    uint8_t pp;
+    int8_t priority;
+    uint32_t name;
+} MoveData;
+
+typedef struct
+{
+    uint16_t id;
+    uint8_t category; // ItemCategory
+    uint8_t pad;
+    uint16_t price;
+    uint16_t param; // PV rendus (soins), taux de capture (balls)
+    uint32_t name;
+} ItemData;
+
+// Projette le fichier en mémoire ; false (et message) s'il est absent ou invalide
+bool Database_load(const char *path);
+void Database_unload(void);
+bool Database_isLoaded(void);
+
+// NULL si l'identifiant n'existe pas ; n'alloue jamais
+const SpeciesData *Species_get(uint16_t id);
+const MoveData *Move_get(uint16_t id);
+const ItemData *Item_get(uint16_t id);
+
+// Recherche par nom (linéaire, pour le chargement des cartes et des scripts)
+const SpeciesData *Species_find(const char *name);
+const MoveData *Move_find(const char *name);
+const ItemData *Item_find(const char *name);
+
+const char *Species_name(const SpeciesData *species);
+const char *Species_sprite(const SpeciesData *species);
+const char *Move_name(const MoveData *move);
+const char *Item_name(const ItemData *item);
+
+int Species_count(void);
+int Move_count(void);
+int Item_count(void);
+// Plus grand identifiant d'objet + 1 (taille des tables indexées par identifiant)
+int Item_idLimit(void);
+
+// Nom d'un type ("fire", ...), TYPE_NONE pour un nom inconnu
+const char *ElementType_name(ElementType type);
+ElementType ElementType_parse(const char *name);
+
+// Nom d'une catégorie d'objets ("pokeball", ...), -1 pour un nom inconnu
+const char *ItemCategory_name(ItemCategory category);
+int ItemCategory_parse(const char *name);
+
+#endif
@@ -0,0 +1,97 @@
+#include "dialogue.h"
+#include <stdio.h>
+#include <string.h>
+
+void DialogueBox_init(DialogueBox *box, int screenWidth, int screenHeight)
+{
+    memset(box, 0, sizeof(DialogueBox));
+    int height = DIALOGUE_LINES * FONT_LINE_HEIGHT + 2 * DIALOGUE_PADDING;
+    box->box = (SDL_Rect){8, screenHeight - height - 8, screenWidth - 16, height};
+    box->text_width = box->box.w - 2 * DIALOGUE_PADDING;
+}
+
+void DialogueBox_open(DialogueBox *box, const char *text)
+{
+    snprintf(box->text, sizeof(box->text), "%s", text);
+    box->open = true;
+    box->revealed = 0.0f;
+    box->page_line = 0;
+}
+
+void DialogueBox_close(DialogueBox *box)
+{
+    box->open = false;
+}
+
+void DialogueBox_update(DialogueBox *box, float deltaTime)
+{
+    if (box->open)
+        box->revealed += DIALOGUE_SPEED * deltaTime;
+}
+
+// Glyphes [first, first + count[ de la page courante
+static void page_range(const DialogueBox *box, const TextLayout *layout, int *first, int *count)
+{
+    int last_line = SDL_min(box->page_line + DIALOGUE_LINES, layout->line_count);
+    *first = layout->line_first[box->page_line];
+    *count = layout->line_first[last_line] - *first;
+}
+
+bool DialogueBox_advance(DialogueBox *box, TextCache *text)
+{
+    if (!box->open)
+        return false;
+
+    TextLayout *layout = TextCache_get(text, box->text, box->text_width);
+    if (!layout)
+    {
+        box->open = false;
+        return false;
+    }
+
+    int first, count;
+    page_range(box, layout, &first, &count);
+    if (box->revealed < count)
+    {
+        box->revealed = (float)count;
+        return true;
+    }
+
+    box->page_line += DIALOGUE_LINES;
+    box->revealed = 0.0f;
+    if (box->page_line >= layout->line_count)
+        box->open = false;
+    return box->open;
+}
+
+void DialogueBox_render(DialogueBox *box, TextCache *text, SDL_Renderer *renderer)
+{
+    if (!box->open)
+        return;
+
+    SDL_SetRenderDrawColor(renderer, 248, 248, 240, 255);
+    SDL_RenderFillRect(renderer, &box->box);
+    SDL_SetRenderDrawColor(renderer, 40, 48, 64, 255);
+    SDL_RenderDrawRect(renderer, &box->box);
+
+    TextLayout *layout = TextCache_get(text, box->text, box->text_width);
+    if (!layout)
+        return;
+
+    int first, count;
+    page_range(box, layout, &first, &count);
+    int visible = SDL_min((int)box->revealed, count);
+
+    // La page est décalée vers le haut pour que sa première ligne tombe en haut de la boîte
+    int x = box->box.x + DIALOGUE_PADDING;
+    int y = box->box.y + DIALOGUE_PADDING - box->page_line * FONT_LINE_HEIGHT * text->font->scale;
+    Text_draw(text, renderer, layout, x, y, (SDL_Color){40, 40, 48, 255}, first, visible);
+
+    // Page suivante : petit triangle en bas à droite une fois la page affichée
+    if (visible == count && box->page_line + DIALOGUE_LINES < layout->line_count)
+    {
+        int tx = box->box.x + box->box.w - DIALOGUE_PADDING - 5, ty = box->box.y + box->box.h - DIALOGUE_PADDING - 3;
+        for (int row = 0; row < 3; row++)
+            SDL_RenderDrawLine(renderer, tx + row, ty + row, tx + 4 - row, ty + row);
+    }
+}
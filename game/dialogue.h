@@ -0,0 +1,42 @@
+#ifndef DIALOGUE_H
+#define DIALOGUE_H
+
+#include <SDL2/SDL.h>
+#include <stdbool.h>
+#include "../systems/text.h"
+
+// Boîte de dialogue en bas de l'écran : le texte apparaît lettre par lettre
+// (on ne dessine que les N premiers glyphes de sa mise en page, sans la refaire),
+// page par page quand il dépasse la hauteur de la boîte.
+
+#define DIALOGUE_TEXT_MAX 512
+#define DIALOGUE_LINES 3
+#define DIALOGUE_PADDING 6
+#define DIALOGUE_SPEED 40.0f // Glyphes par seconde
+
+typedef struct
+{
+    bool open;
+    char text[DIALOGUE_TEXT_MAX];
+    SDL_Rect box;
+    int text_width; // Largeur de mise en page (intérieur de la boîte)
+
+    float revealed; // Glyphes affichés depuis le début de la page
+    int page_line;  // Première ligne de la page affichée
+} DialogueBox;
+
+// Place la boîte en bas d'un écran de 'screenWidth' x 'screenHeight'
+void DialogueBox_init(DialogueBox *box, int screenWidth, int screenHeight);
+
+void DialogueBox_open(DialogueBox *box, const char *text);
+void DialogueBox_close(DialogueBox *box);
+
+void DialogueBox_update(DialogueBox *box, float deltaTime);
+
+// Touche d'action : termine la page en cours d'affichage, sinon passe à la page
+// suivante ou ferme la boîte. Retourne true tant que la boîte reste ouverte.
+bool DialogueBox_advance(DialogueBox *box, TextCache *text);
+
+void DialogueBox_render(DialogueBox *box, TextCache *text, SDL_Renderer *renderer);
+
+#endif
@@ -0,0 +1,271 @@
+#include "encounter.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Feuilles projetées par un bruissement : direction (pixels sur toute la durée)
+static const float leaf_offsets[4][2] = {{-6.0f, -7.0f}, {6.0f, -7.0f}, {-3.0f, -10.0f}, {3.0f, -10.0f}};
+
+// Lit "Nom min-max poids, ..." ; le poids est facultatif (1), le niveau peut être seul ("Nom 5")
+static void parse_species(Arena *arena, EncounterZone *zone, const char *text)
+{
+    const char *p = text;
+    while (*p && zone->slot_count < ENCOUNTER_MAX_SLOTS)
+    {
+        const char *end = strchr(p, ',');
+        size_t len = end ? (size_t)(end - p) : strlen(p);
+
+        char entry[96], name[64];
+        snprintf(entry, sizeof(entry), "%.*s", (int)len, p);
+        int min = 1, max = 1, weight = 1;
+        int n = sscanf(entry, "%63s %d-%d %d", name, &min, &max, &weight);
+        if (n == 2 && sscanf(entry, "%63s %d %d", name, &min, &weight) >= 2)
+            max = min;
+
+        if (n >= 2 && weight > 0 && min > 0 && max >= min)
+        {
+            EncounterSlot *slot = &zone->slots[zone->slot_count];
+            slot->species = Arena_strdup(arena, name);
+            if (slot->species)
+            {
+                slot->min_level = min;
+                slot->max_level = max;
+                slot->weight = weight;
+                zone->total_weight += weight;
+                zone->slot_count++;
+            }
+        }
+        else if (n >= 1)
+        {
+            fprintf(stderr, "Zone de rencontre %s: espèce invalide '%s'\n", zone->name, entry);
+        }
+
+        if (!end)
+            break;
+        p = end + 1;
+    }
+}
+
+// Lit les propriétés d'une zone, NULL si elle n'a pas de taux ou d'espèce
+static EncounterZone *add_zone(EncounterMap *em, Arena *arena, const char *name, tmx_properties *props)
+{
+    tmx_property *rate = tmx_get_property(props, "encounter_rate");
+    tmx_property *species = tmx_get_property(props, "species");
+    if (!rate || rate->type != PT_INT || !species || species->type != PT_STRING)
+        return NULL;
+
+    if (em->zone_count >= ENCOUNTER_MAX_ZONES)
+    {
+        fprintf(stderr, "Trop de zones de rencontre (max %d)\n", ENCOUNTER_MAX_ZONES);
+        return NULL;
+    }
+
+    EncounterZone *zone = &em->zones[em->zone_count];
+    memset(zone, 0, sizeof(EncounterZone));
+    zone->name = Arena_strdup(arena, name ? name : "");
+    zone->rate = SDL_max(SDL_min(rate->value.integer, 100), 0);
+    tmx_property *grass = tmx_get_property(props, "grass");
+    zone->grass = !grass || grass->type != PT_BOOL || grass->value.boolean;
+    parse_species(arena, zone, species->value.string);
+
+    if (zone->slot_count == 0)
+    {
+        fprintf(stderr, "Zone de rencontre %s sans espèce valide\n", zone->name);
+        return NULL;
+    }
+    em->zone_count++;
+    return zone;
+}
+
+// Calques de tuiles déclarant une zone (parcours des groupes compris)
+static void bake_layers(EncounterMap *em, Arena *arena, tmx_layer *layer)
+{
+    for (; layer; layer = layer->next)
+    {
+        if (layer->type == L_GROUP)
+        {
+            bake_layers(em, arena, layer->content.group_head);
+            continue;
+        }
+        if (layer->type != L_LAYER || !layer->content.gids)
+            continue;
+        if (!add_zone(em, arena, layer->name, layer->properties))
+            continue;
+
+        uint8_t id = (uint8_t)em->zone_count;
+        for (int i = 0; i < em->width * em->height; i++)
+        {
+            if (layer->content.gids[i] & TMX_FLIP_BITS_REMOVAL)
+                em->zone_ids[i] = id;
+        }
+    }
+}
+
+// Rectangles du groupe "EncounterZones" : une tuile en fait partie si son centre y est
+static void bake_objects(EncounterMap *em, Arena *arena, tmx_map *map)
+{
+    tmx_layer *layer = tmx_find_layer_by_name(map, ENCOUNTER_LAYER_NAME);
+    if (!layer || layer->type != L_OBJGR)
+        return;
+
+    for (tmx_object *o = layer->content.objgr->head; o; o = o->next)
+    {
+        if (o->obj_type != OT_SQUARE || !add_zone(em, arena, o->name, o->properties))
+            continue;
+
+        uint8_t id = (uint8_t)em->zone_count;
+        int x0 = SDL_max((int)(o->x / em->tile_width), 0);
+        int y0 = SDL_max((int)(o->y / em->tile_height), 0);
+        int x1 = SDL_min((int)((o->x + o->width) / em->tile_width), em->width - 1);
+        int y1 = SDL_min((int)((o->y + o->height) / em->tile_height), em->height - 1);
+        for (int ty = y0; ty <= y1; ty++)
+            for (int tx = x0; tx <= x1; tx++)
+            {
+                float cx = (tx + 0.5f) * em->tile_width, cy = (ty + 0.5f) * em->tile_height;
+                if (cx >= o->x && cx < o->x + o->width && cy >= o->y && cy < o->y + o->height)
+                    em->zone_ids[ty * em->width + tx] = id;
+            }
+    }
+}
+
+EncounterMap *EncounterMap_load(Arena *arena, tmx_map *map, int widthTiles, int heightTiles)
+{
+    if (!arena || !map || widthTiles <= 0 || heightTiles <= 0)
+        return NULL;
+
+    EncounterMap *em = Arena_calloc(arena, 1, sizeof(EncounterMap));
+    if (!em)
+        return NULL;
+    em->width = widthTiles;
+    em->height = heightTiles;
+    em->tile_width = map->tile_width;
+    em->tile_height = map->tile_height;
+    em->zone_ids = Arena_calloc(arena, (size_t)widthTiles * heightTiles, sizeof(uint8_t));
+    em->zones = Arena_alloc(arena, ENCOUNTER_MAX_ZONES * sizeof(EncounterZone));
+    if (!em->zone_ids || !em->zones)
+    {
+        fprintf(stderr, "Erreur d'allocation mémoire pour les zones de rencontre.\n");
+        return NULL;
+    }
+
+    // Les rectangles sont appliqués après les calques et l'emportent sur eux
+    bake_layers(em, arena, map->ly_head);
+    bake_objects(em, arena, map);
+    if (em->zone_count == 0)
+        return NULL;
+
+    em->last_tx = em->last_ty = -1;
+    Random_seed(&em->rng, 1);
+    return em;
+}
+
+void EncounterMap_seed(EncounterMap *em, uint64_t seed)
+{
+    if (em)
+        Random_seed(&em->rng, seed);
+}
+
+static int zone_index(EncounterMap *em, int tx, int ty)
+{
+    if (tx < 0 || ty < 0 || tx >= em->width || ty >= em->height)
+        return 0;
+    return em->zone_ids[ty * em->width + tx];
+}
+
+const EncounterZone *EncounterMap_zoneAt(EncounterMap *em, float x, float y)
+{
+    if (!em || x < 0.0f || y < 0.0f)
+        return NULL;
+    int id = zone_index(em, (int)(x / em->tile_width), (int)(y / em->tile_height));
+    return id ? &em->zones[id - 1] : NULL;
+}
+
+static void spawn_effect(EncounterMap *em, int tx, int ty, uint32_t time)
+{
+    GrassEffect *e = &em->effects[em->next_effect];
+    em->next_effect = (em->next_effect + 1) % ENCOUNTER_EFFECT_POOL;
+    e->x = (tx + 0.5f) * em->tile_width;
+    e->y = (ty + 1.0f) * em->tile_height;
+    e->start = time ? time : 1; // 0 : emplacement libre
+}
+
+bool EncounterMap_step(EncounterMap *em, float x, float y, uint32_t time, Encounter *out)
+{
+    if (!em)
+        return false;
+    em->time = time;
+    if (x < 0.0f || y < 0.0f)
+        return false;
+
+    int tx = (int)(x / em->tile_width), ty = (int)(y / em->tile_height);
+    if (tx == em->last_tx && ty == em->last_ty)
+        return false;
+
+    // Première position connue (apparition) : pas de tirage
+    bool first = em->last_tx < 0;
+    em->last_tx = tx;
+    em->last_ty = ty;
+    if (first)
+        return false;
+
+    int id = zone_index(em, tx, ty);
+    if (!id)
+        return false;
+    const EncounterZone *zone = &em->zones[id - 1];
+    if (zone->grass)
+        spawn_effect(em, tx, ty, time);
+
+    if (!Random_chance(&em->rng, zone->rate, 100))
+        return false;
+
+    // Espèce tirée selon les poids, puis niveau uniforme dans l'intervalle
+    int roll = (int)Random_range(&em->rng, zone->total_weight);
+    const EncounterSlot *slot = &zone->slots[0];
+    for (int i = 0; i < zone->slot_count; i++)
+    {
+        slot = &zone->slots[i];
+        if (roll < slot->weight)
+            break;
+        roll -= slot->weight;
+    }
+
+    if (out)
+    {
+        out->zone = zone;
+        out->species = slot->species;
+        out->level = Random_between(&em->rng, slot->min_level, slot->max_level);
+    }
+    return true;
+}
+
+void EncounterMap_renderEffects(EncounterMap *em, SDL_Renderer *renderer, Camera *camera)
+{
+    if (!em || !renderer || !camera)
+        return;
+
+    SDL_Rect rects[ENCOUNTER_EFFECT_POOL * 4];
+    int count = 0;
+    for (int i = 0; i < ENCOUNTER_EFFECT_POOL; i++)
+    {
+        GrassEffect *e = &em->effects[i];
+        if (!e->start || em->time - e->start >= ENCOUNTER_EFFECT_DURATION)
+            continue;
+
+        // Les feuilles s'écartent puis retombent un peu
+        float t = (float)(em->time - e->start) / ENCOUNTER_EFFECT_DURATION;
+        float lift = t * (1.0f - t) * 4.0f;
+        for (int l = 0; l < 4; l++)
+        {
+            rects[count++] = (SDL_Rect){(int)(e->x + leaf_offsets[l][0] * t) - camera->view_rect.x,
+                                        (int)(e->y - 4.0f + leaf_offsets[l][1] * lift) - camera->view_rect.y, 2, 2};
+        }
+    }
+    if (count == 0)
+        return;
+
+    Uint8 r, g, b, a;
+    SDL_GetRenderDrawColor(renderer, &r, &g, &b, &a);
+    SDL_SetRenderDrawColor(renderer, 86, 160, 58, 255);
+    SDL_RenderFillRects(renderer, rects, count);
+    SDL_SetRenderDrawColor(renderer, r, g, b, a);
+}
@@ -0,0 +1,96 @@
+#ifndef ENCOUNTER_H
+#define ENCOUNTER_H
+
+#include <SDL2/SDL.h>
+#include <tmx.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include "entity.h"
+#include "../systems/arena.h"
+#include "../systems/camera.h"
+#include "../systems/random.h"
+
+// Zones de rencontres (hautes herbes, grottes, ...) lues dans le TMX et précalculées
+// au chargement en un identifiant de zone par tuile. Le tirage n'a lieu que lorsque
+// le joueur entre dans une nouvelle tuile, pas à chaque frame.
+//
+// Une zone se déclare de deux façons :
+//  - un rectangle du groupe d'objets "EncounterZones" ;
+//  - un calque de tuiles ayant la propriété "encounter_rate" (chaque tuile non vide
+//    du calque fait partie de la zone, nommée comme le calque ; carte finie seulement).
+// Propriétés :
+//   encounter_rate (int)   chance de rencontre sur 100 par tuile entrée
+//   species (string)       "Nom min-max poids, ..." (ex. "Rattata 2-4 60, Roucool 3-5 40")
+//   grass (bool)           herbe qui bruisse au passage (vrai par défaut)
+
+#define ENCOUNTER_LAYER_NAME "EncounterZones"
+#define ENCOUNTER_MAX_ZONES 255 // Identifiants sur 8 bits, 0 : pas de zone
+#define ENCOUNTER_MAX_SLOTS 8
+#define ENCOUNTER_EFFECT_POOL 16      // Bruissements d'herbe affichés en même temps au plus
+#define ENCOUNTER_EFFECT_DURATION 300 // ms
+
+typedef struct
+{
+    char *species;
+    int min_level, max_level;
+    int weight;
+} EncounterSlot;
+
+typedef struct
+{
+    char *name;
+    int rate; // Sur 100
+    bool grass;
+    EncounterSlot slots[ENCOUNTER_MAX_SLOTS];
+    int slot_count;
+    int total_weight;
+} EncounterZone;
+
+// Résultat d'un tirage
+typedef struct
+{
+    const EncounterZone *zone;
+    const char *species;
+    int level;
+} Encounter;
+
+// Bruissement d'herbe, recyclé dans un tableau de taille fixe
+typedef struct
+{
+    float x, y; // Bas-centre de la tuile, en pixels
+    uint32_t start;
+} GrassEffect;
+
+typedef struct
+{
+    int width, height; // En tuiles
+    int tile_width, tile_height;
+    uint8_t *zone_ids; // width * height, indice dans 'zones' + 1
+    EncounterZone *zones;
+    int zone_count;
+
+    Random rng;
+    int last_tx, last_ty; // Dernière tuile où le joueur a été vu
+    uint32_t time;        // Temps du dernier EncounterMap_step
+
+    GrassEffect effects[ENCOUNTER_EFFECT_POOL];
+    int next_effect; // Prochain emplacement réutilisé (le plus ancien)
+} EncounterMap;
+
+// Construit la table des zones (mémoire dans 'arena'), NULL si la carte n'en a aucune
+EncounterMap *EncounterMap_load(Arena *arena, tmx_map *map, int widthTiles, int heightTiles);
+
+void EncounterMap_seed(EncounterMap *em, uint64_t seed);
+
+// Zone de la tuile contenant le point (x, y) en pixels, NULL s'il n'y en a pas
+const EncounterZone *EncounterMap_zoneAt(EncounterMap *em, float x, float y);
+
+// À appeler chaque frame avec la position des pieds du joueur. Ne fait rien tant
+// qu'il reste sur la même tuile ; sinon déclenche le bruissement et tire une
+// éventuelle rencontre. Retourne true et remplit 'out' en cas de rencontre.
+bool EncounterMap_step(EncounterMap *em, float x, float y, uint32_t time, Encounter *out);
+
+// Dessine les bruissements en cours
+void EncounterMap_renderEffects(EncounterMap *em, SDL_Renderer *renderer, Camera *camera);
+
+#endif
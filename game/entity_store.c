@@ -0,0 +1,655 @@
+#include "entity_store.h"
+#include <stdlib.h>
+#include <stdio.h>
+#include <math.h>
+
+#define ENTITY_SLOT_NONE UINT32_MAX
+
+static bool grow_array(void **array, size_t element_size, int capacity)
+{
+    void *p = realloc(*array, element_size * capacity);
+    if (!p)
+        return false;
+    *array = p;
+    return true;
+}
+
+// Agrandit tous les tableaux en même temps (les slots ne dépassent jamais la capacité)
+static bool EntityStore_grow(EntityStore *store, int capacity)
+{
+    bool ok = grow_array((void **)&store->x, sizeof(float), capacity) &&
+              grow_array((void **)&store->y, sizeof(float), capacity) &&
+              grow_array((void **)&store->width, sizeof(float), capacity) &&
+              grow_array((void **)&store->height, sizeof(float), capacity) &&
+              grow_array((void **)&store->hitbox, sizeof(Hitbox), capacity) &&
+              grow_array((void **)&store->hitbox_offset_x, sizeof(float), capacity) &&
+              grow_array((void **)&store->hitbox_offset_y, sizeof(float), capacity) &&
+              grow_array((void **)&store->target_x, sizeof(float), capacity) &&
+              grow_array((void **)&store->target_y, sizeof(float), capacity) &&
+              grow_array((void **)&store->speed, sizeof(float), capacity) &&
+              grow_array((void **)&store->has_target, sizeof(uint8_t), capacity) &&
+              grow_array((void **)&store->moving, sizeof(uint8_t), capacity) &&
+              grow_array((void **)&store->direction, sizeof(uint8_t), capacity) &&
+              grow_array((void **)&store->route, sizeof(EntityRoute *), capacity) &&
+              grow_array((void **)&store->blocked_time, sizeof(float), capacity) &&
+              grow_array((void **)&store->visible, sizeof(uint8_t), capacity) &&
+              grow_array((void **)&store->layer, sizeof(int), capacity) &&
+              grow_array((void **)&store->sprite, sizeof(Sprite *), capacity) &&
+              grow_array((void **)&store->anim_ids, sizeof(EntityAnimIds), capacity) &&
+              grow_array((void **)&store->anim_current, sizeof(int16_t), capacity) &&
+              grow_array((void **)&store->anim_frame, sizeof(int16_t), capacity) &&
+              grow_array((void **)&store->anim_time, sizeof(Uint32), capacity) &&
+              grow_array((void **)&store->script, sizeof(Script *), capacity) &&
+              grow_array((void **)&store->script_pc, sizeof(uint16_t), capacity) &&
+              grow_array((void **)&store->script_wait, sizeof(uint8_t), capacity) &&
+              grow_array((void **)&store->script_wake, sizeof(Uint32), capacity) &&
+              grow_array((void **)&store->activity, sizeof(uint8_t), capacity) &&
+              grow_array((void **)&store->last_update, sizeof(Uint32), capacity) &&
+              grow_array((void **)&store->active_list, sizeof(int), capacity) &&
+              grow_array((void **)&store->offscreen_list, sizeof(int), capacity) &&
+              grow_array((void **)&store->tick_list, sizeof(int), capacity) &&
+              grow_array((void **)&store->owner, sizeof(void *), capacity) &&
+              grow_array((void **)&store->dense_to_slot, sizeof(uint32_t), capacity) &&
+              grow_array((void **)&store->slot_to_dense, sizeof(uint32_t), capacity) &&
+              grow_array((void **)&store->generation, sizeof(uint32_t), capacity);
+    if (ok)
+    {
+        store->capacity = capacity;
+    }
+    return ok;
+}
+
+EntityStore *EntityStore_create(int capacity)
+{
+    EntityStore *store = calloc(1, sizeof(EntityStore));
+    if (!store)
+        return NULL;
+
+    store->free_slot = ENTITY_SLOT_NONE;
+    if (!EntityStore_grow(store, capacity > 0 ? capacity : 16))
+    {
+        fprintf(stderr, "Erreur d'allocation mémoire pour l'EntityStore.\n");
+        EntityStore_free(store);
+        return NULL;
+    }
+    return store;
+}
+
+void EntityStore_free(EntityStore *store)
+{
+    if (!store)
+        return;
+    free(store->x);
+    free(store->y);
+    free(store->width);
+    free(store->height);
+    free(store->hitbox);
+    free(store->hitbox_offset_x);
+    free(store->hitbox_offset_y);
+    free(store->target_x);
+    free(store->target_y);
+    free(store->speed);
+    free(store->has_target);
+    free(store->moving);
+    free(store->direction);
+    free(store->route);
+    free(store->blocked_time);
+    free(store->visible);
+    free(store->layer);
+    free(store->sprite);
+    free(store->anim_ids);
+    free(store->anim_current);
+    free(store->anim_frame);
+    free(store->anim_time);
+    free(store->script);
+    free(store->script_pc);
+    free(store->script_wait);
+    free(store->script_wake);
+    free(store->activity);
+    free(store->last_update);
+    free(store->active_list);
+    free(store->offscreen_list);
+    free(store->tick_list);
+    free(store->owner);
+    free(store->dense_to_slot);
+    free(store->slot_to_dense);
+    free(store->generation);
+    free(store);
+}
+
+EntityHandle EntityStore_spawn(EntityStore *store, float x, float y, float width, float height, Sprite *sprite, int layer, void *owner)
+{
+    if (!store)
+        return ENTITY_HANDLE_NULL;
+
+    if (store->count >= store->capacity && !EntityStore_grow(store, store->capacity * 2))
+    {
+        fprintf(stderr, "Erreur d'allocation mémoire pour l'EntityStore.\n");
+        return ENTITY_HANDLE_NULL;
+    }
+
+    // Réutiliser un slot libre si possible
+    uint32_t slot;
+    if (store->free_slot != ENTITY_SLOT_NONE)
+    {
+        slot = store->free_slot;
+        store->free_slot = store->slot_to_dense[slot];
+    }
+    else
+    {
+        slot = store->slot_count++;
+        store->generation[slot] = 0;
+    }
+
+    int i = store->count++;
+    store->slot_to_dense[slot] = i;
+    store->dense_to_slot[i] = slot;
+
+    store->x[i] = x;
+    store->y[i] = y;
+    store->width[i] = width;
+    store->height[i] = height;
+    store->hitbox_offset_x[i] = 0.0f;
+    store->hitbox_offset_y[i] = 0.0f;
+    store->hitbox[i] = (Hitbox){x, y, width, height};
+    store->target_x[i] = x;
+    store->target_y[i] = y;
+    store->speed[i] = 0.0f;
+    store->has_target[i] = false;
+    store->moving[i] = false;
+    store->direction[i] = 3;
+    store->route[i] = NULL;
+    store->blocked_time[i] = 0.0f;
+    store->visible[i] = true;
+    store->layer[i] = layer;
+    store->sprite[i] = sprite;
+    for (int d = 0; d < 4; d++)
+    {
+        store->anim_ids[i].idle[d] = -1;
+        store->anim_ids[i].walk[d] = -1;
+    }
+    store->anim_current[i] = -1;
+    store->anim_frame[i] = 0;
+    store->anim_time[i] = 0;
+    store->script[i] = NULL;
+    store->script_pc[i] = 0;
+    store->script_wait[i] = SCRIPT_RUNNING;
+    store->script_wake[i] = 0;
+    store->activity[i] = ENTITY_DORMANT; // Classée au prochain EntityStore_schedule
+    store->last_update[i] = 0;
+    store->owner[i] = owner;
+    store->schedule_dirty = true;
+    if (store->spatial)
+        SpatialHash_update(store->spatial, (int)slot + 1, store->hitbox[i]);
+
+    return (EntityHandle){slot, store->generation[slot]};
+}
+
+int EntityStore_indexOf(EntityStore *store, EntityHandle handle)
+{
+    if (!store || handle.slot >= (uint32_t)store->slot_count)
+        return -1;
+    if (store->generation[handle.slot] != handle.generation)
+        return -1;
+    return (int)store->slot_to_dense[handle.slot];
+}
+
+void EntityStore_destroy(EntityStore *store, EntityHandle handle)
+{
+    int i = EntityStore_indexOf(store, handle);
+    if (i < 0)
+        return;
+
+    if (store->spatial)
+        SpatialHash_remove(store->spatial, (int)handle.slot + 1);
+
+    // Déplacer la dernière entité dans le trou pour garder les tableaux compacts
+    int last = store->count - 1;
+    if (i != last)
+    {
+        store->x[i] = store->x[last];
+        store->y[i] = store->y[last];
+        store->width[i] = store->width[last];
+        store->height[i] = store->height[last];
+        store->hitbox[i] = store->hitbox[last];
+        store->hitbox_offset_x[i] = store->hitbox_offset_x[last];
+        store->hitbox_offset_y[i] = store->hitbox_offset_y[last];
+        store->target_x[i] = store->target_x[last];
+        store->target_y[i] = store->target_y[last];
+        store->speed[i] = store->speed[last];
+        store->has_target[i] = store->has_target[last];
+        store->moving[i] = store->moving[last];
+        store->direction[i] = store->direction[last];
+        store->route[i] = store->route[last];
+        store->blocked_time[i] = store->blocked_time[last];
+        store->visible[i] = store->visible[last];
+        store->layer[i] = store->layer[last];
+        store->sprite[i] = store->sprite[last];
+        store->anim_ids[i] = store->anim_ids[last];
+        store->anim_current[i] = store->anim_current[last];
+        store->anim_frame[i] = store->anim_frame[last];
+        store->anim_time[i] = store->anim_time[last];
+        store->script[i] = store->script[last];
+        store->script_pc[i] = store->script_pc[last];
+        store->script_wait[i] = store->script_wait[last];
+        store->script_wake[i] = store->script_wake[last];
+        store->activity[i] = store->activity[last];
+        store->last_update[i] = store->last_update[last];
+        store->owner[i] = store->owner[last];
+
+        uint32_t moved_slot = store->dense_to_slot[last];
+        store->dense_to_slot[i] = moved_slot;
+        store->slot_to_dense[moved_slot] = i;
+    }
+    store->count--;
+    store->schedule_dirty = true; // Les listes contiennent des indices denses
+
+    // Invalider les handles existants et chaîner le slot dans la liste libre
+    store->generation[handle.slot]++;
+    store->slot_to_dense[handle.slot] = store->free_slot;
+    store->free_slot = handle.slot;
+}
+
+void EntityStore_setHitbox(EntityStore *store, int index, float offsetX, float offsetY, float width, float height)
+{
+    store->hitbox_offset_x[index] = offsetX;
+    store->hitbox_offset_y[index] = offsetY;
+    store->hitbox[index] = (Hitbox){store->x[index] + offsetX, store->y[index] + offsetY, width, height};
+    if (store->spatial)
+        SpatialHash_update(store->spatial, (int)store->dense_to_slot[index] + 1, store->hitbox[index]);
+}
+
+void EntityStore_setSpatialHash(EntityStore *store, SpatialHash *spatial)
+{
+    store->spatial = spatial;
+    for (int i = 0; spatial && i < store->count; i++)
+        SpatialHash_update(spatial, (int)store->dense_to_slot[i] + 1, store->hitbox[i]);
+}
+
+void EntityStore_syncSpatial(EntityStore *store, const int *list, int count)
+{
+    if (!store || !store->spatial)
+        return;
+    for (int k = 0; k < count; k++)
+    {
+        int i = list[k];
+        SpatialHash_update(store->spatial, (int)store->dense_to_slot[i] + 1, store->hitbox[i]);
+    }
+}
+
+void EntityStore_setPosition(EntityStore *store, int index, float x, float y)
+{
+    store->x[index] = x;
+    store->y[index] = y;
+    store->has_target[index] = false;
+    store->moving[index] = false;
+    store->route[index] = NULL;
+    EntityStore_setHitbox(store, index, store->hitbox_offset_x[index], store->hitbox_offset_y[index],
+                          store->hitbox[index].width, store->hitbox[index].height);
+    store->schedule_dirty = true;
+}
+
+void EntityStore_setTarget(EntityStore *store, int index, float x, float y, int direction)
+{
+    store->target_x[index] = x;
+    store->target_y[index] = y;
+    store->has_target[index] = true;
+    store->moving[index] = true;
+    store->blocked_time[index] = 0.0f;
+    store->direction[index] = (uint8_t)direction;
+    if (store->activity[index] == ENTITY_DORMANT)
+        store->schedule_dirty = true;
+}
+
+void EntityStore_setRoute(EntityStore *store, int index, EntityRoute *route)
+{
+    store->route[index] = route;
+    if (!route)
+        return;
+
+    route->index = 0;
+    if (route->count == 0)
+    {
+        store->route[index] = NULL;
+        return;
+    }
+    float dx = route->x[0] - store->x[index];
+    float dy = route->y[0] - store->y[index];
+    int direction = fabsf(dx) > fabsf(dy) ? (dx < 0 ? 0 : 1) : (dy < 0 ? 2 : 3);
+    EntityStore_setTarget(store, index, route->x[0], route->y[0], direction);
+}
+
+// Passe à la cible suivante de l'itinéraire, retourne false s'il est terminé
+static inline bool next_route_target(EntityStore *store, int i)
+{
+    EntityRoute *route = store->route[i];
+    if (!route || ++route->index >= route->count)
+    {
+        store->route[i] = NULL;
+        return false;
+    }
+
+    float dx = route->x[route->index] - store->x[i];
+    float dy = route->y[route->index] - store->y[i];
+    store->target_x[i] = route->x[route->index];
+    store->target_y[i] = route->y[route->index];
+    store->direction[i] = fabsf(dx) > fabsf(dy) ? (dx < 0 ? 0 : 1) : (dy < 0 ? 2 : 3);
+    return true;
+}
+
+// Déplacement vers la cible (identique pour une entité seule ou la boucle complète)
+static inline void step_movement(EntityStore *store, int i, float deltaTime)
+{
+    if (!store->has_target[i])
+    {
+        store->moving[i] = false;
+        return;
+    }
+
+    float dx = store->target_x[i] - store->x[i];
+    float dy = store->target_y[i] - store->y[i];
+    float distance = sqrtf(dx * dx + dy * dy);
+
+    if (distance > 1.0f)
+    {
+        float moveDistance = store->speed[i] * deltaTime;
+        if (moveDistance > distance)
+            moveDistance = distance;
+
+        float newX = store->x[i] + (dx / distance) * moveDistance;
+        float newY = store->y[i] + (dy / distance) * moveDistance;
+
+        // Entités bloquantes : positions de la frame précédente (table figée pendant
+        // la mise à jour parallèle), le résultat ne dépend pas de l'ordre de traitement
+        if (store->spatial)
+        {
+            Hitbox next = store->hitbox[i];
+            next.x = newX + store->hitbox_offset_x[i];
+            next.y = newY + store->hitbox_offset_y[i];
+            if (SpatialHash_blocked(store->spatial, store->hitbox[i], next, (int)store->dense_to_slot[i] + 1))
+            {
+                // Attend que la voie se libère, puis abandonne le déplacement :
+                // deux PNJs face à face ne restent pas bloqués (ni leur routine)
+                store->moving[i] = false;
+                store->blocked_time[i] += deltaTime;
+                if (store->blocked_time[i] >= ENTITY_BLOCKED_TIMEOUT)
+                {
+                    store->has_target[i] = false;
+                    store->route[i] = NULL;
+                }
+                return;
+            }
+        }
+
+        store->blocked_time[i] = 0.0f;
+        store->x[i] = newX;
+        store->y[i] = newY;
+        store->moving[i] = true;
+    }
+    else
+    {
+        store->x[i] = store->target_x[i];
+        store->y[i] = store->target_y[i];
+        if (!next_route_target(store, i))
+        {
+            store->has_target[i] = false;
+            store->moving[i] = false;
+        }
+    }
+
+    // Mise à jour de la hitbox
+    store->hitbox[i].x = store->x[i] + store->hitbox_offset_x[i];
+    store->hitbox[i].y = store->y[i] + store->hitbox_offset_y[i];
+}
+
+// Choix de l'animation selon direction/mouvement puis avancement des frames
+static inline void step_animation(EntityStore *store, int i, Uint32 currentTime)
+{
+    Sprite *sprite = store->sprite[i];
+    if (!sprite)
+        return;
+
+    int dir = store->direction[i];
+    int wanted = store->moving[i] ? store->anim_ids[i].walk[dir] : store->anim_ids[i].idle[dir];
+    if (wanted < 0)
+        return;
+
+    if (wanted != store->anim_current[i])
+    {
+        store->anim_current[i] = (int16_t)wanted;
+        store->anim_frame[i] = 0;
+        store->anim_time[i] = currentTime;
+        return;
+    }
+
+    Animation *anim = &sprite->animations[wanted];
+    int frame = store->anim_frame[i];
+    if (currentTime - store->anim_time[i] >= (Uint32)anim->frames[frame].duration)
+    {
+        frame++;
+        if (frame >= anim->frame_count)
+        {
+            frame = anim->loop ? 0 : anim->frame_count - 1;
+        }
+        store->anim_frame[i] = (int16_t)frame;
+        store->anim_time[i] = currentTime;
+    }
+}
+
+void EntityStore_setScript(EntityStore *store, int index, const Script *script)
+{
+    store->script[index] = script;
+    store->script_pc[index] = 0;
+    store->script_wait[index] = SCRIPT_RUNNING;
+}
+
+// Exécute la routine d'une entité jusqu'à une attente, sa fin ou SCRIPT_MAX_STEPS instructions
+static inline void run_script(EntityStore *store, int i, Uint32 currentTime, const ScriptHost *host)
+{
+    switch (store->script_wait[i])
+    {
+    case SCRIPT_WAIT_MOVE:
+        if (store->has_target[i])
+            return;
+        break;
+    case SCRIPT_WAIT_TIME:
+        if ((int32_t)(currentTime - store->script_wake[i]) < 0)
+            return;
+        break;
+    case SCRIPT_WAIT_PATH:
+        return;
+    }
+    store->script_wait[i] = SCRIPT_RUNNING;
+
+    const Script *script = store->script[i];
+    const uint16_t *code = script->code;
+    int pc = store->script_pc[i];
+
+    for (int steps = 0; steps < SCRIPT_MAX_STEPS; steps++)
+    {
+        switch (code[pc])
+        {
+        case OP_END:
+            store->script[i] = NULL;
+            return;
+
+        case OP_WALK:
+        {
+            static const float dirX[4] = {-1.0f, 1.0f, 0.0f, 0.0f};
+            static const float dirY[4] = {0.0f, 0.0f, -1.0f, 1.0f};
+            int dir = code[pc + 1];
+            float distance = (float)(code[pc + 2] * SCRIPT_TILE_SIZE);
+            if (host && host->cancel_walk)
+                host->cancel_walk(host->user, store->owner[i]);
+            store->route[i] = NULL;
+            EntityStore_setTarget(store, i, store->x[i] + dirX[dir] * distance, store->y[i] + dirY[dir] * distance, dir);
+            store->script_wait[i] = SCRIPT_WAIT_MOVE;
+            store->script_pc[i] = (uint16_t)(pc + 3);
+            return;
+        }
+
+        case OP_WALK_TO:
+            pc += 3;
+            if (host && host->walk_to && host->walk_to(host->user, store->owner[i], code[pc - 2], code[pc - 1]))
+            {
+                store->script_wait[i] = SCRIPT_WAIT_PATH;
+                store->script_pc[i] = (uint16_t)pc;
+                return;
+            }
+            break; // Aucune recherche lancée : instruction ignorée
+
+        case OP_FACE:
+            if (store->direction[i] != code[pc + 1])
+                store->changed = true;
+            store->direction[i] = (uint8_t)code[pc + 1];
+            pc += 2;
+            break;
+
+        case OP_WAIT:
+            store->script_wake[i] = currentTime + code[pc + 1];
+            store->script_wait[i] = SCRIPT_WAIT_TIME;
+            store->script_pc[i] = (uint16_t)(pc + 2);
+            return;
+
+        case OP_SAY:
+            if (host && host->say)
+                host->say(host->user, store->owner[i], script->strings[code[pc + 1]]);
+            pc += 2;
+            break;
+
+        case OP_JUMP:
+            pc = code[pc + 1];
+            break;
+
+        case OP_JUMP_IF:
+        case OP_JUMP_IF_NOT:
+        {
+            int flag = script->flag_ids[code[pc + 1]];
+            bool set = flag >= 0 && host && host->get_flag && host->get_flag(host->user, flag);
+            if (set == (code[pc] == OP_JUMP_IF))
+                pc = code[pc + 2];
+            else
+                pc += 3;
+            break;
+        }
+
+        default:
+            fprintf(stderr, "Script: instruction %d inconnue\n", code[pc]);
+            store->script[i] = NULL;
+            return;
+        }
+    }
+    store->script_pc[i] = (uint16_t)pc; // Reprise au tick suivant (boucle sans attente)
+}
+
+void EntityStore_runScripts(EntityStore *store, const int *list, int count, Uint32 currentTime, const ScriptHost *host)
+{
+    if (!store)
+        return;
+    if (!list)
+        count = store->count;
+    for (int k = 0; k < count; k++)
+    {
+        int i = list ? list[k] : k;
+        if (store->script[i])
+            run_script(store, i, currentTime, host);
+    }
+}
+
+// Une entité hors écran a-t-elle quelque chose à faire ?
+static inline bool is_busy(EntityStore *store, int i, Uint32 currentTime)
+{
+    if (store->has_target[i])
+        return true;
+    if (!store->script[i])
+        return false;
+    if (store->script_wait[i] == SCRIPT_WAIT_TIME)
+        return (int32_t)(currentTime - store->script_wake[i]) >= 0;
+    return true;
+}
+
+static void classify(EntityStore *store, SDL_Rect view, Uint32 currentTime)
+{
+    float left = view.x - ENTITY_WAKE_MARGIN, right = view.x + view.w + ENTITY_WAKE_MARGIN;
+    float top = view.y - ENTITY_WAKE_MARGIN, bottom = view.y + view.h + ENTITY_WAKE_MARGIN;
+
+    store->active_count = 0;
+    store->offscreen_count = 0;
+    for (int i = 0; i < store->count; i++)
+    {
+        bool near = store->x[i] + store->width[i] >= left && store->x[i] <= right &&
+                    store->y[i] + store->height[i] >= top && store->y[i] <= bottom;
+
+        uint8_t activity = near ? ENTITY_ACTIVE : is_busy(store, i, currentTime) ? ENTITY_OFFSCREEN
+                                                                                 : ENTITY_DORMANT;
+        // Au réveil, le temps passé endormi n'est pas rattrapé
+        if (store->activity[i] == ENTITY_DORMANT && activity != ENTITY_DORMANT)
+            store->last_update[i] = currentTime;
+        store->activity[i] = activity;
+
+        if (activity == ENTITY_ACTIVE)
+            store->active_list[store->active_count++] = i;
+        else if (activity == ENTITY_OFFSCREEN)
+            store->offscreen_list[store->offscreen_count++] = i;
+    }
+}
+
+void EntityStore_schedule(EntityStore *store, SDL_Rect view, Uint32 currentTime)
+{
+    if (!store)
+        return;
+
+    if (store->schedule_dirty || store->frame % ENTITY_SCHEDULE_INTERVAL == 0)
+    {
+        classify(store, view, currentTime);
+        store->schedule_dirty = false;
+    }
+
+    // Entités actives, puis une partie des entités hors écran à tour de rôle
+    store->tick_count = 0;
+    for (int k = 0; k < store->active_count; k++)
+        store->tick_list[store->tick_count++] = store->active_list[k];
+    for (int k = store->frame % ENTITY_OFFSCREEN_INTERVAL; k < store->offscreen_count; k += ENTITY_OFFSCREEN_INTERVAL)
+        store->tick_list[store->tick_count++] = store->offscreen_list[k];
+
+    store->frame++;
+}
+
+void EntityStore_updateList(EntityStore *store, const int *list, int begin, int end, Uint32 currentTime)
+{
+    for (int k = begin; k < end; k++)
+    {
+        int i = list[k];
+        float deltaTime = (currentTime - store->last_update[i]) / 1000.0f;
+        store->last_update[i] = currentTime;
+        step_movement(store, i, deltaTime);
+        step_animation(store, i, currentTime);
+    }
+}
+
+void EntityStore_queue(EntityStore *store, RenderQueue *queue, Camera *camera)
+{
+    if (!store || !queue || !camera)
+        return;
+
+    SDL_Rect view = camera->view_rect;
+    for (int i = 0; i < store->count; i++)
+    {
+        if (!store->visible[i] || !store->sprite[i])
+            continue;
+
+        // Hors de la vue : rien à dessiner
+        if (store->x[i] + store->width[i] < view.x || store->x[i] > view.x + view.w ||
+            store->y[i] + store->height[i] < view.y || store->y[i] > view.y + view.h)
+            continue;
+
+        SDL_Rect src;
+        if (!getFrameRect(store->sprite[i], store->anim_current[i], store->anim_frame[i], &src))
+            continue;
+
+        SDL_Rect screen_rect = getScreenRect(camera, store->x[i], store->y[i], store->width[i], store->height[i]);
+        SDL_Rect dst = {screen_rect.x, screen_rect.y, src.w, src.h};
+        RenderQueue_push(queue, store->sprite[i]->texture, &src, &dst, SDL_FLIP_NONE, 0.0,
+                         store->layer[i], store->y[i] + store->height[i]);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,172 @@
+#ifndef ENTITY_STORE_H
+#define ENTITY_STORE_H
+
+#include "entity.h"
+#include <stdint.h>
+#include <stdbool.h>
+#include <SDL2/SDL.h>
+#include "../systems/camera.h"
+#include "../systems/render_queue.h"
+#include "script.h"
+#include "spatial_hash.h"
+
+// Handle générationnel : il devient invalide quand l'entité est détruite,
+// même si son emplacement est réutilisé par une nouvelle entité
+typedef struct
+{
+    uint32_t slot;
+    uint32_t generation;
+} EntityHandle;
+
+#define ENTITY_HANDLE_NULL ((EntityHandle){UINT32_MAX, 0})
+
+// Index des animations (dans le Sprite) à jouer selon la direction, résolus à la création
+typedef struct
+{
+    int16_t idle[4]; // [gauche, droite, haut, bas]
+    int16_t walk[4];
+} EntityAnimIds;
+
+// Suite de cibles (positions monde) suivie automatiquement par l'entité,
+// remplie par exemple à partir d'un chemin calculé par le Pathfinder
+#define ENTITY_ROUTE_MAX 64
+
+typedef struct
+{
+    int count;
+    int index; // Prochaine cible
+    float x[ENTITY_ROUTE_MAX];
+    float y[ENTITY_ROUTE_MAX];
+} EntityRoute;
+
+// Attente d'une routine de comportement
+typedef enum
+{
+    SCRIPT_RUNNING,
+    SCRIPT_WAIT_MOVE, // Fin du déplacement en cours
+    SCRIPT_WAIT_TIME, // Jusqu'à script_wake
+    SCRIPT_WAIT_PATH  // Recherche de chemin en cours (levée par le propriétaire)
+} ScriptWait;
+
+// Ordonnancement des mises à jour selon la distance à la caméra
+#define ENTITY_WAKE_MARGIN 64         // Marge (px) autour de la vue : les entités proches restent actives
+#define ENTITY_OFFSCREEN_INTERVAL 4   // Hors écran et occupée : une mise à jour toutes les N frames
+#define ENTITY_SCHEDULE_INTERVAL 8    // Reclassement des entités toutes les N frames
+#define ENTITY_BLOCKED_TIMEOUT 2.0f   // Secondes d'attente d'une voie bloquée avant d'abandonner la cible
+
+typedef enum
+{
+    ENTITY_DORMANT,   // Hors écran et inactive : pas mise à jour jusqu'au réveil
+    ENTITY_OFFSCREEN, // Hors écran mais en mouvement ou en routine : fréquence réduite
+    ENTITY_ACTIVE     // Près de la vue : mise à jour à chaque frame
+} EntityActivity;
+
+// Stockage des entités en tableaux séparés (SoA). Les données sont compactes :
+// les entités vivantes occupent les indices [0, count[ et les boucles de mise à jour
+// et de rendu les parcourent linéairement. La suppression déplace la dernière entité
+// dans le trou, les handles passent par slot_to_dense pour rester valides.
+typedef struct
+{
+    int count;
+    int capacity;
+
+    // Position et taille
+    float *x, *y;
+    float *width, *height;
+
+    // Hitbox (monde) et son décalage par rapport à la position
+    Hitbox *hitbox;
+    float *hitbox_offset_x, *hitbox_offset_y;
+
+    // Déplacement vers une cible
+    float *target_x, *target_y;
+    float *speed;
+    uint8_t *has_target;
+    uint8_t *moving;
+    uint8_t *direction; // 0=gauche, 1=droite, 2=haut, 3=bas
+    EntityRoute **route; // Itinéraire en cours (détenu par le propriétaire), NULL sinon
+    float *blocked_time; // Temps passé bloqué par une autre entité (s) ; la cible est abandonnée à ENTITY_BLOCKED_TIMEOUT
+
+    // Rendu et animation (l'état d'animation n'est pas stocké dans le Sprite)
+    uint8_t *visible;
+    int *layer;
+    Sprite **sprite;
+    EntityAnimIds *anim_ids;
+    int16_t *anim_current;
+    int16_t *anim_frame;
+    Uint32 *anim_time;
+
+    // Routine de comportement (machine virtuelle)
+    const Script **script; // NULL : pas de routine ou routine terminée
+    uint16_t *script_pc;
+    uint8_t *script_wait;
+    Uint32 *script_wake;
+
+    // Ordonnancement
+    uint8_t *activity;
+    Uint32 *last_update; // Temps de la dernière mise à jour (le delta en découle)
+
+    void **owner;            // Données froides associées (PNJ *, ...)
+    uint32_t *dense_to_slot; // Indice dense -> slot du handle
+
+    // Slots : handle -> indice dense
+    uint32_t *slot_to_dense; // Pour un slot libre : slot libre suivant
+    uint32_t *generation;
+    int slot_count;
+    uint32_t free_slot;
+
+    // Listes d'indices denses reconstruites par EntityStore_schedule
+    int *active_list;
+    int active_count;
+    int *offscreen_list;
+    int offscreen_count;
+    int *tick_list; // Entités à mettre à jour pendant cette frame
+    int tick_count;
+    uint32_t frame;
+    bool schedule_dirty; // Entité ajoutée, supprimée ou réveillée : reclassement à la frame suivante
+    bool changed;        // Une entité a bougé ou tourné (sauvegarde), remis à false par le propriétaire
+
+    SpatialHash *spatial; // Hitbox des entités bloquantes (identifiant = slot + 1), NULL : aucune collision
+} EntityStore;
+
+EntityStore *EntityStore_create(int capacity);
+void EntityStore_free(EntityStore *store);
+
+// Ajoute une entité, retourne ENTITY_HANDLE_NULL en cas d'échec
+EntityHandle EntityStore_spawn(EntityStore *store, float x, float y, float width, float height, Sprite *sprite, int layer, void *owner);
+void EntityStore_destroy(EntityStore *store, EntityHandle handle);
+
+// Indice dense de l'entité, -1 si le handle n'est plus valide
+int EntityStore_indexOf(EntityStore *store, EntityHandle handle);
+
+void EntityStore_setHitbox(EntityStore *store, int index, float offsetX, float offsetY, float width, float height);
+
+// Collisions entre entités : la table est consultée pendant le mouvement (lecture
+// seule, donc sûre en parallèle) et mise à jour ensuite par EntityStore_syncSpatial
+void EntityStore_setSpatialHash(EntityStore *store, SpatialHash *spatial);
+void EntityStore_syncSpatial(EntityStore *store, const int *list, int count);
+// Téléporte l'entité (annule cible et itinéraire)
+void EntityStore_setPosition(EntityStore *store, int index, float x, float y);
+void EntityStore_setTarget(EntityStore *store, int index, float x, float y, int direction);
+// Suit les cibles de 'route' à partir de la première ; NULL arrête l'itinéraire en cours
+void EntityStore_setRoute(EntityStore *store, int index, EntityRoute *route);
+
+// Démarre une routine au début (NULL l'arrête)
+void EntityStore_setScript(EntityStore *store, int index, const Script *script);
+// Exécute les routines jusqu'à leur prochaine attente (thread principal)
+// 'list' : indices des entités concernées, NULL pour toutes
+void EntityStore_runScripts(EntityStore *store, const int *list, int count, Uint32 currentTime, const ScriptHost *host);
+
+// Classe les entités (actives, hors écran, endormies) par rapport à la vue et
+// prépare tick_list. Une entité endormie est réveillée quand elle s'approche de la
+// vue, quand l'attente de sa routine se termine ou quand elle reçoit une cible.
+void EntityStore_schedule(EntityStore *store, SDL_Rect view, Uint32 currentTime);
+// Met à jour les entités list[begin..end[ avec le temps écoulé depuis leur dernière
+// mise à jour ; chaque entité n'écrit que dans ses propres cases, des intervalles
+// disjoints peuvent tourner en parallèle
+void EntityStore_updateList(EntityStore *store, const int *list, int begin, int end, Uint32 currentTime);
+
+// Dépose les entités visibles à l'écran dans la file de rendu triée
+void EntityStore_queue(EntityStore *store, RenderQueue *queue, Camera *camera);
+
+#endif
@@ -0,0 +1,217 @@
+#include "flags.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static unsigned hash_name(const char *name)
+{
+    unsigned h = 2166136261u;
+    for (; *name; name++)
+        h = (h ^ (unsigned char)*name) * 16777619u;
+    return h;
+}
+
+static int words_for(int count)
+{
+    return (count + 63) / 64;
+}
+
+// Agrandit les tableaux par flag et reconstruit la table des noms
+static bool grow_flags(FlagStore *flags, int capacity)
+{
+    int old_words = words_for(flags->capacity);
+    int words = words_for(capacity);
+    uint64_t *bits = realloc(flags->bits, words * sizeof(uint64_t));
+    if (!bits)
+        return false;
+    flags->bits = bits;
+    memset(bits + old_words, 0, (words - old_words) * sizeof(uint64_t));
+
+    char **names = realloc(flags->names, capacity * sizeof(char *));
+    if (!names)
+        return false;
+    flags->names = names;
+
+    int *first = realloc(flags->first_sub, capacity * sizeof(int));
+    if (!first)
+        return false;
+    flags->first_sub = first;
+    for (int i = flags->capacity; i < capacity; i++)
+        first[i] = -1;
+
+    // Table des noms deux fois plus grande que le nombre de flags
+    int slot_count = 16;
+    while (slot_count < capacity * 2)
+        slot_count *= 2;
+    int *slots = calloc(slot_count, sizeof(int));
+    if (!slots)
+        return false;
+    for (int i = 0; i < flags->count; i++)
+    {
+        unsigned s = hash_name(names[i]) & (slot_count - 1);
+        while (slots[s])
+            s = (s + 1) & (slot_count - 1);
+        slots[s] = i + 1;
+    }
+    free(flags->slots);
+    flags->slots = slots;
+    flags->slot_mask = slot_count - 1;
+    flags->capacity = capacity;
+    return true;
+}
+
+FlagStore *FlagStore_create(int capacity)
+{
+    FlagStore *flags = calloc(1, sizeof(FlagStore));
+    if (!flags)
+        return NULL;
+    flags->free_sub = -1;
+    flags->any_sub = -1;
+    if (!grow_flags(flags, capacity > 0 ? capacity : 64))
+    {
+        fprintf(stderr, "Erreur d'allocation mémoire pour les flags.\n");
+        FlagStore_free(flags);
+        return NULL;
+    }
+    return flags;
+}
+
+void FlagStore_free(FlagStore *flags)
+{
+    if (!flags)
+        return;
+    for (int i = 0; i < flags->count; i++)
+        free(flags->names[i]);
+    free(flags->names);
+    free(flags->bits);
+    free(flags->slots);
+    free(flags->first_sub);
+    free(flags->subs);
+    free(flags);
+}
+
+int FlagStore_find(const FlagStore *flags, const char *name)
+{
+    if (!flags || !name)
+        return FLAG_NONE;
+    for (unsigned s = hash_name(name) & flags->slot_mask; flags->slots[s]; s = (s + 1) & flags->slot_mask)
+    {
+        int i = flags->slots[s] - 1;
+        if (strcmp(flags->names[i], name) == 0)
+            return i;
+    }
+    return FLAG_NONE;
+}
+
+int FlagStore_index(FlagStore *flags, const char *name)
+{
+    int i = FlagStore_find(flags, name);
+    if (i != FLAG_NONE || !flags || !name)
+        return i;
+
+    if (flags->count >= flags->capacity && !grow_flags(flags, flags->capacity * 2))
+    {
+        fprintf(stderr, "Erreur d'allocation mémoire pour le flag %s\n", name);
+        return FLAG_NONE;
+    }
+    char *copy = strdup(name);
+    if (!copy)
+        return FLAG_NONE;
+
+    i = flags->count++;
+    flags->names[i] = copy;
+    unsigned s = hash_name(name) & flags->slot_mask;
+    while (flags->slots[s])
+        s = (s + 1) & flags->slot_mask;
+    flags->slots[s] = i + 1;
+    return i;
+}
+
+const char *FlagStore_name(const FlagStore *flags, int flag)
+{
+    if (!flags || flag < 0 || flag >= flags->count)
+        return NULL;
+    return flags->names[flag];
+}
+
+static void notify(FlagStore *flags, int first, int flag, bool value)
+{
+    // 'next' est lu avant l'appel : un abonné peut se désabonner pendant la notification
+    for (int s = first; s >= 0;)
+    {
+        FlagSubscription *sub = &flags->subs[s];
+        int next = sub->next;
+        if (sub->callback)
+            sub->callback(sub->user, flag, value);
+        s = next;
+    }
+}
+
+void FlagStore_set(FlagStore *flags, int flag, bool value)
+{
+    if (!flags || flag < 0 || flag >= flags->count || FlagStore_get(flags, flag) == value)
+        return;
+
+    uint64_t mask = (uint64_t)1 << (flag & 63);
+    if (value)
+        flags->bits[flag >> 6] |= mask;
+    else
+        flags->bits[flag >> 6] &= ~mask;
+
+    notify(flags, flags->first_sub[flag], flag, value);
+    notify(flags, flags->any_sub, flag, value);
+}
+
+int FlagStore_subscribe(FlagStore *flags, int flag, FlagCallback callback, void *user)
+{
+    if (!flags || !callback || flag < FLAG_ANY || flag >= flags->count)
+        return -1;
+
+    int s = flags->free_sub;
+    if (s >= 0)
+    {
+        flags->free_sub = flags->subs[s].next;
+    }
+    else
+    {
+        if (flags->sub_count >= flags->sub_capacity)
+        {
+            int capacity = flags->sub_capacity ? flags->sub_capacity * 2 : 32;
+            FlagSubscription *subs = realloc(flags->subs, capacity * sizeof(FlagSubscription));
+            if (!subs)
+                return -1;
+            flags->subs = subs;
+            flags->sub_capacity = capacity;
+        }
+        s = flags->sub_count++;
+    }
+
+    int *head = flag == FLAG_ANY ? &flags->any_sub : &flags->first_sub[flag];
+    flags->subs[s] = (FlagSubscription){flag, callback, user, *head};
+    *head = s;
+    return s;
+}
+
+void FlagStore_unsubscribe(FlagStore *flags, int subscription)
+{
+    if (!flags || subscription < 0 || subscription >= flags->sub_count || !flags->subs[subscription].callback)
+        return;
+
+    FlagSubscription *sub = &flags->subs[subscription];
+    int *link = sub->flag == FLAG_ANY ? &flags->any_sub : &flags->first_sub[sub->flag];
+    while (*link >= 0 && *link != subscription)
+        link = &flags->subs[*link].next;
+    if (*link == subscription)
+        *link = sub->next;
+
+    // Les abonnements libres ont un callback NULL : une notification en cours les saute
+    sub->callback = NULL;
+    sub->flag = FLAG_NONE;
+    sub->next = flags->free_sub;
+    flags->free_sub = subscription;
+}
+
+int FlagStore_wordCount(const FlagStore *flags)
+{
+    return flags ? words_for(flags->count) : 0;
+}
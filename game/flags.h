@@ -0,0 +1,70 @@
+#ifndef FLAGS_H
+#define FLAGS_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Flags de progression (booléens du scénario). Les noms ne servent qu'au chargement :
+// scripts, téléporteurs et quêtes les résolvent une fois en indices, puis lisent
+// et écrivent un bitset compact. Les systèmes intéressés s'abonnent aux changements
+// d'un flag (ou de tous) au lieu de les relire à chaque frame.
+
+#define FLAG_NONE -1
+#define FLAG_ANY -1 // Abonnement à tous les flags
+
+// 'flag' : indice du flag modifié, 'value' : nouvelle valeur
+typedef void (*FlagCallback)(void *user, int flag, bool value);
+
+typedef struct
+{
+    int flag; // FLAG_ANY ou indice
+    FlagCallback callback;
+    void *user;
+    int next; // Abonnement suivant du même flag, -1 en fin de liste
+} FlagSubscription;
+
+typedef struct
+{
+    uint64_t *bits;
+    char **names; // Indice -> nom
+    int count;
+    int capacity;
+
+    // Nom -> indice (adressage ouvert, 'slots' contient indice + 1, 0 : vide)
+    int *slots;
+    int slot_mask;
+
+    FlagSubscription *subs;
+    int sub_count, sub_capacity;
+    int free_sub;      // Abonnements libérés chaînés par 'next', -1 si aucun
+    int *first_sub;    // Par flag : premier abonnement, -1 si aucun
+    int any_sub;       // Abonnements à FLAG_ANY
+} FlagStore;
+
+FlagStore *FlagStore_create(int capacity);
+void FlagStore_free(FlagStore *flags);
+
+// Indice d'un flag, créé (à faux) s'il n'existe pas ; FLAG_NONE si la mémoire manque
+int FlagStore_index(FlagStore *flags, const char *name);
+// Indice d'un flag existant, FLAG_NONE sinon
+int FlagStore_find(const FlagStore *flags, const char *name);
+const char *FlagStore_name(const FlagStore *flags, int flag);
+
+static inline bool FlagStore_get(const FlagStore *flags, int flag)
+{
+    if (!flags || flag < 0 || flag >= flags->count)
+        return false;
+    return (flags->bits[flag >> 6] >> (flag & 63)) & 1u;
+}
+
+// Modifie un flag et prévient ses abonnés s'il change
+void FlagStore_set(FlagStore *flags, int flag, bool value);
+
+// Retourne un identifiant d'abonnement (pour FlagStore_unsubscribe), -1 en cas d'erreur
+int FlagStore_subscribe(FlagStore *flags, int flag, FlagCallback callback, void *user);
+void FlagStore_unsubscribe(FlagStore *flags, int subscription);
+
+// Nombre de mots de 64 bits du bitset
+int FlagStore_wordCount(const FlagStore *flags);
+
+#endif
@@ -1,9 +1,14 @@
 #include "game.h"
 
 static Map *Game_LoadAndInitMap(const char *name, SDL_Renderer *renderer);
+static const char *Game_MapProperty(Game *game, const char *name);
 static bool Game_HandleInputEvents(Game *game, SDL_Event *event);
-static void Game_UpdateData(Game *game, float deltaTime);
-static void Game_UpdateGraphics(Game *game, Uint32 currentTime);
+static void Game_UpdateData(Game *game, float deltaTime, Uint32 currentTime);
+static void Game_UpdateGraphics(Game *game);
+static void Game_UpdateCombat(Game *game);
+static void Game_Interact(Game *game, Hitbox feet, int tileW, int tileH);
+static void Game_ClampCamera(Game *game);
+static void Game_RenderCombat(Game *game);
 
 bool Game_InitSDL(Game *game, const char *title, int width, int height)
 {
@@ -29,6 +34,9 @@ bool Game_InitSDL(Game *game, const char *title, int width, int height)
         return false;
     }
 
+    // Regroupe les SDL_RenderCopy consécutifs sur une même texture
+    SDL_SetHint(SDL_HINT_RENDER_BATCHING, "1");
+
     game->renderer = SDL_CreateRenderer(game->window, -1, SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC);
     if (!game->renderer)
     {
@@ -45,6 +53,117 @@ bool Game_InitSDL(Game *game, const char *title, int width, int height)
     return true;
 }
 
+// Flags des routines de PNJs : noms résolus une fois au chargement, puis lus par indice
+static int Game_resolveFlag(void *user, const char *name)
+{
+    return FlagStore_index(((Game *)user)->flags, name);
+}
+
+static bool Game_getFlag(void *user, int flag)
+{
+    return FlagStore_get(((Game *)user)->flags, flag);
+}
+
+// Réplique "say" d'une routine : affichée si aucune autre boîte n'est ouverte
+static void Game_say(void *user, void *owner, const char *text)
+{
+    Game *game = user;
+    if (game->dialogue.open)
+        return;
+
+    const PNJ *pnj = owner;
+    const char *name = pnj && pnj->name ? pnj->name : NULL;
+    if (name && strncmp(name, "PNJ_", 4) == 0)
+        name += 4;
+
+    char line[DIALOGUE_TEXT_MAX];
+    if (name)
+        snprintf(line, sizeof(line), "%s : %s", name, text);
+    else
+        snprintf(line, sizeof(line), "%s", text);
+    DialogueBox_open(&game->dialogue, line);
+}
+
+// Objets des étapes "own" des quêtes
+static int Game_resolveItem(void *user, const char *name)
+{
+    const ItemData *item = Item_find(name);
+    return item ? item->id : -1;
+}
+
+static int Game_itemCount(void *user, int item)
+{
+    return Inventory_count(((Game *)user)->inventory, (uint16_t)item);
+}
+
+static void Game_itemChanged(void *user, uint16_t item, int count)
+{
+    Game *game = user;
+    QuestManager_emitItem(game->quests, item, count);
+    SaveManager_markDirty(game->save, SAVE_SECTION_INVENTORY);
+}
+
+bool Game_InitInventory(Game *game)
+{
+    game->inventory = Inventory_create();
+    if (!game->inventory)
+        return false;
+
+    // Objets de départ
+    const ItemData *ball = Item_find("Poké Ball");
+    const ItemData *potion = Item_find("Potion");
+    if (ball)
+        Inventory_add(game->inventory, ball->id, 5);
+    if (potion)
+        Inventory_add(game->inventory, potion->id, 2);
+    Inventory_setCallback(game->inventory, Game_itemChanged, game);
+    return true;
+}
+
+// Annonce à la suite du dialogue ouvert (la quête se termine souvent en parlant à un PNJ)
+static void Game_questCompleted(void *user, const Quest *quest)
+{
+    Game *game = user;
+    char line[DIALOGUE_TEXT_MAX];
+    if (game->dialogue.open)
+        snprintf(line, sizeof(line), "%s\nQuête terminée : %s", game->dialogue.text, quest->title);
+    else
+        snprintf(line, sizeof(line), "Quête terminée : %s", quest->title);
+    DialogueBox_open(&game->dialogue, line);
+}
+
+// Propriété texte de la carte courante (météo, musiques), NULL si absente
+static const char *Game_MapProperty(Game *game, const char *name)
+{
+    if (!game->current_map)
+        return NULL;
+    tmx_property *property = tmx_get_property(game->current_map->tmx_map->properties, name);
+    return property && property->type == PT_STRING ? property->value.string : NULL;
+}
+
+// Branche la carte courante sur les systèmes du jeu (threads, scripts, météo, musique)
+static void Game_AttachMap(Game *game)
+{
+    Map_setJobSystem(game->current_map, game->jobs);
+    ScriptHost host = {game, Game_resolveFlag, Game_getFlag, Game_say, NULL, NULL}; // Déplacements : ceux de la carte
+    Map_setScriptHost(game->current_map, &host);
+    Map_seedEncounters(game->current_map, (uint64_t)time(NULL));
+
+    // Météo de la carte : propriété "weather" (clear, rain, snow), beau temps par défaut
+    const char *weather = Game_MapProperty(game, "weather");
+    int type = weather ? Weather_parse(weather) : WEATHER_CLEAR;
+    if (type < 0)
+    {
+        fprintf(stderr, "Météo inconnue sur la carte %s : %s\n", game->map_name, weather);
+        type = WEATHER_CLEAR;
+    }
+    Weather_setType(game->weather, type);
+
+    // Rechargement à chaud pendant un combat : la musique de combat continue
+    if (game->state == MODE_WORLD)
+        AudioManager_playMusic(game->audio, Game_MapProperty(game, "music"), GAME_MUSIC_FADE_MS);
+}
+
 bool Game_InitMap(Game *game, const char *map_name)
 {
     game->current_map = Game_LoadAndInitMap(map_name, game->renderer);
@@ -53,6 +172,50 @@ bool Game_InitMap(Game *game, const char *map_name)
         fprintf(stderr, "Failed to load and initialize map '%s'\n", map_name);
         return false;
     }
+    snprintf(game->map_name, sizeof(game->map_name), "%s", map_name);
+    Game_AttachMap(game);
+    return true;
+}
+
+bool Game_ReloadMap(Game *game)
+{
+    // Nouvelle carte chargée avant de libérer l'ancienne : en cas d'erreur, on la garde
+    Map *map = Game_LoadAndInitMap(game->map_name, game->renderer);
+    if (!map)
+    {
+        fprintf(stderr, "Rechargement de la carte '%s' impossible, ancienne carte conservée\n", game->map_name);
+        return false;
+    }
+
+    // Le PNJ de test vit dans l'EntityStore de l'ancienne carte
+    if (game->testPNJ)
+    {
+        freePNJ(game->testPNJ);
+        game->testPNJ = NULL;
+    }
+    freeMap(game->current_map);
+    game->current_map = map;
+    // freeMap vide la table (globale) des tuiles animées : reconstruite pour la nouvelle carte
+    Map_initAnimations(map);
+    Game_AttachMap(game);
+    Game_InitPNJs(game);
+
+    // Le joueur reste où il est ; la caméra suit les nouvelles dimensions de la carte
+    Camera *camera = game->camera;
+    if (Game_InitCamera(game))
+    {
+        game->camera->view_rect = camera->view_rect;
+        freeCamera(camera);
+    }
+    else
+    {
+        game->camera = camera;
+    }
+    Map_updatePlayerHitbox(map, game->player->entity.hitbox);
+
+    // Les PNJs repartent de leur position dans le TMX
+    SaveManager_markDirty(game->save, SAVE_SECTION_PNJS);
+    printf("Carte '%s' rechargée\n", game->map_name);
     return true;
 }
 
@@ -100,9 +263,9 @@ bool Game_InitPlayer(Game *game)
 
 bool Game_InitCamera(Game *game)
 {
-    game->camera = initCamera(0, 0, game->window_width, game->window_height,
-                              game->current_map->tmx_map->width * game->current_map->tmx_map->tile_width,
-                              game->current_map->tmx_map->height * game->current_map->tmx_map->tile_height);
+    SDL_Rect bounds;
+    Map_getPixelBounds(game->current_map, &bounds);
+    game->camera = initCamera(0, 0, game->window_width, game->window_height, bounds.x + bounds.w, bounds.y + bounds.h);
     if (!game->camera)
     {
         fprintf(stderr, "Error creating camera\n");
@@ -113,7 +276,8 @@ bool Game_InitCamera(Game *game)
 
 bool Game_InitPNJs(Game *game)
 {
-    game->testPNJ = createPNJ(100, 100, "resources/sprites/pnj.png", game->renderer);
+    // Le PNJ de test vit dans l'EntityStore de la carte : mis à jour et dessiné avec les autres
+    game->testPNJ = createPNJ(game->current_map->entities, NULL, 100, 100, GAME_TEST_PNJ_SPRITE, game->renderer);
     if (!game->testPNJ)
     {
         fprintf(stderr, "Error creating PNJ\n");
@@ -122,6 +286,45 @@ bool Game_InitPNJs(Game *game)
     return true;
 }
 
+bool Game_InitTeam(Game *game)
+{
+    game->team_count = 0;
+    if (!BattlePokemon_init(&game->team[0], GAME_STARTER_SPECIES, GAME_STARTER_LEVEL))
+    {
+        fprintf(stderr, "Pokémon de départ introuvable (espèce %d)\n", GAME_STARTER_SPECIES);
+        return false;
+    }
+    game->team_count = 1;
+    return true;
+}
+
+bool Game_StartWildBattle(Game *game, const Encounter *encounter)
+{
+    const SpeciesData *species = Species_find(encounter->species);
+    BattlePokemon wild;
+    if (!species || !BattlePokemon_init(&wild, species->id, encounter->level))
+    {
+        fprintf(stderr, "Rencontre ignorée : espèce inconnue %s\n", encounter->species);
+        return false;
+    }
+    if (game->team_count == 0 || game->team[0].hp <= 0)
+        return false;
+
+    uint64_t seed = ((uint64_t)Random_next(&game->rng) << 32) | Random_next(&game->rng);
+    Battle_init(&game->battle, &game->team[0], &wild, seed);
+    game->battle_input_ready = false;
+    game->state = MODE_COMBAT;
+    Game_BuildBattleHud(game);
+    // Musique de combat de la carte (propriété "battle_music"), sinon celle de la carte continue
+    const char *music = Game_MapProperty(game, "battle_music");
+    if (music)
+        AudioManager_playMusic(game->audio, music, GAME_MUSIC_FADE_MS / 2);
+    char line[96];
+    snprintf(line, sizeof(line), "Un %s sauvage (niveau %d) apparaît !", Species_name(species), wild.level);
+    DialogueBox_open(&game->dialogue, line);
+    return true;
+}
+
 Game *Game_Create(const char *title, int width, int height)
 {
     Game *game = (Game *)malloc(sizeof(Game));
@@ -142,6 +345,77 @@ Game *Game_Create(const char *title, int width, int height)
         return NULL;
     }
 
+    game->font = Font_createDefault(game->renderer, 1);
+    game->text = game->font ? TextCache_create(game->font) : NULL;
+    game->ui = game->text ? UI_create(game->renderer, game->text, width, height) : NULL;
+    if (!game->ui)
+    {
+        Game_Free(game);
+        return NULL;
+    }
+    DialogueBox_init(&game->dialogue, width, height);
+
+    // Le monde est dessiné dans sa texture, puis teinté d'un coup selon l'heure
+    game->world_target = SDL_CreateTexture(game->renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, width, height);
+    game->weather = Weather_create(width, height, (uint64_t)time(NULL));
+    if (!game->world_target || !game->weather)
+    {
+        fprintf(stderr, "Erreur lors de la création de l'ambiance du monde : %s\n", SDL_GetError());
+        Game_Free(game);
+        return NULL;
+    }
+    game->day_time = GAME_START_TIME;
+    game->audio = AudioManager_create(); // Facultatif
+    AudioManager_setVolumes(game->audio, GAME_MUSIC_VOLUME, GAME_SOUND_VOLUME);
+    game->sound_select = AudioManager_loadSound(game->audio, GAME_SOUND_SELECT);
+
+    // Espèces et attaques (projetées en mémoire, pas de chargement à proprement parler)
+    if (!Database_load(DATABASE_PATH))
+    {
+        fprintf(stderr, "Pokédex indisponible (make %s)\n", DATABASE_PATH);
+    }
+    Game_InitTeam(game);
+    if (!Game_InitInventory(game))
+    {
+        Game_Free(game);
+        return NULL;
+    }
+    Random_seed(&game->rng, (uint64_t)time(NULL));
+
+    // Avant la carte : son pathfinder y confie ses recherches
+    game->jobs = JobSystem_create(0);
+    if (!game->jobs)
+    {
+        Game_Free(game);
+        return NULL;
+    }
+
+    // Avant la carte : ses routines y résolvent leurs flags
+    game->flags = FlagStore_create(64);
+    if (!game->flags)
+    {
+        Game_Free(game);
+        return NULL;
+    }
+
+    // Étapes "win" : le Pokédex est déjà chargé
+    QuestHost quest_host = {game, Game_resolveItem, Game_itemCount};
+    game->quests = QuestManager_create(game->flags, &quest_host);
+    if (!game->quests)
+    {
+        Game_Free(game);
+        return NULL;
+    }
+    QuestManager_setCallback(game->quests, Game_questCompleted, game);
+    QuestManager_load(game->quests, QUEST_PATH);
+
+    // Feuilles du joueur et du PNJ de test décodées avec les images de la carte,
+    // en parallèle sur les threads de travail
+    game->resources = ResourceManifest_create(game->jobs);
+    addPlayerResources(game->resources);
+    ResourceManifest_add(game->resources, GAME_TEST_PNJ_SPRITE);
+    Resources_setActive(game->resources);
+
     if (!Game_InitMap(game, "map3"))
     {
         Game_Free(game);
@@ -164,6 +438,26 @@ Game *Game_Create(const char *title, int width, int height)
     {
     }
 
+    // Textures créées : les surfaces décodées ne servent plus
+    ResourceManifest_free(game->resources);
+    game->resources = NULL;
+
+    if (!Game_InitSave(game))
+    {
+        Game_Free(game);
+        return NULL;
+    }
+
+    // Sans surveillance des fichiers, le jeu fonctionne sans rechargement à chaud
+    Game_InitHotReload(game);
+
+    game->render_queue = RenderQueue_create(256);
+    if (!game->render_queue)
+    {
+        Game_Free(game);
+        return NULL;
+    }
+
     game->input = (Input){false, false, false, false, false, false};
     game->lastTime = SDL_GetTicks();
 
@@ -174,11 +468,43 @@ void Game_Free(Game *game)
 {
     if (game)
     {
+        // Termine l'écriture en cours (utilise le JobSystem)
+        if (game->save)
+        {
+            SaveManager_free(game->save);
+            game->save = NULL;
+        }
+        // Libéré avant la carte qui possède son EntityStore
+        if (game->testPNJ)
+        {
+            freePNJ(game->testPNJ);
+            game->testPNJ = NULL;
+        }
         if (game->current_map)
         {
             freeMap(game->current_map);
             game->current_map = NULL;
         }
+        if (game->quests)
+        {
+            QuestManager_free(game->quests);
+            game->quests = NULL;
+        }
+        if (game->inventory)
+        {
+            Inventory_free(game->inventory);
+            game->inventory = NULL;
+        }
+        if (game->flags)
+        {
+            FlagStore_free(game->flags);
+            game->flags = NULL;
+        }
+        if (game->jobs)
+        {
+            JobSystem_free(game->jobs);
+            game->jobs = NULL;
+        }
         if (game->player)
         {
             freePlayer(game->player);
@@ -189,10 +515,50 @@ void Game_Free(Game *game)
             freeCamera(game->camera);
             game->camera = NULL;
         }
-        if (game->testPNJ)
+        if (game->render_queue)
         {
-            freePNJ(game->testPNJ);
-            game->testPNJ = NULL;
+            RenderQueue_free(game->render_queue);
+            game->render_queue = NULL;
+        }
+        if (game->resources)
+        {
+            ResourceManifest_free(game->resources);
+            game->resources = NULL;
+        }
+        if (game->watcher)
+        {
+            FileWatcher_free(game->watcher);
+            game->watcher = NULL;
+        }
+        if (game->audio)
+        {
+            AudioManager_free(game->audio);
+            game->audio = NULL;
+        }
+        if (game->weather)
+        {
+            Weather_free(game->weather);
+            game->weather = NULL;
+        }
+        if (game->world_target)
+        {
+            SDL_DestroyTexture(game->world_target);
+            game->world_target = NULL;
+        }
+        if (game->ui)
+        {
+            UI_free(game->ui);
+            game->ui = NULL;
+        }
+        if (game->text)
+        {
+            TextCache_free(game->text);
+            game->text = NULL;
+        }
+        if (game->font)
+        {
+            Font_free(game->font);
+            game->font = NULL;
         }
         if (game->renderer)
         {
@@ -204,6 +570,7 @@ void Game_Free(Game *game)
             SDL_DestroyWindow(game->window);
             game->window = NULL;
         }
+        Database_unload();
         IMG_Quit();
         SDL_Quit();
         free(game);
@@ -214,6 +581,7 @@ static bool Game_HandleInputEvents(Game *game, SDL_Event *event)
 {
     game->input.space = false;
     game->input.r_key = false;
+    game->interact = false;
 
     while (SDL_PollEvent(event))
     {
@@ -222,9 +590,62 @@ static bool Game_HandleInputEvents(Game *game, SDL_Event *event)
             return false;
         }
 
-        if (event->type == SDL_KEYDOWN)
+        if (event->type == SDL_RENDER_TARGETS_RESET || event->type == SDL_RENDER_DEVICE_RESET)
+        {
+            // Contenu des textures cibles perdu (changement de mode vidéo, ...)
+            UI_invalidate(game->ui);
+            continue;
+        }
+
+        bool action_key = event->type == SDL_KEYDOWN &&
+                          (event->key.keysym.scancode == SDL_SCANCODE_E || event->key.keysym.scancode == SDL_SCANCODE_RETURN);
+        if (action_key && game->dialogue.open)
+        {
+            // Touche d'action : fait défiler la boîte de dialogue ouverte
+            DialogueBox_advance(&game->dialogue, game->text);
+            AudioManager_playSound(game->audio, game->sound_select, 1.0f);
+        }
+        else if (event->type == SDL_KEYDOWN && game->state == MODE_COMBAT && game->dialogue.open)
+        {
+            // Récit du tour en cours : les attaques attendent qu'il soit lu
+        }
+        else if (event->type == SDL_KEYDOWN && game->state == MODE_COMBAT)
+        {
+            // 1 à 4 ou flèches et touche d'action : attaques, Échap : fuite
+            SDL_Scancode key = event->key.keysym.scancode;
+            if (key >= SDL_SCANCODE_1 && key <= SDL_SCANCODE_4)
+            {
+                game->battle_input = (BattleAction){ACTION_MOVE, key - SDL_SCANCODE_1};
+                game->battle_input_ready = true;
+            }
+            else if (action_key)
+            {
+                game->battle_input = (BattleAction){ACTION_MOVE, game->hud.cursor};
+                game->battle_input_ready = true;
+            }
+            else if (key == SDL_SCANCODE_UP || key == SDL_SCANCODE_DOWN)
+            {
+                int moves = game->ui->widgets[game->hud.moves].row_count;
+                game->hud.cursor += key == SDL_SCANCODE_UP ? -1 : 1;
+                game->hud.cursor = moves > 0 ? SDL_clamp(game->hud.cursor, 0, moves - 1) : 0;
+            }
+            else if (key == SDL_SCANCODE_ESCAPE)
+            {
+                game->battle_input = (BattleAction){ACTION_RUN, 0};
+                game->battle_input_ready = true;
+            }
+        }
+        else if (event->type == SDL_KEYDOWN && game->state == MODE_MENU)
         {
-            if (event->key.keysym.scancode == SDL_SCANCODE_SPACE)
+            Game_MenuInput(game, event->key.keysym.scancode);
+        }
+        else if (event->type == SDL_KEYDOWN)
+        {
+            if (event->key.keysym.scancode == SDL_SCANCODE_ESCAPE)
+            {
+                Game_OpenMenu(game);
+            }
+            else if (event->key.keysym.scancode == SDL_SCANCODE_SPACE)
             {
                 game->input.space = true;
             }
@@ -232,6 +653,20 @@ static bool Game_HandleInputEvents(Game *game, SDL_Event *event)
             {
                 game->input.r_key = true;
             }
+            else if (action_key)
+            {
+                game->interact = true;
+            }
+            else if (event->key.keysym.scancode == SDL_SCANCODE_F5)
+            {
+                if (SaveManager_save(game->save))
+                    DialogueBox_open(&game->dialogue, "Partie sauvegardée.");
+            }
+            else if (event->key.keysym.scancode == SDL_SCANCODE_F9)
+            {
+                if (SaveManager_load(game->save))
+                    DialogueBox_open(&game->dialogue, "Partie chargée.");
+            }
         }
     }
 
@@ -245,29 +680,193 @@ static bool Game_HandleInputEvents(Game *game, SDL_Event *event)
     return true;
 }
 
-static void Game_UpdateData(Game *game, float deltaTime)
+static void Game_UpdateData(Game *game, float deltaTime, Uint32 currentTime)
 {
-    processPlayerInput(game->player, &game->input, deltaTime, game->current_map);
-    updatePNJ(game->testPNJ, deltaTime);
+    // Résultats des tâches terminées pendant la frame précédente (chemins des PNJs)
+    JobSystem_update(game->jobs);
+    DialogueBox_update(&game->dialogue, deltaTime);
+
+    // Le monde est en pause pendant un combat
+    if (game->state == MODE_COMBAT)
+    {
+        Game_UpdateCombat(game);
+        return;
+    }
+    // ... comme pendant le menu
+    if (game->state == MODE_MENU)
+        return;
+
+    // Heure du jour, arrêtée elle aussi pendant menus et combats
+    game->day_clock += deltaTime * GAME_MINUTES_PER_SECOND;
+    if (game->day_clock >= 1.0f)
+    {
+        int minutes = (int)game->day_clock;
+        game->day_clock -= minutes;
+        game->day_time = (game->day_time + minutes) % DAY_MINUTES;
+        SaveManager_markDirty(game->save, SAVE_SECTION_WORLD);
+    }
+
+    Player *player = game->player;
+    float last_x = player->entity.x, last_y = player->entity.y;
+    PlayerMode last_mode = player->mode;
+    int last_direction = player->direction; // Sauvegardée aussi : tourner sur place compte
+    processPlayerInput(player, &game->input, deltaTime, game->current_map);
+    if (player->entity.x != last_x || player->entity.y != last_y || player->mode != last_mode ||
+        player->direction != last_direction)
+        SaveManager_markDirty(game->save, SAVE_SECTION_PLAYER);
+    Map_updatePlayerHitbox(game->current_map, game->player->entity.hitbox);
+
+    // Événements de quêtes : changement de tuile, PNJ en face du joueur
+    Hitbox feet = game->player->entity.hitbox;
+    int tile_w = game->current_map->tmx_map->tile_width, tile_h = game->current_map->tmx_map->tile_height;
+    QuestManager_emitTile(game->quests, (int)((feet.x + feet.width / 2) / tile_w), (int)((feet.y + feet.height / 2) / tile_h));
+    if (game->interact)
+        Game_Interact(game, feet, tile_w, tile_h);
+
+    // Tirage seulement quand le joueur change de tuile dans une zone de rencontre
+    Encounter encounter;
+    if (Map_checkEncounter(game->current_map, game->player->entity.hitbox, currentTime, &encounter))
+    {
+        Game_StartWildBattle(game, &encounter);
+    }
     updateCamera(game->camera, game->player->entity.x, game->player->entity.y);
+    Game_ClampCamera(game);
+    Weather_update(game->weather, deltaTime, game->camera->view_rect.x, game->camera->view_rect.y);
+    Map_updateChunks(game->current_map, game->camera);
 
-    UpdatePNJs(game->current_map, deltaTime); // de map
+    UpdatePNJs(game->current_map, game->camera); // de map
+    EntityStore *pnjs = game->current_map->entities;
+    if (pnjs && pnjs->changed)
+    {
+        pnjs->changed = false;
+        SaveManager_markDirty(game->save, SAVE_SECTION_PNJS);
+    }
+    Map_updateAnimations(game->current_map, currentTime);
 }
 
-static void Game_UpdateGraphics(Game *game, Uint32 currentTime)
+// La caméra borne la vue à partir de (0, 0) : sur une carte infinie qui s'étend
+// en coordonnées négatives, la vue est centrée sur le joueur et bornée ici
+static void Game_ClampCamera(Game *game)
 {
+    SDL_Rect bounds;
+    Map_getPixelBounds(game->current_map, &bounds);
+    if (bounds.x >= 0 && bounds.y >= 0)
+        return;
+
+    Entity *target = &game->player->entity;
+    SDL_Rect *view = &game->camera->view_rect;
+    int x = (int)(target->x + target->width / 2) - view->w / 2;
+    int y = (int)(target->y + target->height / 2) - view->h / 2;
+    view->x = SDL_max(bounds.x, SDL_min(x, bounds.x + bounds.w - view->w));
+    view->y = SDL_max(bounds.y, SDL_min(y, bounds.y + bounds.h - view->h));
+}
+
+// Parle au PNJ situé à une tuile devant le joueur
+static void Game_Interact(Game *game, Hitbox feet, int tileW, int tileH)
+{
+    static const int dx[4] = {-1, 1, 0, 0}, dy[4] = {0, 0, -1, 1};
+    int direction = game->player->direction & 3;
+    Hitbox probe = feet;
+    probe.x += dx[direction] * tileW;
+    probe.y += dy[direction] * tileH;
+
+    PNJ *pnj = Map_findPNJ(game->current_map, probe);
+    if (pnj && pnj->name)
+        QuestManager_emitTalk(game->quests, pnj->name);
+}
+
+static void Game_UpdateCombat(Game *game)
+{
+    if (!game->battle_input_ready)
+        return;
+    game->battle_input_ready = false;
+
+    Battle *battle = &game->battle;
+    BattleAction action = game->battle_input;
+    BattlePokemon *self = &battle->sides[BATTLE_PLAYER];
+    if (action.type == ACTION_MOVE && (!self->moves[action.move] || self->pp[action.move] == 0))
+        return;
+
+    BattleAction opponent = Battle_chooseAction(battle, BATTLE_OPPONENT);
+    BattleResult result = Battle_resolveTurn(battle, action, opponent);
+
+    // Récit du tour dans la boîte de dialogue, une ligne par événement
+    char log[DIALOGUE_TEXT_MAX] = "";
+    size_t used = 0;
+    for (int i = 0; i < battle->event_count && used + 1 < sizeof(log); i++)
+    {
+        char line[128];
+        Battle_describeEvent(battle, &battle->events[i], line, sizeof(line));
+        used += snprintf(log + used, sizeof(log) - used, "%s%s", used ? "\n" : "", line);
+    }
+    if (used)
+        DialogueBox_open(&game->dialogue, log);
+    if (result == BATTLE_ONGOING)
+        return;
+
+    // PV et PP restent acquis ; un Pokémon K.O. est soigné tant qu'il n'y a pas de centre
+    game->team[0] = *self;
+    if (result == BATTLE_LOST)
+        game->team[0].hp = (int16_t)game->team[0].stats[STAT_HP];
+    SaveManager_markDirty(game->save, SAVE_SECTION_TEAM);
+    QuestManager_emitBattleEnd(game->quests, result, battle->sides[BATTLE_OPPONENT].species);
+    game->state = MODE_WORLD;
+    AudioManager_playMusic(game->audio, Game_MapProperty(game, "music"), GAME_MUSIC_FADE_MS);
+}
+
+// Écran de combat : l'interface (PV, attaques) puis le récit du tour par-dessus
+static void Game_RenderCombat(Game *game)
+{
+    SDL_SetRenderDrawColor(game->renderer, 240, 240, 232, 255);
+    SDL_RenderClear(game->renderer);
+
+    Game_RefreshBattleHud(game);
+    UI_render(game->ui, game->renderer);
+    DialogueBox_render(&game->dialogue, game->text, game->renderer);
+
+    SDL_RenderPresent(game->renderer);
+}
+
+static void Game_UpdateGraphics(Game *game)
+{
+    if (game->state == MODE_COMBAT)
+    {
+        Game_RenderCombat(game);
+        return;
+    }
+
+    SDL_SetRenderTarget(game->renderer, game->world_target);
     SDL_SetRenderDrawColor(game->renderer, 30, 30, 30, 255);
     SDL_RenderClear(game->renderer);
 
-    Map_renderGroup(game->renderer, game->current_map, "Background", -game->camera->view_rect.x, -game->camera->view_rect.y, currentTime);
-    Map_renderGroup(game->renderer, game->current_map, "PremierPlan", -game->camera->view_rect.x, -game->camera->view_rect.y, currentTime);
+    Map_renderGroup(game->renderer, game->current_map, "Background", -game->camera->view_rect.x, -game->camera->view_rect.y);
+    Map_renderGroup(game->renderer, game->current_map, "PremierPlan", -game->camera->view_rect.x, -game->camera->view_rect.y);
 
-    renderPlayer(game->player, game->renderer, game->camera);
-    renderPNJ(game->testPNJ, game->renderer, game->camera);
-    Map_renderPNJs(game->renderer, game->current_map, game->camera);
+    // Player, PNJs et objets hauts de la carte triés par layer puis par y des pieds
+    RenderQueue_begin(game->render_queue);
+    queuePlayer(game->player, game->render_queue, game->camera);
+    Map_queuePNJs(game->render_queue, game->current_map, game->camera);
+    Map_queueYSortedLayers(game->render_queue, game->current_map, game->camera);
+    RenderQueue_flush(game->render_queue, game->renderer);
+    Map_renderEncounterEffects(game->renderer, game->current_map, game->camera);
 
-    Map_renderGroup(game->renderer, game->current_map, "SecondPlan", -game->camera->view_rect.x, -game->camera->view_rect.y, currentTime);
+    Map_renderGroup(game->renderer, game->current_map, "SecondPlan", -game->camera->view_rect.x, -game->camera->view_rect.y);
     Map_drawCollisionsInCamera(game->renderer, game->current_map, game->camera);
+    drawHitbox(&game->player->entity, game->renderer, game->camera);
+    Weather_render(game->weather, game->renderer);
+
+    // Jour/nuit : une seule copie teintée de l'image du monde, quelle que soit la carte
+    SDL_SetRenderTarget(game->renderer, NULL);
+    SDL_Color tint = DayNight_tint(game->day_time);
+    SDL_SetTextureColorMod(game->world_target, tint.r, tint.g, tint.b);
+    SDL_RenderCopy(game->renderer, game->world_target, NULL, NULL);
+
+    if (game->state == MODE_MENU)
+    {
+        Game_RefreshMenu(game);
+        UI_render(game->ui, game->renderer);
+    }
+    DialogueBox_render(&game->dialogue, game->text, game->renderer);
 
     SDL_RenderPresent(game->renderer);
 }
@@ -284,13 +883,17 @@ void Game_Update(Game *game)
     float deltaTime = (currentTime - game->lastTime) / 1000.0f;
     game->lastTime = currentTime;
 
-    Game_UpdateData(game, deltaTime);
+    Game_UpdateData(game, deltaTime, currentTime);
+    AudioManager_update(game->audio);
+    Game_UpdateHotReload(game);
+    // Événements de la frame (déplacement, dialogues, combats)
+    if (QuestManager_update(game->quests))
+        SaveManager_markDirty(game->save, SAVE_SECTION_QUESTS);
 }
 
 void Game_Render(Game *game)
 {
-    Uint32 currentTime = SDL_GetTicks();
-    Game_UpdateGraphics(game, currentTime);
+    Game_UpdateGraphics(game);
 }
 
 void Game_Run(Game *game)
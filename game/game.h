@@ -4,6 +4,7 @@
 #include <SDL2/SDL.h>
 #include <stdbool.h>
 #include <stdio.h>
+#include <time.h>
 #include <SDL2/SDL_image.h>
 
 // Inclure les en-têtes nécessaires
@@ -13,6 +14,33 @@
 #include "../systems/camera.h"
 #include "../systems/inputs.h"
 #include "../systems/utils.h"
+#include "../systems/render_queue.h"
+#include "../systems/text.h"
+#include "../systems/ui.h"
+#include "../systems/ambience.h"
+#include "../systems/audio.h"
+#include "../systems/watcher.h"
+#include "../systems/jobs.h"
+#include "database.h"
+#include "battle.h"
+#include "../systems/save.h"
+#include "flags.h"
+#include "quest.h"
+#include "inventory.h"
+#include "dialogue.h"
+
+#define GAME_MAP_NAME_MAX 64
+#define GAME_SAVE_PATH "saves/slot1.sav"
+#define GAME_TEAM_SIZE 6
+#define GAME_STARTER_SPECIES 4 // Tant qu'il n'y a pas de choix du starter
+#define GAME_STARTER_LEVEL 5
+#define GAME_START_TIME (8 * 60)      // 8 h au lancement d'une partie
+#define GAME_MINUTES_PER_SECOND 1.0f // Une journée dure 24 minutes
+#define GAME_MUSIC_FADE_MS 1000
+#define GAME_MUSIC_VOLUME 0.6f // Sous les bruitages
+#define GAME_SOUND_VOLUME 1.0f
+#define GAME_SOUND_SELECT "resources/sounds/select.wav"
+#define GAME_TEST_PNJ_SPRITE "resources/sprites/pnj.png"
 
 typedef enum
 {
@@ -23,6 +51,38 @@ typedef enum
 
 } GameState;
 
+// Identifiants des sections de sauvegarde (ne jamais réutiliser un identifiant retiré)
+typedef enum
+{
+    SAVE_SECTION_PLAYER = 1,
+    SAVE_SECTION_PNJS = 2,
+    SAVE_SECTION_TEAM = 3,
+    SAVE_SECTION_FLAGS = 4,
+    SAVE_SECTION_QUESTS = 5,
+    SAVE_SECTION_INVENTORY = 6,
+    SAVE_SECTION_WORLD = 7
+} GameSaveSection;
+
+// Widgets de l'écran du sac (MODE_MENU) et état de sa navigation
+typedef struct
+{
+    int root;
+    int team_icon, team_name, team_bar, team_hp;
+    int pocket, list, info, order_label;
+    ItemCategory category;
+    InventorySort order;
+    int selected;
+} GameMenu;
+
+// Widgets de l'écran de combat
+typedef struct
+{
+    int names[2], bars[2]; // Par côté (BATTLE_PLAYER, BATTLE_OPPONENT)
+    int hp;
+    int moves_panel, moves;
+    int cursor; // Attaque choisie aux flèches
+} GameBattleHud;
+
 typedef struct Game
 {
     SDL_Window *window;
@@ -33,10 +93,43 @@ typedef struct Game
     GameState state;
 
     Map *current_map;
+    char map_name[GAME_MAP_NAME_MAX];
     Player *player;
     Camera *camera;
+    RenderQueue *render_queue; // Sprites triés par profondeur (player, PNJs, calques "ysort")
+    Font *font;
+    TextCache *text;           // Mises en page des textes affichés
+    DialogueBox dialogue;      // Répliques des PNJs, récit des combats
+    UI *ui;                    // Écran du mode courant (sac, combat), voir game_ui.c
+    GameMenu menu;
+    GameBattleHud hud;
+    SDL_Texture *world_target; // Image du monde, teintée selon l'heure en la copiant à l'écran
+    Weather *weather;          // Météo de la carte (propriété "weather")
+    AudioManager *audio;       // NULL : pas de périphérique audio, le jeu est muet
+    int sound_select;          // Bruitage du curseur et des dialogues, -1 sans audio
+    FileWatcher *watcher;      // Ressources modifiées sur le disque, voir game_reload.c
+    JobSystem *jobs;           // Threads de travail (recherches de chemin, ...)
+    ResourceManifest *resources; // Images décodées en parallèle au démarrage, libéré ensuite
     PNJ *testPNJ;
+
+    BattlePokemon team[GAME_TEAM_SIZE];
+    int team_count;
+    Battle battle;             // Combat en cours (MODE_COMBAT)
+    BattleAction battle_input; // Action choisie au clavier pendant la frame
+    bool battle_input_ready;
+    Random rng; // Graines des combats
+
+    int day_time;    // Minutes depuis minuit
+    float day_clock; // Fraction de minute pas encore comptée
+
+    FlagStore *flags; // Flags de progression du scénario
+    QuestManager *quests;
+    Inventory *inventory;
+
+    SaveManager *save; // F5 : sauvegarder, F9 : charger
+
     Input input;
+    bool interact; // E / Entrée pendant la frame : parler au PNJ en face
     Uint32 lastTime; // à supprimer plus tard
 
     bool running;
@@ -55,5 +148,25 @@ bool Game_InitMap(Game *game, const char *map_name);
 bool Game_InitPlayer(Game *game);
 bool Game_InitCamera(Game *game);
 bool Game_InitPNJs(Game *game); // Pour initialiser les PNJ, si besoin
+bool Game_InitTeam(Game *game);
+bool Game_InitInventory(Game *game);
+bool Game_InitSave(Game *game); // game_save.c : enregistre les sections de sauvegarde
+
+// game_reload.c : rechargement à chaud des cartes, tilesets et spritesheets
+bool Game_InitHotReload(Game *game);
+void Game_UpdateHotReload(Game *game);
+// Relit la carte courante depuis son TMX (PNJs compris) ; false : ancienne carte gardée
+bool Game_ReloadMap(Game *game);
+
+// game_ui.c : écrans de l'interface
+void Game_OpenMenu(Game *game);  // Passe en MODE_MENU (Échap dans le monde)
+void Game_CloseMenu(Game *game); // Retour en MODE_WORLD
+void Game_MenuInput(Game *game, SDL_Scancode key);
+void Game_RefreshMenu(Game *game);
+void Game_BuildBattleHud(Game *game);
+void Game_RefreshBattleHud(Game *game);
+
+// Lance un combat contre le Pokémon sauvage d'une rencontre (passe en MODE_COMBAT)
+bool Game_StartWildBattle(Game *game, const Encounter *encounter);
 
 #endif // GAME_H
@@ -0,0 +1,109 @@
+#include "game.h"
+#include <limits.h>
+#include <stdlib.h>
+#include <strings.h>
+
+// Rechargement à chaud des ressources pendant le jeu : les fichiers modifiés
+// sont signalés par le FileWatcher (une fois par contenu différent) et seule
+// la ressource concernée est rechargée :
+//  - .tmx ou .tsx de la carte courante : la carte, le joueur et la caméra restent ;
+//  - .png : les textures des sprites et des tilesets chargés depuis ce fichier.
+
+static const char *watched_dirs[] = {"resources/maps", "resources/TSX", "resources/sprites"};
+
+static bool has_extension(const char *path, const char *extension)
+{
+    size_t length = strlen(path), ext_length = strlen(extension);
+    return length > ext_length && strcasecmp(path + length - ext_length, extension) == 0;
+}
+
+// La carte courante lit-elle le tileset externe 'path' ? Les sources sont
+// relatives au .tmx : on compare les chemins résolus
+static bool map_uses_tileset(Game *game, const char *path)
+{
+    char resolved[PATH_MAX], source[PATH_MAX], candidate[PATH_MAX];
+    if (!game->current_map || !realpath(path, resolved))
+        return false;
+    for (tmx_tileset_list *ts = game->current_map->tmx_map->ts_head; ts; ts = ts->next)
+    {
+        if (ts->is_embedded || !ts->source)
+            continue;
+        if (ts->source[0] == '/')
+            snprintf(candidate, sizeof(candidate), "%s", ts->source);
+        else
+            snprintf(candidate, sizeof(candidate), "resources/maps/%s", ts->source);
+        if (realpath(candidate, source) && strcmp(source, resolved) == 0)
+            return true;
+    }
+    return false;
+}
+
+static bool reload_sprite(Game *game, Sprite *sprite, const char *path)
+{
+    if (!sprite || !sprite->path || strcmp(sprite->path, path) != 0)
+        return false;
+    return reloadSpriteTexture(sprite, game->renderer);
+}
+
+static int reload_sprites(Game *game, const char *path)
+{
+    int reloaded = 0;
+    Player *player = game->player;
+    reloaded += reload_sprite(game, player->walkSprite, path);
+    reloaded += reload_sprite(game, player->runSprite, path);
+    reloaded += reload_sprite(game, player->bikeSprite, path);
+
+    if (game->testPNJ)
+        reloaded += reload_sprite(game, game->testPNJ->sprite, path);
+    Map *map = game->current_map;
+    for (int i = 0; i < map->pnj_count; i++)
+    {
+        if (map->pnjs[i])
+            reloaded += reload_sprite(game, map->pnjs[i]->sprite, path);
+    }
+    return reloaded;
+}
+
+static void Game_ResourceChanged(void *user, const char *path)
+{
+    Game *game = user;
+
+    if (has_extension(path, ".tmx"))
+    {
+        char current[WATCHER_PATH_MAX];
+        snprintf(current, sizeof(current), "resources/maps/%s.tmx", game->map_name);
+        if (strcmp(path, current) == 0)
+            Game_ReloadMap(game);
+    }
+    else if (has_extension(path, ".tsx"))
+    {
+        // Les tilesets externes sont lus avec la carte
+        if (map_uses_tileset(game, path))
+            Game_ReloadMap(game);
+    }
+    else if (has_extension(path, ".png"))
+    {
+        int reloaded = reload_sprites(game, path);
+        reloaded += Map_reloadImage(game->current_map, path, game->renderer);
+        if (reloaded > 0)
+            printf("%s rechargé (%d texture(s))\n", path, reloaded);
+    }
+}
+
+bool Game_InitHotReload(Game *game)
+{
+    game->watcher = FileWatcher_create();
+    if (!game->watcher)
+        return false;
+
+    for (size_t i = 0; i < sizeof(watched_dirs) / sizeof(watched_dirs[0]); i++)
+        FileWatcher_addDirectory(game->watcher, watched_dirs[i], false);
+    // Images des tilesets, rangées par pack
+    FileWatcher_addDirectory(game->watcher, "resources/tileset", true);
+    return true;
+}
+
+void Game_UpdateHotReload(Game *game)
+{
+    FileWatcher_poll(game->watcher, Game_ResourceChanged, game);
+}
@@ -0,0 +1,325 @@
+#include "game.h"
+
+// Sections de sauvegarde de Game. Pour ajouter un état à la sauvegarde : une
+// nouvelle section (identifiant jamais réutilisé), et SaveManager_markDirty
+// quand cet état change. Incrémenter la version d'une section dont le contenu
+// change, en gardant la lecture des versions précédentes.
+
+#define SAVE_PLAYER_VERSION 1
+#define SAVE_PNJS_VERSION 1
+#define SAVE_TEAM_VERSION 1
+#define SAVE_FLAGS_VERSION 1
+#define SAVE_QUESTS_VERSION 1
+#define SAVE_INVENTORY_VERSION 1
+#define SAVE_WORLD_VERSION 1
+
+// Joueur : carte, position, direction, mode
+static bool capture_player(void *user, SaveWriter *out)
+{
+    Game *game = user;
+    SaveWriter_string(out, game->map_name);
+    SaveWriter_f32(out, game->player->entity.x);
+    SaveWriter_f32(out, game->player->entity.y);
+    SaveWriter_u8(out, (uint8_t)game->player->direction);
+    SaveWriter_u8(out, (uint8_t)game->player->mode);
+    return true;
+}
+
+static bool restore_player(void *user, SaveReader *in, uint32_t version)
+{
+    Game *game = user;
+    char map_name[GAME_MAP_NAME_MAX];
+    SaveReader_string(in, map_name, sizeof(map_name));
+    float x = SaveReader_f32(in);
+    float y = SaveReader_f32(in);
+    int direction = SaveReader_u8(in);
+    int mode = SaveReader_u8(in);
+    if (in->error)
+        return false;
+
+    if (strcmp(map_name, game->map_name) != 0)
+    {
+        fprintf(stderr, "Sauvegarde sur la carte '%s', changement de carte non géré\n", map_name);
+        return false;
+    }
+
+    game->player->direction = direction & 3;
+    if (mode <= BIKE_MOD)
+    {
+        game->player->mode = (PlayerMode)mode;
+        setPlayerSprite(game->player);
+    }
+    setPlayerPosition(game->player, x, y);
+    updatePlayerAnimation(game->player);
+    return true;
+}
+
+// PNJs de la carte, dans l'ordre du TMX
+static bool capture_pnjs(void *user, SaveWriter *out)
+{
+    Game *game = user;
+    Map *map = game->current_map;
+    SaveWriter_string(out, game->map_name);
+    SaveWriter_u16(out, (uint16_t)map->pnj_count);
+    for (int i = 0; i < map->pnj_count; i++)
+    {
+        float x = 0.0f, y = 0.0f;
+        if (map->pnjs[i])
+            getPNJPosition(map->pnjs[i], &x, &y);
+        SaveWriter_f32(out, x);
+        SaveWriter_f32(out, y);
+        SaveWriter_u8(out, map->pnjs[i] ? (uint8_t)getPNJDirection(map->pnjs[i]) : 3);
+    }
+    return true;
+}
+
+static bool restore_pnjs(void *user, SaveReader *in, uint32_t version)
+{
+    Game *game = user;
+    Map *map = game->current_map;
+    char map_name[GAME_MAP_NAME_MAX];
+    SaveReader_string(in, map_name, sizeof(map_name));
+    if (strcmp(map_name, game->map_name) != 0)
+        return true; // PNJs d'une autre carte : ceux-ci gardent leur position
+
+    int count = SaveReader_u16(in);
+    for (int i = 0; i < count && !in->error; i++)
+    {
+        float x = SaveReader_f32(in);
+        float y = SaveReader_f32(in);
+        int direction = SaveReader_u8(in);
+        if (i < map->pnj_count && map->pnjs[i] && !in->error)
+        {
+            setPNJPosition(map->pnjs[i], x, y);
+            setPNJDirection(map->pnjs[i], direction & 3);
+        }
+    }
+    return !in->error;
+}
+
+// Équipe : espèce et niveau (les stats en sont recalculées), PV, attaques et PP
+static bool capture_team(void *user, SaveWriter *out)
+{
+    Game *game = user;
+    SaveWriter_u8(out, (uint8_t)game->team_count);
+    for (int i = 0; i < game->team_count; i++)
+    {
+        const BattlePokemon *p = &game->team[i];
+        SaveWriter_u16(out, p->species);
+        SaveWriter_u8(out, p->level);
+        SaveWriter_u16(out, (uint16_t)p->hp);
+        for (int m = 0; m < SPECIES_MAX_MOVES; m++)
+        {
+            SaveWriter_u16(out, p->moves[m]);
+            SaveWriter_u8(out, p->pp[m]);
+        }
+    }
+    return true;
+}
+
+static bool restore_team(void *user, SaveReader *in, uint32_t version)
+{
+    Game *game = user;
+    int count = SaveReader_u8(in);
+    BattlePokemon team[GAME_TEAM_SIZE];
+    int restored = 0;
+    for (int i = 0; i < count && !in->error; i++)
+    {
+        uint16_t species = SaveReader_u16(in);
+        int level = SaveReader_u8(in);
+        int hp = SaveReader_u16(in);
+        uint16_t moves[SPECIES_MAX_MOVES];
+        uint8_t pp[SPECIES_MAX_MOVES];
+        for (int m = 0; m < SPECIES_MAX_MOVES; m++)
+        {
+            moves[m] = SaveReader_u16(in);
+            pp[m] = SaveReader_u8(in);
+        }
+
+        if (restored >= GAME_TEAM_SIZE || !BattlePokemon_init(&team[restored], species, level))
+            continue;
+        BattlePokemon *p = &team[restored++];
+        p->hp = (int16_t)SDL_min(hp, p->stats[STAT_HP]);
+        for (int m = 0; m < SPECIES_MAX_MOVES; m++)
+        {
+            p->moves[m] = Move_get(moves[m]) ? moves[m] : 0;
+            p->pp[m] = p->moves[m] ? pp[m] : 0;
+        }
+    }
+    if (in->error)
+        return false;
+
+    memcpy(game->team, team, restored * sizeof(BattlePokemon));
+    game->team_count = restored;
+    return true;
+}
+
+// Flags : noms dans l'ordre des indices, puis le bitset tel quel
+static bool capture_flags(void *user, SaveWriter *out)
+{
+    FlagStore *flags = ((Game *)user)->flags;
+    SaveWriter_u32(out, (uint32_t)flags->count);
+    for (int i = 0; i < flags->count; i++)
+        SaveWriter_string(out, flags->names[i]);
+    SaveWriter_bytes(out, flags->bits, FlagStore_wordCount(flags) * sizeof(uint64_t));
+    return true;
+}
+
+static bool restore_flags(void *user, SaveReader *in, uint32_t version)
+{
+    FlagStore *flags = ((Game *)user)->flags;
+    int count = (int)SaveReader_u32(in);
+    if (in->error || count < 0 || count > 65536)
+        return false;
+
+    // Indice sauvegardé -> indice courant : identique tant que les scripts créent les
+    // flags dans le même ordre, remappé par nom sinon
+    int *remap = malloc((count > 0 ? count : 1) * sizeof(int));
+    uint64_t *saved = calloc((count + 63) / 64 + 1, sizeof(uint64_t));
+    if (!remap || !saved)
+    {
+        free(remap);
+        free(saved);
+        return false;
+    }
+    for (int i = 0; i < count && !in->error; i++)
+    {
+        char name[128];
+        SaveReader_string(in, name, sizeof(name));
+        remap[i] = FlagStore_index(flags, name);
+    }
+    SaveReader_bytes(in, saved, ((count + 63) / 64) * sizeof(uint64_t));
+
+    uint64_t *bits = in->error ? NULL : calloc(FlagStore_wordCount(flags) + 1, sizeof(uint64_t));
+    bool ok = bits != NULL;
+    if (ok)
+    {
+        for (int i = 0; i < count; i++)
+            if (remap[i] >= 0 && ((saved[i >> 6] >> (i & 63)) & 1u))
+                bits[remap[i] >> 6] |= (uint64_t)1 << (remap[i] & 63);
+
+        // FlagStore_set plutôt qu'une copie : les abonnés voient les flags qui changent
+        for (int i = 0; i < flags->count; i++)
+            FlagStore_set(flags, i, (bits[i >> 6] >> (i & 63)) & 1u);
+    }
+    free(remap);
+    free(saved);
+    free(bits);
+    return ok;
+}
+
+// Quêtes : nom, état et étape courante (les définitions viennent du fichier de quêtes)
+static bool capture_quests(void *user, SaveWriter *out)
+{
+    QuestManager *qm = ((Game *)user)->quests;
+    SaveWriter_u16(out, (uint16_t)qm->count);
+    for (int i = 0; i < qm->count; i++)
+    {
+        SaveWriter_string(out, qm->quests[i].name);
+        SaveWriter_u8(out, (uint8_t)qm->quests[i].state);
+        SaveWriter_u8(out, (uint8_t)qm->quests[i].step);
+    }
+    return true;
+}
+
+static bool restore_quests(void *user, SaveReader *in, uint32_t version)
+{
+    QuestManager *qm = ((Game *)user)->quests;
+    int count = SaveReader_u16(in);
+    for (int i = 0; i < count && !in->error; i++)
+    {
+        char name[QUEST_NAME_MAX];
+        SaveReader_string(in, name, sizeof(name));
+        int state = SaveReader_u8(in);
+        int step = SaveReader_u8(in);
+        Quest *quest = QuestManager_find(qm, name);
+        if (quest && !in->error && state <= QUEST_DONE)
+            QuestManager_setProgress(qm, quest, (QuestState)state, step);
+    }
+    return !in->error;
+}
+
+// Inventaire : (objet, quantité) poche par poche, dans l'ordre d'obtention
+static bool capture_inventory(void *user, SaveWriter *out)
+{
+    Inventory *inv = ((Game *)user)->inventory;
+    int total = 0;
+    for (int c = 0; c < ITEM_CATEGORY_COUNT; c++)
+        total += inv->pockets[c].count;
+
+    SaveWriter_u16(out, (uint16_t)total);
+    for (int c = 0; c < ITEM_CATEGORY_COUNT; c++)
+    {
+        for (int i = 0; i < inv->pockets[c].count; i++)
+        {
+            SaveWriter_u16(out, inv->pockets[c].slots[i].item);
+            SaveWriter_u16(out, inv->pockets[c].slots[i].count);
+        }
+    }
+    return true;
+}
+
+static bool restore_inventory(void *user, SaveReader *in, uint32_t version)
+{
+    Inventory *inv = ((Game *)user)->inventory;
+    int total = SaveReader_u16(in);
+    InventorySlot slots[ITEM_CATEGORY_COUNT * INVENTORY_POCKET_SIZE];
+    int count = 0;
+    for (int i = 0; i < total && !in->error; i++)
+    {
+        InventorySlot slot;
+        slot.item = SaveReader_u16(in);
+        slot.count = SaveReader_u16(in);
+        if (count < ITEM_CATEGORY_COUNT * INVENTORY_POCKET_SIZE)
+            slots[count++] = slot;
+    }
+    if (in->error)
+        return false;
+
+    // Les objets retirés de la base depuis la sauvegarde sont ignorés par Inventory_add
+    Inventory_clear(inv);
+    for (int i = 0; i < count; i++)
+        Inventory_add(inv, slots[i].item, slots[i].count);
+    return true;
+}
+
+// Monde : heure du jour
+static bool capture_world(void *user, SaveWriter *out)
+{
+    SaveWriter_u16(out, (uint16_t)((Game *)user)->day_time);
+    return true;
+}
+
+static bool restore_world(void *user, SaveReader *in, uint32_t version)
+{
+    Game *game = user;
+    int day_time = SaveReader_u16(in);
+    if (in->error || day_time >= DAY_MINUTES)
+        return false;
+    game->day_time = day_time;
+    game->day_clock = 0.0f;
+    return true;
+}
+
+static void flag_changed(void *user, int flag, bool value)
+{
+    SaveManager_markDirty(((Game *)user)->save, SAVE_SECTION_FLAGS);
+}
+
+bool Game_InitSave(Game *game)
+{
+    game->save = SaveManager_create(GAME_SAVE_PATH, game->jobs);
+    if (!game->save)
+        return false;
+
+    SaveManager_register(game->save, SAVE_SECTION_PLAYER, SAVE_PLAYER_VERSION, capture_player, restore_player, game);
+    SaveManager_register(game->save, SAVE_SECTION_PNJS, SAVE_PNJS_VERSION, capture_pnjs, restore_pnjs, game);
+    SaveManager_register(game->save, SAVE_SECTION_WORLD, SAVE_WORLD_VERSION, capture_world, restore_world, game);
+    SaveManager_register(game->save, SAVE_SECTION_TEAM, SAVE_TEAM_VERSION, capture_team, restore_team, game);
+    SaveManager_register(game->save, SAVE_SECTION_FLAGS, SAVE_FLAGS_VERSION, capture_flags, restore_flags, game);
+    FlagStore_subscribe(game->flags, FLAG_ANY, flag_changed, game);
+    SaveManager_register(game->save, SAVE_SECTION_INVENTORY, SAVE_INVENTORY_VERSION, capture_inventory, restore_inventory, game);
+    // Après les flags : leur restauration peut débloquer des quêtes, la section des quêtes a le dernier mot
+    SaveManager_register(game->save, SAVE_SECTION_QUESTS, SAVE_QUESTS_VERSION, capture_quests, restore_quests, game);
+    return true;
+}
@@ -0,0 +1,211 @@
+#include "game.h"
+
+// Écrans de l'interface de Game (sac, combat), construits dans game->ui à
+// l'entrée du mode. Les fonctions Refresh sont appelées à chaque frame : les
+// setters de l'interface ne marquent un widget que si sa valeur change, un écran
+// immobile n'est donc pas redessiné.
+
+static const SDL_Color ui_paper = {248, 248, 240, 255};
+static const SDL_Color ui_frame = {40, 48, 64, 255};
+static const SDL_Color ui_ink = {40, 40, 48, 255};
+static const SDL_Color ui_highlight = {200, 216, 248, 255};
+static const SDL_Color ui_bar_back = {60, 60, 60, 255};
+static const SDL_Color ui_hp_high = {64, 200, 88, 255};
+static const SDL_Color ui_hp_low = {220, 64, 48, 255};
+
+static const char *sort_names[] = {"numéro", "nom", "quantité"};
+
+// Frame "idle_down" du joueur, icône du dresseur dans le sac
+static SDL_Texture *player_icon(Game *game, SDL_Rect *src)
+{
+    Sprite *sprite = game->player->walkSprite;
+    *src = (SDL_Rect){0, 0, sprite->frame_width, sprite->frame_height};
+    getFrameRect(sprite, findAnimation(sprite, "idle_down"), 0, src);
+    return sprite->texture;
+}
+
+static SDL_Color hp_color(const BattlePokemon *p)
+{
+    return p->hp * 5 > p->stats[STAT_HP] ? ui_hp_high : ui_hp_low;
+}
+
+static void refresh_pokemon(UI *ui, const BattlePokemon *p, int name, int bar, int hp)
+{
+    char text[UI_TEXT_MAX];
+    snprintf(text, sizeof(text), "%s N.%d", Species_name(Species_get(p->species)), p->level);
+    UI_setText(ui, name, text);
+    UI_setBar(ui, bar, p->hp, p->stats[STAT_HP]);
+    UI_setColor(ui, bar, hp_color(p));
+    if (hp != UI_NONE)
+    {
+        snprintf(text, sizeof(text), "%d/%d", p->hp, p->stats[STAT_HP]);
+        UI_setText(ui, hp, text);
+    }
+}
+
+void Game_OpenMenu(Game *game)
+{
+    UI *ui = game->ui;
+    GameMenu *menu = &game->menu;
+    int w = game->window_width - 16, h = game->window_height - 16;
+    UI_clear(ui);
+
+    menu->root = UI_addPanel(ui, UI_NONE, (SDL_Rect){8, 8, w, h}, ui_paper, ui_frame);
+
+    // Dresseur et premier Pokémon de l'équipe
+    Sprite *sprite = game->player->walkSprite;
+    SDL_Rect src;
+    player_icon(game, &src);
+    menu->team_icon = UI_addIcon(ui, menu->root, (SDL_Rect){8, 6, sprite->frame_width, sprite->frame_height}, sprite->texture, src);
+    menu->team_name = UI_addLabel(ui, menu->root, (SDL_Rect){44, 8, w - 52, FONT_LINE_HEIGHT}, "", ui_ink);
+    menu->team_bar = UI_addBar(ui, menu->root, (SDL_Rect){44, 22, w / 2, 6}, ui_hp_high, ui_bar_back);
+    menu->team_hp = UI_addLabel(ui, menu->root, (SDL_Rect){w / 2 + 50, 20, 60, FONT_LINE_HEIGHT}, "", ui_ink);
+
+    // Poche affichée et ses objets
+    menu->pocket = UI_addLabel(ui, menu->root, (SDL_Rect){8, 46, w - 16, FONT_LINE_HEIGHT}, "", ui_ink);
+    int list_height = h - 62 - 2 * FONT_LINE_HEIGHT - 12;
+    menu->list = UI_addList(ui, menu->root, (SDL_Rect){8, 62, w - 16, list_height}, INVENTORY_POCKET_SIZE, ui_ink, ui_highlight);
+    menu->info = UI_addLabel(ui, menu->root, (SDL_Rect){8, h - 2 * FONT_LINE_HEIGHT - 8, w - 16, FONT_LINE_HEIGHT}, "", ui_ink);
+    menu->order_label = UI_addLabel(ui, menu->root, (SDL_Rect){8, h - FONT_LINE_HEIGHT - 6, w - 16, FONT_LINE_HEIGHT}, "", ui_ink);
+
+    game->state = MODE_MENU;
+    Game_RefreshMenu(game);
+}
+
+void Game_CloseMenu(Game *game)
+{
+    UI_clear(game->ui);
+    game->state = MODE_WORLD;
+}
+
+void Game_MenuInput(Game *game, SDL_Scancode key)
+{
+    GameMenu *menu = &game->menu;
+    switch (key)
+    {
+    case SDL_SCANCODE_ESCAPE:
+        Game_CloseMenu(game);
+        return;
+    case SDL_SCANCODE_UP:
+    case SDL_SCANCODE_W:
+        menu->selected--;
+        break;
+    case SDL_SCANCODE_DOWN:
+    case SDL_SCANCODE_S:
+        menu->selected++;
+        break;
+    case SDL_SCANCODE_LEFT:
+    case SDL_SCANCODE_A:
+        menu->category = (menu->category + ITEM_CATEGORY_COUNT - 1) % ITEM_CATEGORY_COUNT;
+        menu->selected = 0;
+        break;
+    case SDL_SCANCODE_RIGHT:
+    case SDL_SCANCODE_D:
+        menu->category = (menu->category + 1) % ITEM_CATEGORY_COUNT;
+        menu->selected = 0;
+        break;
+    case SDL_SCANCODE_TAB:
+        menu->order = (menu->order + 1) % 3;
+        break;
+    default:
+        return;
+    }
+    AudioManager_playSound(game->audio, game->sound_select, 1.0f);
+    Game_RefreshMenu(game);
+}
+
+void Game_RefreshMenu(Game *game)
+{
+    UI *ui = game->ui;
+    GameMenu *menu = &game->menu;
+    char text[UI_TEXT_MAX], detail[UI_DETAIL_MAX];
+
+    // La texture du joueur change si sa spritesheet est rechargée à chaud
+    SDL_Rect src;
+    SDL_Texture *icon = player_icon(game, &src);
+    UI_setIcon(ui, menu->team_icon, icon, src);
+
+    if (game->team_count > 0)
+        refresh_pokemon(ui, &game->team[0], menu->team_name, menu->team_bar, menu->team_hp);
+
+    snprintf(text, sizeof(text), "< %s >", ItemCategory_name(menu->category));
+    UI_setText(ui, menu->pocket, text);
+
+    int count;
+    const uint8_t *view = Inventory_view(game->inventory, menu->category, menu->order, &count);
+    for (int i = 0; i < count; i++)
+    {
+        const InventorySlot *slot = Inventory_slot(game->inventory, menu->category, view[i]);
+        snprintf(detail, sizeof(detail), "x%d", slot->count);
+        UI_setListRow(ui, menu->list, i, Item_name(Item_get(slot->item)), detail);
+    }
+    UI_setListCount(ui, menu->list, count);
+    menu->selected = count > 0 ? SDL_clamp(menu->selected, 0, count - 1) : 0;
+    UI_setListSelection(ui, menu->list, menu->selected);
+
+    if (count > 0)
+    {
+        const ItemData *item = Item_get(Inventory_slot(game->inventory, menu->category, view[menu->selected])->item);
+        snprintf(text, sizeof(text), "Prix : %d", item->price);
+    }
+    else
+    {
+        snprintf(text, sizeof(text), "Poche vide");
+    }
+    UI_setText(ui, menu->info, text);
+
+    snprintf(text, sizeof(text), "Tab : tri par %s", sort_names[menu->order]);
+    UI_setText(ui, menu->order_label, text);
+}
+
+void Game_BuildBattleHud(Game *game)
+{
+    UI *ui = game->ui;
+    GameBattleHud *hud = &game->hud;
+    int w = game->window_width, h = game->window_height;
+    int panel_width = w / 2 + 20;
+    UI_clear(ui);
+
+    // Adversaire en haut à gauche, joueur au-dessus des attaques à droite
+    int moves_height = SPECIES_MAX_MOVES * (FONT_LINE_HEIGHT + 3) + 8;
+    int opponent = UI_addPanel(ui, UI_NONE, (SDL_Rect){10, 10, panel_width, 34}, ui_paper, ui_frame);
+    int player = UI_addPanel(ui, UI_NONE, (SDL_Rect){w - panel_width - 10, h - moves_height - 62, panel_width, 46}, ui_paper, ui_frame);
+    int panels[2] = {player, opponent};
+    for (int side = 0; side < 2; side++)
+    {
+        hud->names[side] = UI_addLabel(ui, panels[side], (SDL_Rect){6, 5, panel_width - 12, FONT_LINE_HEIGHT}, "", ui_ink);
+        hud->bars[side] = UI_addBar(ui, panels[side], (SDL_Rect){6, 20, panel_width - 12, 6}, ui_hp_high, ui_bar_back);
+    }
+    hud->hp = UI_addLabel(ui, player, (SDL_Rect){6, 30, panel_width - 12, FONT_LINE_HEIGHT}, "", ui_ink);
+
+    hud->moves_panel = UI_addPanel(ui, UI_NONE, (SDL_Rect){8, h - moves_height - 8, w - 16, moves_height}, ui_paper, ui_frame);
+    hud->moves = UI_addList(ui, hud->moves_panel, (SDL_Rect){4, 4, w - 24, moves_height - 8}, SPECIES_MAX_MOVES, ui_ink, ui_highlight);
+    hud->cursor = 0;
+    Game_RefreshBattleHud(game);
+}
+
+void Game_RefreshBattleHud(Game *game)
+{
+    UI *ui = game->ui;
+    GameBattleHud *hud = &game->hud;
+    refresh_pokemon(ui, &game->battle.sides[BATTLE_PLAYER], hud->names[BATTLE_PLAYER], hud->bars[BATTLE_PLAYER], hud->hp);
+    refresh_pokemon(ui, &game->battle.sides[BATTLE_OPPONENT], hud->names[BATTLE_OPPONENT], hud->bars[BATTLE_OPPONENT], UI_NONE);
+
+    // Attaques (touches 1 à 4, ou flèches et Entrée), cachées pendant le récit du tour
+    const BattlePokemon *self = &game->battle.sides[BATTLE_PLAYER];
+    char text[UI_TEXT_MAX], detail[UI_DETAIL_MAX];
+    int count = 0;
+    for (int m = 0; m < SPECIES_MAX_MOVES; m++)
+    {
+        const MoveData *move = Move_get(self->moves[m]);
+        if (!move)
+            break;
+        snprintf(text, sizeof(text), "%d %s", m + 1, Move_name(move));
+        snprintf(detail, sizeof(detail), "%d/%d", self->pp[m], move->pp);
+        UI_setListRow(ui, hud->moves, m, text, detail);
+        count++;
+    }
+    UI_setListCount(ui, hud->moves, count);
+    UI_setListSelection(ui, hud->moves, hud->cursor);
+    UI_setVisible(ui, hud->moves_panel, !game->dialogue.open);
+}
@@ -0,0 +1,159 @@
+#include "inventory.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+Inventory *Inventory_create(void)
+{
+    Inventory *inv = calloc(1, sizeof(Inventory));
+    if (!inv)
+    {
+        fprintf(stderr, "Erreur d'allocation mémoire pour l'inventaire.\n");
+        return NULL;
+    }
+
+    inv->id_limit = Item_idLimit();
+    inv->slot_of = malloc(inv->id_limit > 0 ? inv->id_limit : 1);
+    if (!inv->slot_of)
+    {
+        fprintf(stderr, "Erreur d'allocation mémoire pour l'inventaire.\n");
+        free(inv);
+        return NULL;
+    }
+    Inventory_clear(inv);
+    return inv;
+}
+
+void Inventory_free(Inventory *inv)
+{
+    if (!inv)
+        return;
+    free(inv->slot_of);
+    free(inv);
+}
+
+void Inventory_clear(Inventory *inv)
+{
+    memset(inv->slot_of, INVENTORY_NO_SLOT, inv->id_limit);
+    for (int c = 0; c < ITEM_CATEGORY_COUNT; c++)
+    {
+        inv->pockets[c].count = 0;
+        inv->pockets[c].view_dirty = true;
+    }
+}
+
+void Inventory_setCallback(Inventory *inv, InventoryCallback callback, void *user)
+{
+    inv->on_change = callback;
+    inv->on_change_user = user;
+}
+
+static void changed(Inventory *inv, InventoryPocket *pocket, uint16_t item, int count)
+{
+    pocket->view_dirty = true;
+    if (inv->on_change)
+        inv->on_change(inv->on_change_user, item, count);
+}
+
+bool Inventory_add(Inventory *inv, uint16_t item, int count)
+{
+    const ItemData *data = Item_get(item);
+    if (!inv || !data || item >= inv->id_limit || count <= 0)
+        return false;
+
+    InventoryPocket *pocket = &inv->pockets[data->category];
+    int slot = inv->slot_of[item];
+    if (slot != INVENTORY_NO_SLOT && pocket->slots[slot].count >= INVENTORY_MAX_STACK)
+        return false; // Pile pleine : rien n'est ajouté, pas de notification
+    if (slot == INVENTORY_NO_SLOT)
+    {
+        if (pocket->count >= INVENTORY_POCKET_SIZE)
+            return false;
+        slot = pocket->count++;
+        pocket->slots[slot] = (InventorySlot){item, 0};
+        inv->slot_of[item] = (uint8_t)slot;
+    }
+
+    InventorySlot *s = &pocket->slots[slot];
+    s->count = (uint16_t)(s->count + count < INVENTORY_MAX_STACK ? s->count + count : INVENTORY_MAX_STACK);
+    changed(inv, pocket, item, s->count);
+    return true;
+}
+
+bool Inventory_remove(Inventory *inv, uint16_t item, int count)
+{
+    if (count <= 0 || Inventory_count(inv, item) < count)
+        return false;
+
+    InventoryPocket *pocket = &inv->pockets[Item_get(item)->category];
+    int slot = inv->slot_of[item];
+    InventorySlot *s = &pocket->slots[slot];
+    s->count -= count;
+    if (s->count == 0)
+    {
+        // Décalage (au plus INVENTORY_POCKET_SIZE slots) pour garder l'ordre d'obtention
+        pocket->count--;
+        memmove(&pocket->slots[slot], &pocket->slots[slot + 1], (pocket->count - slot) * sizeof(InventorySlot));
+        for (int i = slot; i < pocket->count; i++)
+            inv->slot_of[pocket->slots[i].item] = (uint8_t)i;
+        inv->slot_of[item] = INVENTORY_NO_SLOT;
+        changed(inv, pocket, item, 0);
+        return true;
+    }
+    changed(inv, pocket, item, s->count);
+    return true;
+}
+
+const InventorySlot *Inventory_slot(const Inventory *inv, ItemCategory category, int slot)
+{
+    if (!inv || category < 0 || category >= ITEM_CATEGORY_COUNT || slot < 0 || slot >= inv->pockets[category].count)
+        return NULL;
+    return &inv->pockets[category].slots[slot];
+}
+
+// Vrai si le slot 'a' vient avant le slot 'b' dans l'ordre 'sort'
+static bool sorts_before(const InventoryPocket *pocket, InventorySort sort, int a, int b)
+{
+    const InventorySlot *sa = &pocket->slots[a], *sb = &pocket->slots[b];
+    switch (sort)
+    {
+    case INVENTORY_SORT_NAME:
+    {
+        int cmp = strcmp(Item_name(Item_get(sa->item)), Item_name(Item_get(sb->item)));
+        return cmp < 0 || (cmp == 0 && sa->item < sb->item);
+    }
+    case INVENTORY_SORT_COUNT:
+        return sa->count > sb->count || (sa->count == sb->count && sa->item < sb->item);
+    default:
+        return sa->item < sb->item;
+    }
+}
+
+const uint8_t *Inventory_view(Inventory *inv, ItemCategory category, InventorySort sort, int *count)
+{
+    if (!inv || category < 0 || category >= ITEM_CATEGORY_COUNT)
+    {
+        *count = 0;
+        return NULL;
+    }
+
+    InventoryPocket *pocket = &inv->pockets[category];
+    *count = pocket->count;
+    if (!pocket->view_dirty && pocket->view_sort == sort)
+        return pocket->view;
+
+    // Tri par insertion : une poche ne dépasse pas INVENTORY_POCKET_SIZE slots
+    for (int i = 0; i < pocket->count; i++)
+    {
+        int j = i;
+        while (j > 0 && sorts_before(pocket, sort, i, pocket->view[j - 1]))
+        {
+            pocket->view[j] = pocket->view[j - 1];
+            j--;
+        }
+        pocket->view[j] = (uint8_t)i;
+    }
+    pocket->view_sort = sort;
+    pocket->view_dirty = false;
+    return pocket->view;
+}
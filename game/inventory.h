@@ -0,0 +1,82 @@
+#ifndef INVENTORY_H
+#define INVENTORY_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "database.h"
+
+// Sac du joueur : une poche par catégorie d'objets (ItemCategory), chacune un
+// tableau de slots de capacité fixe. Un index identifiant -> slot, alloué une fois
+// pour tous les objets de la base, rend les recherches O(1) ; ajouter ou retirer
+// un objet n'alloue jamais.
+//
+// Les vues triées (pour l'interface) sont gardées par poche et ne sont recalculées
+// qu'après un changement de la poche.
+
+#define INVENTORY_POCKET_SIZE 32
+#define INVENTORY_MAX_STACK 999
+#define INVENTORY_NO_SLOT 0xFF
+
+typedef enum
+{
+    INVENTORY_SORT_ID,   // Ordre de la base (numéro d'objet)
+    INVENTORY_SORT_NAME, // Ordre alphabétique
+    INVENTORY_SORT_COUNT // Quantité décroissante
+} InventorySort;
+
+typedef struct
+{
+    uint16_t item;
+    uint16_t count;
+} InventorySlot;
+
+typedef struct
+{
+    InventorySlot slots[INVENTORY_POCKET_SIZE]; // Ordre d'obtention
+    int count;
+
+    uint8_t view[INVENTORY_POCKET_SIZE]; // Slots dans l'ordre 'view_sort'
+    InventorySort view_sort;
+    bool view_dirty;
+} InventoryPocket;
+
+// 'count' : quantité possédée après le changement
+typedef void (*InventoryCallback)(void *user, uint16_t item, int count);
+
+typedef struct
+{
+    InventoryPocket pockets[ITEM_CATEGORY_COUNT];
+    uint8_t *slot_of; // Par identifiant d'objet : slot dans la poche de sa catégorie
+    int id_limit;
+
+    InventoryCallback on_change;
+    void *on_change_user;
+} Inventory;
+
+// La base de données doit être chargée (taille de l'index)
+Inventory *Inventory_create(void);
+void Inventory_free(Inventory *inv);
+void Inventory_clear(Inventory *inv);
+
+// Appelé à chaque changement de quantité (quêtes, sauvegarde)
+void Inventory_setCallback(Inventory *inv, InventoryCallback callback, void *user);
+
+// Ajoute 'count' exemplaires (plafonnés à INVENTORY_MAX_STACK) ; false si l'objet
+// est inconnu, si sa poche est pleine ou si sa pile l'est déjà (rien n'est ajouté)
+bool Inventory_add(Inventory *inv, uint16_t item, int count);
+// Retire 'count' exemplaires ; false (et rien retiré) s'il n'y en a pas assez
+bool Inventory_remove(Inventory *inv, uint16_t item, int count);
+
+static inline int Inventory_count(const Inventory *inv, uint16_t item)
+{
+    if (!inv || item >= inv->id_limit || inv->slot_of[item] == INVENTORY_NO_SLOT)
+        return 0;
+    const ItemData *data = Item_get(item);
+    return inv->pockets[data->category].slots[inv->slot_of[item]].count;
+}
+
+// Slots d'une poche dans l'ordre demandé (valide jusqu'au prochain changement de la poche)
+const InventorySlot *Inventory_slot(const Inventory *inv, ItemCategory category, int slot);
+const uint8_t *Inventory_view(Inventory *inv, ItemCategory category, InventorySort sort, int *count);
+
+#endif
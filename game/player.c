@@ -6,10 +6,16 @@
 const int LARGEUR_HITBOX = 10;
 const int HAUTEUR_HITBOX = 15;
 
+void addPlayerResources(ResourceManifest *resources)
+{
+    ResourceManifest_add(resources, PLAYER_WALK_SHEET);
+    ResourceManifest_add(resources, PLAYER_BIKE_SHEET);
+}
+
 void initPlayerAnimations(Player *player, SDL_Renderer *renderer)
 {
     // Init walk sprite
-    player->walkSprite = createSpriteWithColumns("resources/sprites/player.png", 4, 5, 25, 32, renderer);
+    player->walkSprite = createSpriteWithColumns(PLAYER_WALK_SHEET, 4, 5, 25, 32, renderer);
 
     // Walk animations
     addSimpleAnimation(player->walkSprite, "idle_left", 4, 4, 0, false);
@@ -23,7 +29,7 @@ void initPlayerAnimations(Player *player, SDL_Renderer *renderer)
     addSimpleAnimation(player->walkSprite, "walk_down", 0, 3, 150, true);
 
     // Init bike sprite
-    player->bikeSprite = createSpriteWithColumns("resources/sprites/player_bike.png", 4, 5, 25, 32, renderer);
+    player->bikeSprite = createSpriteWithColumns(PLAYER_BIKE_SHEET, 4, 5, 25, 32, renderer);
 
     // Bike animations
     addSimpleAnimation(player->bikeSprite, "bike_idle_left", 4, 4, 0, false);
@@ -346,6 +352,22 @@ void renderPlayer(Player *player, SDL_Renderer *renderer, Camera *camera)
     drawHitbox(&player->entity, renderer, camera); // Pass camera to drawHitbox
 }
 
+void queuePlayer(Player *player, RenderQueue *queue, Camera *camera)
+{
+    Sprite *sprite = player->entity.sprite;
+    if (!player->entity.visible || !sprite)
+        return;
+
+    SDL_Rect src;
+    if (!getFrameRect(sprite, sprite->current_animation, sprite->current_frame, &src))
+        return;
+
+    SDL_Rect screen_rect = getScreenRect(camera, player->entity.x, player->entity.y, player->entity.width, player->entity.height);
+    SDL_Rect dst = {screen_rect.x, screen_rect.y, src.w, src.h};
+    RenderQueue_push(queue, sprite->texture, &src, &dst, player->flip, 0.0,
+                     player->entity.layer, player->entity.y + player->entity.height);
+}
+
 void freePlayer(Player *player)
 {
     if (player)
@@ -459,7 +481,20 @@ bool checkCollisionWithMap(Player *player, float newX, float newY, Map *map)
             }
         }
     }
-    return false;
+
+    // Joueur contre PNJs (table spatiale de la carte)
+    return Map_entityBlocked(map, player->entity.hitbox, tempHitbox, SPATIAL_ID_PLAYER);
+}
+
+void setPlayerPosition(Player *player, float x, float y)
+{
+    player->entity.x = x;
+    player->entity.y = y;
+    player->hasTarget = false;
+    player->moving = false;
+    player->wasMovingLastFrame = false;
+    player->entity.hitbox.x = x + player->entity.sprite->frame_width / 2 - LARGEUR_HITBOX / 2;
+    player->entity.hitbox.y = y + player->entity.sprite->frame_height - HAUTEUR_HITBOX;
 }
 
 void setPlayerSprite(Player *player)
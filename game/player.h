@@ -9,6 +9,11 @@
 #include "../systems/inputs.h"
 #include "../framework/map.h"
 #include "../systems/camera.h"
+#include "../systems/render_queue.h"
+#include "../systems/resources.h"
+
+#define PLAYER_WALK_SHEET "resources/sprites/player.png"
+#define PLAYER_BIKE_SHEET "resources/sprites/player_bike.png"
 
 typedef enum
 {
@@ -65,14 +70,17 @@ typedef struct
 } Player;
 
 Player *InitPlayer(float x, float y, SDL_Renderer *renderer);
+void addPlayerResources(ResourceManifest *resources); // Spritesheets du joueur, décodées au démarrage
 void updatePlayer(Player *player, float deltaTime);
 void updatePlayerWithInput(Player *player, Input *input, float deltaTime, Map *map);
 void renderPlayer(Player *player, SDL_Renderer *renderer, Camera *camera); // Added Camera* parameter
+void queuePlayer(Player *player, RenderQueue *queue, Camera *camera);       // Rendu trié en profondeur
 void freePlayer(Player *player);
 bool checkCollisionWithMap(Player *player, float newX, float newY, Map *map);
 bool pointInPolygon(Point point, Point *polygon, int count);
 bool rectangleIntersectsPolygon(Hitbox rect, Point *polygon, int count);
 void setPlayerSprite(Player *player);
+void setPlayerPosition(Player *player, float x, float y); // Téléporte le joueur (annule le déplacement en cours)
 void processPlayerInput(Player *player, Input *input, float deltaTime, Map *map);
 void updatePlayerMovement(Player *player, float deltaTime, Map *map);
 void updatePlayerAnimation(Player *player);
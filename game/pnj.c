@@ -2,40 +2,51 @@
 #include <stdlib.h>
 #include <stdio.h>
 
-PNJ *createPNJ(float x, float y, const char *spritePath, SDL_Renderer *renderer)
+// Indice dense du PNJ dans son EntityStore, -1 s'il n'existe plus
+static int pnjIndex(PNJ *pnj)
 {
-    PNJ *pnj = malloc(sizeof(PNJ));
     if (!pnj)
+        return -1;
+    return EntityStore_indexOf(pnj->store, pnj->handle);
+}
+
+// Abandonne l'itinéraire en cours et la recherche de chemin en attente
+static void stopPNJRoute(PNJ *pnj, int i)
+{
+    if (pnj->path_request >= 0 && pnj->pathfinder)
+        Pathfinder_cancel(pnj->pathfinder, pnj->path_request);
+    pnj->path_request = -1;
+    pnj->path_resume = false;
+    if (i >= 0)
+        EntityStore_setRoute(pnj->store, i, NULL);
+}
+
+PNJ *createPNJ(EntityStore *store, Arena *arena, float x, float y, const char *spritePath, SDL_Renderer *renderer)
+{
+    if (!store)
         return NULL;
 
-    pnj->sprite = createSpriteWithColumns(spritePath, 4, 5, 25, 32, renderer);
+    PNJ *pnj = arena ? Arena_alloc(arena, sizeof(PNJ)) : malloc(sizeof(PNJ));
+    if (!pnj)
+        return NULL;
+
+    pnj->arena = arena;
+    pnj->name = NULL;
+    pnj->sprite = arena ? createSpriteInArena(arena, spritePath, 4, 5, 25, 32, renderer)
+                        : createSpriteWithColumns(spritePath, 4, 5, 25, 32, renderer);
     if (!pnj->sprite)
     {
-        free(pnj);
+        if (!arena)
+            free(pnj);
         return NULL;
     }
 
-    // Setup entity
-    pnj->entity.x = x;
-    pnj->entity.y = y;
-    pnj->entity.width = pnj->sprite->frame_width;
-    pnj->entity.height = pnj->sprite->frame_height;
-    pnj->entity.sprite = pnj->sprite;
-    pnj->entity.visible = true;
-    pnj->entity.layer = 1;
+    pnj->store = store;
     pnj->aEteInit = false;
-
-    // Setup hitbox
-    pnj->entity.hitbox.x = x;
-    pnj->entity.hitbox.y = y;
-    pnj->entity.hitbox.width = pnj->entity.width;
-    pnj->entity.hitbox.height = pnj->entity.height;
-
-    pnj->direction = 2; // bas par défaut
-    pnj->speed = 30.0f;
-    pnj->moving = false;
-    pnj->hasTarget = false;
-    pnj->flip = SDL_FLIP_NONE;
+    pnj->route.count = 0;
+    pnj->pathfinder = NULL;
+    pnj->path_request = -1;
+    pnj->path_resume = false;
 
     pnj->animations.anims[0] = (PNJAnimationSet){"idle_left", "walk_left"};
     pnj->animations.anims[1] = (PNJAnimationSet){"idle_right", "walk_right"};
@@ -52,178 +63,239 @@ PNJ *createPNJ(float x, float y, const char *spritePath, SDL_Renderer *renderer)
     addPNJAnimation(pnj, "walk_up", 12, 15, 150, true);
     addPNJAnimation(pnj, "walk_down", 0, 3, 150, true);
 
-    return pnj;
-}
+    // Setup entity
+    pnj->handle = EntityStore_spawn(store, x, y, pnj->sprite->frame_width, pnj->sprite->frame_height, pnj->sprite, 1, pnj);
+    int i = EntityStore_indexOf(store, pnj->handle);
+    if (i < 0)
+    {
+        freeSprite(pnj->sprite);
+        if (!arena)
+            free(pnj);
+        return NULL;
+    }
 
-void updatePNJ(PNJ *pnj, float deltaTime)
-{
-    if (!pnj)
-        return;
+    // Setup hitbox (aux pieds, centrée)
+    EntityStore_setHitbox(store, i, (store->width[i] - PNJ_HITBOX_WIDTH) / 2, store->height[i] - PNJ_HITBOX_HEIGHT,
+                          PNJ_HITBOX_WIDTH, PNJ_HITBOX_HEIGHT);
 
-    updatePNJMovement(pnj, deltaTime);
-    updatePNJAnimation(pnj);
-    updateEntity(&pnj->entity);
-}
+    store->direction[i] = 2; // bas par défaut
+    store->speed[i] = 30.0f;
 
-void renderPNJ(PNJ *pnj, SDL_Renderer *renderer, Camera *camera)
-{
-    if (pnj && pnj->entity.visible && pnj->entity.sprite)
-    {
-        SDL_Rect screen_rect = getScreenRect(camera, pnj->entity.x, pnj->entity.y, pnj->entity.width, pnj->entity.height);
-        renderSprite(pnj->entity.sprite, renderer, screen_rect.x, screen_rect.y);
-    }
-    if (pnj)
+    // Résoudre les noms d'animation une seule fois
+    for (int d = 0; d < 4; d++)
     {
-        // drawHitbox(&pnj->entity, renderer, camera);
+        store->anim_ids[i].idle[d] = (int16_t)findAnimation(pnj->sprite, pnj->animations.anims[d].idle);
+        store->anim_ids[i].walk[d] = (int16_t)findAnimation(pnj->sprite, pnj->animations.anims[d].walk);
     }
+
+    return pnj;
 }
 
 void freePNJ(PNJ *pnj)
 {
     if (pnj)
     {
+        stopPNJRoute(pnj, -1);
+        EntityStore_destroy(pnj->store, pnj->handle);
         if (pnj->sprite)
         {
             freeSprite(pnj->sprite);
             pnj->sprite = NULL;
         }
-        pnj->entity.sprite = NULL;
-        free(pnj);
+        // Un PNJ alloué dans une arena est rendu avec elle
+        if (!pnj->arena)
+            free(pnj);
     }
 }
 
 void moveLeft(PNJ *pnj, float distance)
 {
-    if (!pnj)
+    int i = pnjIndex(pnj);
+    if (i < 0)
         return;
-    pnj->targetX = pnj->entity.x - distance;
-    pnj->targetY = pnj->entity.y;
-    pnj->hasTarget = true;
-    pnj->moving = true;
-    pnj->direction = 0;
+    stopPNJRoute(pnj, i);
+    EntityStore_setTarget(pnj->store, i, pnj->store->x[i] - distance, pnj->store->y[i], 0);
 }
 
 void moveRight(PNJ *pnj, float distance)
 {
-    if (!pnj)
+    int i = pnjIndex(pnj);
+    if (i < 0)
         return;
-    pnj->targetX = pnj->entity.x + distance;
-    pnj->targetY = pnj->entity.y;
-    pnj->hasTarget = true;
-    pnj->moving = true;
-    pnj->direction = 1;
+    stopPNJRoute(pnj, i);
+    EntityStore_setTarget(pnj->store, i, pnj->store->x[i] + distance, pnj->store->y[i], 1);
 }
 
 void moveUp(PNJ *pnj, float distance)
 {
-    if (!pnj)
+    int i = pnjIndex(pnj);
+    if (i < 0)
         return;
-    pnj->targetX = pnj->entity.x;
-    pnj->targetY = pnj->entity.y - distance;
-    pnj->hasTarget = true;
-    pnj->moving = true;
-    pnj->direction = 2;
+    stopPNJRoute(pnj, i);
+    EntityStore_setTarget(pnj->store, i, pnj->store->x[i], pnj->store->y[i] - distance, 2);
 }
 
 void moveDown(PNJ *pnj, float distance)
 {
-    if (!pnj)
+    int i = pnjIndex(pnj);
+    if (i < 0)
         return;
-    pnj->targetX = pnj->entity.x;
-    pnj->targetY = pnj->entity.y + distance;
-    pnj->hasTarget = true;
-    pnj->moving = true;
-    pnj->direction = 3;
+    stopPNJRoute(pnj, i);
+    EntityStore_setTarget(pnj->store, i, pnj->store->x[i], pnj->store->y[i] + distance, 3);
 }
 
 void moveTo(PNJ *pnj, float x, float y)
 {
-    if (!pnj)
+    int i = pnjIndex(pnj);
+    if (i < 0)
         return;
-    pnj->targetX = x;
-    pnj->targetY = y;
-    pnj->hasTarget = true;
-    pnj->moving = true;
+
+    stopPNJRoute(pnj, i);
 
     // Déterminer la direction principale du mouvement
-    float dx = x - pnj->entity.x;
-    float dy = y - pnj->entity.y;
+    float dx = x - pnj->store->x[i];
+    float dy = y - pnj->store->y[i];
+    int direction;
 
-    if (abs(dx) > abs(dy))
+    if (fabsf(dx) > fabsf(dy))
     {
-        pnj->direction = (dx > 0) ? 1 : 0; // droite ou gauche
+        direction = (dx > 0) ? 1 : 0; // droite ou gauche
     }
     else
     {
-        pnj->direction = (dy > 0) ? 3 : 2; // bas ou haut
+        direction = (dy > 0) ? 3 : 2; // bas ou haut
     }
-}
 
-void addPNJAnimation(PNJ *pnj, const char *name, int startFrame, int endFrame, int frameTime, bool loop)
-{
-    if (!pnj || !pnj->sprite)
-        return;
-    addSimpleAnimation(pnj->sprite, name, startFrame, endFrame, frameTime, loop);
+    EntityStore_setTarget(pnj->store, i, x, y, direction);
 }
 
-void playPNJAnimation(PNJ *pnj, const char *animName)
+// Position du PNJ pour que ses pieds soient au centre-bas de la tuile
+static void tileToPNJPosition(PNJ *pnj, int i, int tileSize, SDL_Point tile, float *x, float *y)
 {
-    if (!pnj || !pnj->sprite)
-        return;
-    playAnimation(pnj->sprite, animName);
+    *x = tile.x * tileSize + tileSize / 2 - pnj->store->width[i] / 2;
+    *y = (tile.y + 1) * tileSize - pnj->store->height[i];
 }
 
-void setPNJDirection(PNJ *pnj, int direction)
+// Une routine en attente du chemin reprend à la fin du déplacement (tout de suite si aucun)
+static void releasePNJScript(PNJ *pnj, int i)
 {
-    if (!pnj || direction < 0 || direction > 3)
-        return;
-    pnj->direction = direction;
+    if (pnj->store->script[i] && pnj->store->script_wait[i] == SCRIPT_WAIT_PATH)
+        pnj->store->script_wait[i] = SCRIPT_WAIT_MOVE;
 }
 
-void updatePNJMovement(PNJ *pnj, float deltaTime)
+static void onPNJPathFound(void *user, PathStatus status, const Path *path)
 {
-    if (!pnj->hasTarget)
+    PNJ *pnj = user;
+    pnj->path_request = -1;
+
+    int i = pnjIndex(pnj);
+    if (i < 0)
+        return;
+    if (status != PATH_FOUND)
     {
-        pnj->moving = false;
+        releasePNJScript(pnj, i);
         return;
     }
 
-    float dx = pnj->targetX - pnj->entity.x;
-    float dy = pnj->targetY - pnj->entity.y;
-    float distance = sqrt(dx * dx + dy * dy);
+    int tileSize = pnj->pathfinder->grid.tile_size;
+    int count = path->count < ENTITY_ROUTE_MAX ? path->count : ENTITY_ROUTE_MAX;
+    for (int p = 0; p < count; p++)
+        tileToPNJPosition(pnj, i, tileSize, path->points[p], &pnj->route.x[p], &pnj->route.y[p]);
+    pnj->route.count = count;
+    EntityStore_setRoute(pnj->store, i, &pnj->route);
+
+    // La suite d'un chemin tronqué part de son dernier point, une fois celui-ci atteint
+    pnj->path_resume = path->truncated && count > 0;
+    if (!pnj->path_resume)
+        releasePNJScript(pnj, i);
+}
 
-    if (distance > 1.0f)
-    {
-        float moveDistance = pnj->speed * deltaTime;
-        if (moveDistance > distance)
-            moveDistance = distance;
+// Recherche depuis la tuile sous les pieds du PNJ
+static bool requestPNJPath(PNJ *pnj, int i, Pathfinder *pathfinder, SDL_Point goal)
+{
+    int tileSize = pathfinder->grid.tile_size;
+    SDL_Point start = {(int)(pnj->store->x[i] + pnj->store->width[i] / 2) / tileSize,
+                       (int)(pnj->store->y[i] + pnj->store->height[i] - 1) / tileSize};
+
+    pnj->pathfinder = pathfinder;
+    pnj->path_goal = goal;
+    pnj->path_request = Pathfinder_request(pathfinder, start, goal, onPNJPathFound, pnj);
+    return pnj->path_request >= 0;
+}
 
-        pnj->entity.x += (dx / distance) * moveDistance;
-        pnj->entity.y += (dy / distance) * moveDistance;
-    }
-    else
-    {
-        pnj->entity.x = pnj->targetX;
-        pnj->entity.y = pnj->targetY;
-        pnj->hasTarget = false;
-        pnj->moving = false;
-    }
+bool walkPNJTo(PNJ *pnj, Pathfinder *pathfinder, int tileX, int tileY)
+{
+    int i = pnjIndex(pnj);
+    if (i < 0 || !pathfinder)
+        return false;
+    stopPNJRoute(pnj, i);
+    return requestPNJPath(pnj, i, pathfinder, (SDL_Point){tileX, tileY});
+}
 
-    // Mise à jour de la hitbox
-    pnj->entity.hitbox.x = pnj->entity.x;
-    pnj->entity.hitbox.y = pnj->entity.y;
+void cancelPNJPath(PNJ *pnj)
+{
+    if (pnj)
+        stopPNJRoute(pnj, -1);
 }
 
-void updatePNJAnimation(PNJ *pnj)
+void resumePNJRoute(PNJ *pnj)
 {
-    if (!pnj)
+    if (!pnj || !pnj->path_resume)
+        return;
+    int i = pnjIndex(pnj);
+    if (i < 0 || pnj->store->has_target[i])
+        return;
+
+    pnj->path_resume = false;
+    if (!requestPNJPath(pnj, i, pnj->pathfinder, pnj->path_goal))
+        releasePNJScript(pnj, i);
+}
+
+void setPNJScript(PNJ *pnj, const Script *script)
+{
+    int i = pnjIndex(pnj);
+    if (i < 0)
         return;
+    stopPNJRoute(pnj, i);
+    EntityStore_setScript(pnj->store, i, script);
+}
 
-    const char *animName = NULL;
-    PNJAnimationSet *currentAnimSet = &pnj->animations.anims[pnj->direction];
+void addPNJAnimation(PNJ *pnj, const char *name, int startFrame, int endFrame, int frameTime, bool loop)
+{
+    if (!pnj || !pnj->sprite)
+        return;
+    addSimpleAnimation(pnj->sprite, name, startFrame, endFrame, frameTime, loop);
+}
 
-    // Choisir idle ou walk selon si le PNJ bouge
-    animName = pnj->moving ? currentAnimSet->walk : currentAnimSet->idle;
+void setPNJDirection(PNJ *pnj, int direction)
+{
+    int i = pnjIndex(pnj);
+    if (i < 0 || direction < 0 || direction > 3)
+        return;
+    pnj->store->direction[i] = (uint8_t)direction;
+}
+
+int getPNJDirection(PNJ *pnj)
+{
+    int i = pnjIndex(pnj);
+    return (i < 0) ? -1 : pnj->store->direction[i];
+}
+
+bool getPNJPosition(PNJ *pnj, float *x, float *y)
+{
+    int i = pnjIndex(pnj);
+    if (i < 0)
+        return false;
+    *x = pnj->store->x[i];
+    *y = pnj->store->y[i];
+    return true;
+}
 
-    playAnimation(pnj->sprite, animName);
-}
\ No newline at end of file
+void setPNJPosition(PNJ *pnj, float x, float y)
+{
+    int i = pnjIndex(pnj);
+    if (i < 0)
+        return;
+    stopPNJRoute(pnj, i);
+    EntityStore_setPosition(pnj->store, i, x, y);
+}
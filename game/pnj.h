@@ -2,11 +2,17 @@
 #define PNJ_H
 
 #include "entity.h"
+#include "entity_store.h"
 #include <stdbool.h>
 #include <SDL2/SDL.h>
 #include <string.h>
 #include <math.h>
 #include "../systems/camera.h"
+#include "../systems/pathfinding.h"
+
+// Hitbox aux pieds du PNJ (bloque le joueur et les autres PNJs)
+#define PNJ_HITBOX_WIDTH 12
+#define PNJ_HITBOX_HEIGHT 12
 
 typedef struct
 {
@@ -19,18 +25,16 @@ typedef struct
     PNJAnimationSet anims[4]; // [gauche, droite, haut, bas]
 } PNJAnimations;
 
+// Données "froides" d'un PNJ. Position, cible, hitbox et état d'animation
+// sont stockés dans l'EntityStore de la carte (accès via 'handle').
 typedef struct
 {
-    Entity entity;
-    float speed;
-    bool moving;
-    SDL_RendererFlip flip;
+    EntityStore *store;
+    EntityHandle handle;
+    Arena *arena; // Arena de la carte si le PNJ y est alloué, NULL sinon
+    const char *name; // Nom de l'objet TMX (dialogues, quêtes), NULL si inconnu
 
     PNJAnimations animations;
-    int direction; // 0=gauche, 1=droite, 2=haut, 3=bas
-
-    float targetX, targetY;
-    bool hasTarget;
 
     float default_x_spawn;
     float default_y_spawn;
@@ -38,12 +42,18 @@ typedef struct
     bool aEteInit;
 
     Sprite *sprite;
+
+    // Déplacement par recherche de chemin
+    EntityRoute route;       // Itinéraire suivi par l'EntityStore
+    Pathfinder *pathfinder;  // Pathfinder de la dernière requête
+    int path_request;        // Requête en attente, -1 si aucune
+    SDL_Point path_goal;     // Tuile visée par la dernière requête
+    bool path_resume;        // Chemin tronqué : la suite est demandée une fois le début parcouru
 } PNJ;
 
 // Fonctions principales
-PNJ *createPNJ(float x, float y, const char *spritePath, SDL_Renderer *renderer);
-void updatePNJ(PNJ *pnj, float deltaTime);
-void renderPNJ(PNJ *pnj, SDL_Renderer *renderer, Camera *camera);
+// 'arena' peut être NULL : le PNJ est alors alloué avec malloc
+PNJ *createPNJ(EntityStore *store, Arena *arena, float x, float y, const char *spritePath, SDL_Renderer *renderer);
 void freePNJ(PNJ *pnj);
 
 // Fonctions de déplacement
@@ -52,14 +62,21 @@ void moveRight(PNJ *pnj, float distance);
 void moveUp(PNJ *pnj, float distance);
 void moveDown(PNJ *pnj, float distance);
 void moveTo(PNJ *pnj, float x, float y);
+// Demande un chemin jusqu'à la tuile (tileX, tileY) ; le PNJ part dès qu'il est trouvé
+bool walkPNJTo(PNJ *pnj, Pathfinder *pathfinder, int tileX, int tileY);
+// Redemande la suite d'un chemin tronqué quand le PNJ en a parcouru le début
+void resumePNJRoute(PNJ *pnj);
+// Annule la recherche de chemin en attente (et la suite d'un chemin tronqué)
+void cancelPNJPath(PNJ *pnj);
+
+// Routine de comportement (NULL l'arrête)
+void setPNJScript(PNJ *pnj, const Script *script);
 
 // Fonctions d'animation
 void addPNJAnimation(PNJ *pnj, const char *name, int startFrame, int endFrame, int frameTime, bool loop);
-void playPNJAnimation(PNJ *pnj, const char *animName);
 void setPNJDirection(PNJ *pnj, int direction);
-
-// Fonctions internes
-void updatePNJMovement(PNJ *pnj, float deltaTime);
-void updatePNJAnimation(PNJ *pnj);
+int getPNJDirection(PNJ *pnj);
+bool getPNJPosition(PNJ *pnj, float *x, float *y);
+void setPNJPosition(PNJ *pnj, float x, float y); // Téléporte le PNJ
 
 #endif
\ No newline at end of file
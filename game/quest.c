@@ -0,0 +1,441 @@
+#include "quest.h"
+#include "battle.h"
+#include "database.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define QUEST_MAX_TOKENS 6
+
+static QuestEventType step_event(QuestStepType type)
+{
+    switch (type)
+    {
+    case STEP_TALK:
+        return QUEST_EVENT_TALK;
+    case STEP_REACH:
+        return QUEST_EVENT_TILE;
+    case STEP_WIN:
+        return QUEST_EVENT_BATTLE_END;
+    default:
+        return QUEST_EVENT_ITEM;
+    }
+}
+
+static void subscribe(QuestManager *qm, int index, QuestEventType type)
+{
+    Quest *q = &qm->quests[index];
+    q->sub_type = type;
+    q->sub_prev = -1;
+    q->sub_next = qm->subscribers[type];
+    if (q->sub_next >= 0)
+        qm->quests[q->sub_next].sub_prev = index;
+    qm->subscribers[type] = index;
+}
+
+static void unsubscribe(QuestManager *qm, int index)
+{
+    Quest *q = &qm->quests[index];
+    if (q->sub_type < 0)
+        return;
+    if (q->sub_prev >= 0)
+        qm->quests[q->sub_prev].sub_next = q->sub_next;
+    else
+        qm->subscribers[q->sub_type] = q->sub_next;
+    if (q->sub_next >= 0)
+        qm->quests[q->sub_next].sub_prev = q->sub_prev;
+    q->sub_type = q->sub_next = q->sub_prev = -1;
+}
+
+static bool tile_in_step(const QuestStep *s, int x, int y)
+{
+    return x >= s->x && x < s->x + s->w && y >= s->y && y < s->y + s->h;
+}
+
+static int item_count(QuestManager *qm, int item)
+{
+    return qm->host.item_count ? qm->host.item_count(qm->host.user, item) : 0;
+}
+
+// Vérifie une étape contre un événement
+static bool step_matches(const QuestStep *s, const QuestEvent *e)
+{
+    switch (s->type)
+    {
+    case STEP_TALK:
+        return e->name && strcmp(e->name, s->target) == 0;
+    case STEP_REACH:
+        return tile_in_step(s, e->a, e->b);
+    case STEP_WIN:
+        return e->a == BATTLE_WON && (s->species == 0 || s->species == e->b);
+    case STEP_OWN:
+        return e->a == s->item && e->b >= s->count;
+    }
+    return false;
+}
+
+// Étape déjà remplie au moment où elle devient courante (tuile atteinte, objet possédé)
+static bool step_already_done(QuestManager *qm, const QuestStep *s)
+{
+    if (s->type == STEP_REACH)
+        return qm->has_tile && tile_in_step(s, qm->tile_x, qm->tile_y);
+    if (s->type == STEP_OWN)
+        return item_count(qm, s->item) >= s->count;
+    return false;
+}
+
+// Passe la quête à l'étape 'step' (et aux suivantes si elles sont déjà remplies)
+static void enter_step(QuestManager *qm, int index, int step)
+{
+    Quest *q = &qm->quests[index];
+    unsubscribe(qm, index);
+    qm->changed = true;
+    while (step < q->step_count && step_already_done(qm, &q->steps[step]))
+        step++;
+
+    q->step = step;
+    if (step < q->step_count)
+    {
+        q->state = QUEST_ACTIVE;
+        subscribe(qm, index, step_event(q->steps[step].type));
+        return;
+    }
+
+    q->state = QUEST_DONE;
+    // Les récompenses peuvent débloquer d'autres quêtes (via on_flag)
+    for (int i = 0; i < q->reward_count; i++)
+        FlagStore_set(qm->flags, q->rewards[i], true);
+    if (qm->on_complete)
+        qm->on_complete(qm->on_complete_user, q);
+}
+
+// Les quêtes verrouillées démarrent quand leur flag est levé
+static void on_flag(void *user, int flag, bool value)
+{
+    QuestManager *qm = user;
+    if (!value)
+        return;
+    for (int i = 0; i < qm->count; i++)
+    {
+        if (qm->quests[i].state == QUEST_LOCKED && qm->quests[i].require_flag == flag)
+            enter_step(qm, i, 0);
+    }
+}
+
+QuestManager *QuestManager_create(FlagStore *flags, const QuestHost *host)
+{
+    QuestManager *qm = calloc(1, sizeof(QuestManager));
+    if (!qm)
+    {
+        fprintf(stderr, "Erreur d'allocation mémoire pour les quêtes.\n");
+        return NULL;
+    }
+    for (int t = 0; t < QUEST_EVENT_COUNT; t++)
+        qm->subscribers[t] = -1;
+    qm->flags = flags;
+    if (host)
+        qm->host = *host;
+    qm->flag_sub = FlagStore_subscribe(flags, FLAG_ANY, on_flag, qm);
+    return qm;
+}
+
+void QuestManager_free(QuestManager *qm)
+{
+    if (!qm)
+        return;
+    FlagStore_unsubscribe(qm->flags, qm->flag_sub);
+    free(qm->quests);
+    free(qm);
+}
+
+void QuestManager_setCallback(QuestManager *qm, QuestCallback callback, void *user)
+{
+    qm->on_complete = callback;
+    qm->on_complete_user = user;
+}
+
+static bool load_error(const char *path, int line, const char *message, const char *token)
+{
+    fprintf(stderr, "Quêtes %s, ligne %d: %s%s%s\n", path, line, message, token ? " " : "", token ? token : "");
+    return false;
+}
+
+static bool parse_int(const char *token, int *value)
+{
+    char *end;
+    long v = strtol(token, &end, 10);
+    if (*token == '\0' || *end != '\0' || v < 0 || v > 65535)
+        return false;
+    *value = (int)v;
+    return true;
+}
+
+// Une ligne d'un bloc "quest" (hors titre, lu par QuestManager_load)
+static bool parse_line(QuestManager *qm, Quest *q, char **tokens, int count, const char *path, int line)
+{
+    const char *op = tokens[0];
+    if (strcmp(op, "end") == 0 || strcmp(op, "quest") == 0)
+        return true;
+
+    if (strcmp(op, "require") == 0 && count == 2)
+    {
+        q->require_flag = FlagStore_index(qm->flags, tokens[1]);
+        return q->require_flag != FLAG_NONE;
+    }
+    if (strcmp(op, "set") == 0 && count == 2)
+    {
+        if (q->reward_count >= QUEST_MAX_REWARDS)
+            return load_error(path, line, "trop de flags", tokens[1]);
+        q->rewards[q->reward_count] = FlagStore_index(qm->flags, tokens[1]);
+        return q->rewards[q->reward_count++] != FLAG_NONE;
+    }
+
+    if (q->step_count >= QUEST_MAX_STEPS)
+        return load_error(path, line, "trop d'étapes", NULL);
+    QuestStep *s = &q->steps[q->step_count];
+    memset(s, 0, sizeof(QuestStep));
+
+    if (strcmp(op, "talk") == 0 && count == 2)
+    {
+        s->type = STEP_TALK;
+        if (strlen(tokens[1]) >= sizeof(s->target))
+            return load_error(path, line, "nom de PNJ trop long", tokens[1]);
+        snprintf(s->target, sizeof(s->target), "%s", tokens[1]);
+    }
+    else if (strcmp(op, "reach") == 0 && (count == 3 || count == 5))
+    {
+        s->type = STEP_REACH;
+        s->w = s->h = 1;
+        if (!parse_int(tokens[1], &s->x) || !parse_int(tokens[2], &s->y) ||
+            (count == 5 && (!parse_int(tokens[3], &s->w) || !parse_int(tokens[4], &s->h))))
+            return load_error(path, line, "tuile invalide", NULL);
+    }
+    else if (strcmp(op, "win") == 0 && count == 2)
+    {
+        s->type = STEP_WIN;
+        if (strcmp(tokens[1], "any") != 0)
+        {
+            const SpeciesData *species = Species_find(tokens[1]);
+            if (!species)
+                return load_error(path, line, "espèce inconnue", tokens[1]);
+            s->species = species->id;
+        }
+    }
+    else if (strcmp(op, "own") == 0 && count == 3)
+    {
+        s->type = STEP_OWN;
+        s->item = qm->host.resolve_item ? qm->host.resolve_item(qm->host.user, tokens[1]) : -1;
+        if (s->item < 0)
+            return load_error(path, line, "objet inconnu", tokens[1]);
+        if (!parse_int(tokens[2], &s->count))
+            return load_error(path, line, "quantité invalide", tokens[2]);
+    }
+    else
+    {
+        return load_error(path, line, "instruction inconnue", op);
+    }
+    q->step_count++;
+    return true;
+}
+
+static Quest *add_quest(QuestManager *qm)
+{
+    if (qm->count >= qm->capacity)
+    {
+        int capacity = qm->capacity ? qm->capacity * 2 : 16;
+        Quest *quests = realloc(qm->quests, capacity * sizeof(Quest));
+        if (!quests)
+            return NULL;
+        qm->quests = quests;
+        qm->capacity = capacity;
+    }
+    Quest *q = &qm->quests[qm->count++];
+    memset(q, 0, sizeof(Quest));
+    q->require_flag = FLAG_NONE;
+    q->sub_type = q->sub_next = q->sub_prev = -1;
+    return q;
+}
+
+bool QuestManager_load(QuestManager *qm, const char *path)
+{
+    FILE *file = fopen(path, "r");
+    if (!file)
+    {
+        fprintf(stderr, "Impossible d'ouvrir les quêtes %s\n", path);
+        return false;
+    }
+
+    int first = qm->count;
+    Quest *q = NULL;
+    bool ok = true;
+    char buffer[256];
+    for (int line = 1; ok && fgets(buffer, sizeof(buffer), file); line++)
+    {
+        char *comment = strchr(buffer, '#');
+        if (comment)
+            *comment = '\0';
+
+        // Titre entre guillemets, puis découpage en mots
+        char *title = NULL;
+        char *quote = strchr(buffer, '"');
+        if (quote)
+        {
+            char *close = strchr(quote + 1, '"');
+            if (!close)
+            {
+                ok = load_error(path, line, "guillemet non fermé", NULL);
+                break;
+            }
+            *quote = '\0';
+            *close = '\0';
+            title = quote + 1;
+        }
+        char *tokens[QUEST_MAX_TOKENS];
+        int count = 0;
+        for (char *tok = strtok(buffer, " \t\r\n"); tok && count < QUEST_MAX_TOKENS; tok = strtok(NULL, " \t\r\n"))
+            tokens[count++] = tok;
+        if (count == 0)
+            continue;
+
+        if (strcmp(tokens[0], "quest") == 0)
+        {
+            if (count != 2)
+            {
+                ok = load_error(path, line, "nom de quête attendu", NULL);
+                break;
+            }
+            q = add_quest(qm);
+            if (!q)
+            {
+                ok = load_error(path, line, "mémoire insuffisante", NULL);
+                break;
+            }
+            snprintf(q->name, sizeof(q->name), "%s", tokens[1]);
+            snprintf(q->title, sizeof(q->title), "%s", title ? title : tokens[1]);
+        }
+        else if (!q)
+        {
+            ok = load_error(path, line, "instruction hors d'un bloc quest", tokens[0]);
+        }
+        else
+        {
+            ok = parse_line(qm, q, tokens, count, path, line);
+            if (strcmp(tokens[0], "end") == 0)
+                q = NULL;
+        }
+    }
+    fclose(file);
+
+    if (!ok)
+    {
+        qm->count = first;
+        return false;
+    }
+
+    // Quêtes sans condition : actives tout de suite ; les autres attendent leur flag
+    for (int i = first; i < qm->count; i++)
+    {
+        Quest *quest = &qm->quests[i];
+        if (quest->require_flag == FLAG_NONE || FlagStore_get(qm->flags, quest->require_flag))
+            enter_step(qm, i, 0);
+    }
+    return true;
+}
+
+void QuestManager_emit(QuestManager *qm, QuestEvent event)
+{
+    if (!qm)
+        return;
+    if (qm->tail - qm->head >= QUEST_EVENT_CAPACITY)
+    {
+        // File pleine : l'événement le plus récent est perdu
+        if (qm->dropped++ == 0)
+            fprintf(stderr, "Quêtes : file d'événements pleine\n");
+        return;
+    }
+    qm->events[qm->tail++ & (QUEST_EVENT_CAPACITY - 1)] = event;
+}
+
+void QuestManager_emitTile(QuestManager *qm, int tileX, int tileY)
+{
+    if (!qm || (qm->has_tile && qm->tile_x == tileX && qm->tile_y == tileY))
+        return;
+    qm->tile_x = tileX;
+    qm->tile_y = tileY;
+    qm->has_tile = true;
+    QuestManager_emit(qm, (QuestEvent){QUEST_EVENT_TILE, tileX, tileY, NULL});
+}
+
+void QuestManager_emitTalk(QuestManager *qm, const char *pnj)
+{
+    QuestManager_emit(qm, (QuestEvent){QUEST_EVENT_TALK, 0, 0, pnj});
+}
+
+void QuestManager_emitBattleEnd(QuestManager *qm, int result, int species)
+{
+    QuestManager_emit(qm, (QuestEvent){QUEST_EVENT_BATTLE_END, result, species, NULL});
+}
+
+void QuestManager_emitItem(QuestManager *qm, int item, int count)
+{
+    QuestManager_emit(qm, (QuestEvent){QUEST_EVENT_ITEM, item, count, NULL});
+}
+
+bool QuestManager_update(QuestManager *qm)
+{
+    if (!qm)
+        return false;
+    while (qm->head != qm->tail)
+    {
+        QuestEvent event = qm->events[qm->head++ & (QUEST_EVENT_CAPACITY - 1)];
+
+        // Seules les quêtes dont l'étape courante attend ce type d'événement sont visitées.
+        // 'next' est lu avant : une quête qui avance change de liste (en tête, non revisitée).
+        for (int i = qm->subscribers[event.type]; i >= 0;)
+        {
+            int next = qm->quests[i].sub_next;
+            Quest *q = &qm->quests[i];
+            if (step_matches(&q->steps[q->step], &event))
+                enter_step(qm, i, q->step + 1);
+            i = next;
+        }
+    }
+    qm->dropped = 0;
+
+    bool changed = qm->changed;
+    qm->changed = false;
+    return changed;
+}
+
+Quest *QuestManager_find(QuestManager *qm, const char *name)
+{
+    for (int i = 0; qm && i < qm->count; i++)
+    {
+        if (strcmp(qm->quests[i].name, name) == 0)
+            return &qm->quests[i];
+    }
+    return NULL;
+}
+
+void QuestManager_setProgress(QuestManager *qm, Quest *quest, QuestState state, int step)
+{
+    int index = (int)(quest - qm->quests);
+    unsubscribe(qm, index);
+    if (state == QUEST_LOCKED)
+    {
+        quest->state = QUEST_LOCKED;
+        quest->step = 0;
+    }
+    else if (state == QUEST_DONE || step >= quest->step_count)
+    {
+        // Les flags de récompense sont restaurés par leur propre section
+        quest->state = QUEST_DONE;
+        quest->step = quest->step_count;
+    }
+    else
+    {
+        quest->state = QUEST_ACTIVE;
+        quest->step = step < 0 ? 0 : step;
+        subscribe(qm, index, step_event(quest->steps[quest->step].type));
+    }
+}
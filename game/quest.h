@@ -0,0 +1,145 @@
+#ifndef QUEST_H
+#define QUEST_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "flags.h"
+
+// Quêtes pilotées par événements. Les systèmes du jeu (déplacement du joueur,
+// dialogues, combats, inventaire) déposent des événements typés dans une file
+// circulaire, vidée une fois par tick par QuestManager_update. Chaque quête active
+// n'est inscrite que sur le type d'événement de son étape courante : une frame sans
+// événement ne coûte rien, quel que soit le nombre de quêtes.
+//
+// Les quêtes sont décrites dans un fichier texte, un bloc par quête :
+//
+//   quest colis "Le colis du professeur"
+//   require flag_nom        facultatif : la quête démarre quand le flag est levé
+//   talk PNJ_1              parler à un PNJ (nom de l'objet TMX)
+//   reach 12 8              atteindre une tuile (ou "reach x y largeur hauteur")
+//   win Rattata             gagner un combat contre cette espèce ("win any" : n'importe lequel)
+//   own Potion 2            posséder un objet en N exemplaires
+//   set colis_livre         flag levé à la fin de la quête
+//   end
+
+#define QUEST_PATH "resources/data/quests.txt"
+#define QUEST_EVENT_CAPACITY 256 // Puissance de 2
+#define QUEST_MAX_STEPS 16
+#define QUEST_MAX_REWARDS 4
+#define QUEST_NAME_MAX 32
+#define QUEST_TITLE_MAX 64
+#define QUEST_TARGET_MAX 64 // Nom d'objet TMX d'un PNJ, refusé au chargement s'il est plus long
+
+typedef enum
+{
+    QUEST_EVENT_TILE,       // a, b : tuile des pieds du joueur
+    QUEST_EVENT_TALK,       // name : PNJ à qui le joueur parle
+    QUEST_EVENT_BATTLE_END, // a : BattleResult, b : espèce adverse
+    QUEST_EVENT_ITEM,       // a : objet, b : quantité possédée après le changement
+    QUEST_EVENT_COUNT
+} QuestEventType;
+
+typedef struct
+{
+    QuestEventType type;
+    int a, b;
+    const char *name; // Doit rester valide jusqu'au prochain QuestManager_update
+} QuestEvent;
+
+typedef enum
+{
+    STEP_TALK,
+    STEP_REACH,
+    STEP_WIN,
+    STEP_OWN
+} QuestStepType;
+
+typedef struct
+{
+    QuestStepType type;
+    int x, y, w, h;      // STEP_REACH
+    int species;         // STEP_WIN, 0 : n'importe laquelle
+    int item, count;     // STEP_OWN
+    char target[QUEST_TARGET_MAX]; // STEP_TALK
+} QuestStep;
+
+typedef enum
+{
+    QUEST_LOCKED, // En attente de son flag 'require'
+    QUEST_ACTIVE,
+    QUEST_DONE
+} QuestState;
+
+typedef struct
+{
+    char name[QUEST_NAME_MAX];
+    char title[QUEST_TITLE_MAX];
+    int require_flag; // FLAG_NONE : active dès le chargement
+    int rewards[QUEST_MAX_REWARDS];
+    int reward_count;
+    QuestStep steps[QUEST_MAX_STEPS];
+    int step_count;
+
+    QuestState state;
+    int step;
+
+    // Liste des quêtes inscrites sur le même type d'événement (-1 : fin ou non inscrite)
+    int sub_type;
+    int sub_next, sub_prev;
+} Quest;
+
+// Services du jeu (inventaire) ; les champs NULL sont remplacés par des valeurs neutres
+typedef struct
+{
+    void *user;
+    int (*resolve_item)(void *user, const char *name); // -1 si inconnu
+    int (*item_count)(void *user, int item);
+} QuestHost;
+
+typedef void (*QuestCallback)(void *user, const Quest *quest);
+
+typedef struct
+{
+    Quest *quests;
+    int count, capacity;
+    int subscribers[QUEST_EVENT_COUNT]; // Première quête inscrite par type, -1 si aucune
+
+    QuestEvent events[QUEST_EVENT_CAPACITY];
+    uint32_t head, tail; // Lecture, écriture (compteurs libres, masqués à l'accès)
+    int dropped;
+
+    int tile_x, tile_y; // Dernière tuile signalée (doublons ignorés, étapes "reach" déjà atteintes)
+    bool has_tile;
+    bool changed; // Une quête a changé d'étape depuis le dernier QuestManager_update
+
+    FlagStore *flags;
+    int flag_sub; // Abonnement aux flags (déblocage des quêtes)
+    QuestHost host;
+    QuestCallback on_complete;
+    void *on_complete_user;
+} QuestManager;
+
+QuestManager *QuestManager_create(FlagStore *flags, const QuestHost *host);
+void QuestManager_free(QuestManager *qm);
+
+// Charge les quêtes d'un fichier (s'ajoutent aux quêtes déjà chargées)
+bool QuestManager_load(QuestManager *qm, const char *path);
+
+// Appelé à chaque quête terminée
+void QuestManager_setCallback(QuestManager *qm, QuestCallback callback, void *user);
+
+// Dépose un événement (thread principal) ; évalué au prochain QuestManager_update
+void QuestManager_emit(QuestManager *qm, QuestEvent event);
+void QuestManager_emitTile(QuestManager *qm, int tileX, int tileY); // Ignoré si la tuile n'a pas changé
+void QuestManager_emitTalk(QuestManager *qm, const char *pnj);
+void QuestManager_emitBattleEnd(QuestManager *qm, int result, int species);
+void QuestManager_emitItem(QuestManager *qm, int item, int count);
+
+// Vide la file et fait avancer les quêtes concernées ; vrai si une quête a changé d'étape
+bool QuestManager_update(QuestManager *qm);
+
+Quest *QuestManager_find(QuestManager *qm, const char *name);
+// Place une quête dans un état (restauration d'une sauvegarde)
+void QuestManager_setProgress(QuestManager *qm, Quest *quest, QuestState state, int step);
+
+#endif
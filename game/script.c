@@ -0,0 +1,369 @@
+#include "script.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+
+#define SCRIPT_MAX_CODE 1024
+#define SCRIPT_MAX_NAMES 64
+#define SCRIPT_MAX_TOKENS 4
+
+typedef struct
+{
+    char name[32];
+    int address;
+    int line;
+} ScriptLabel;
+
+// État de la compilation (tableaux temporaires, copiés dans l'arena à la fin)
+typedef struct
+{
+    const char *name;
+    int line;
+
+    uint16_t code[SCRIPT_MAX_CODE];
+    int code_size;
+
+    ScriptLabel labels[SCRIPT_MAX_NAMES];
+    int label_count;
+    ScriptLabel fixups[SCRIPT_MAX_NAMES]; // Sauts vers une étiquette ('address' = position de l'opérande)
+    int fixup_count;
+
+    char *strings[SCRIPT_MAX_NAMES];
+    int string_count;
+    char *flags[SCRIPT_MAX_NAMES];
+    int flag_count;
+} ScriptCompiler;
+
+static bool compile_error(ScriptCompiler *c, const char *message, const char *token)
+{
+    fprintf(stderr, "Script %s, ligne %d: %s%s%s\n", c->name, c->line, message, token ? " " : "", token ? token : "");
+    return false;
+}
+
+static bool emit(ScriptCompiler *c, int value)
+{
+    if (c->code_size >= SCRIPT_MAX_CODE)
+        return compile_error(c, "script trop long", NULL);
+    c->code[c->code_size++] = (uint16_t)value;
+    return true;
+}
+
+static int parse_direction(const char *token)
+{
+    static const char *names[4] = {"left", "right", "up", "down"};
+    for (int d = 0; d < 4; d++)
+    {
+        if (strcmp(token, names[d]) == 0)
+            return d;
+    }
+    return -1;
+}
+
+static bool parse_number(const char *token, int max, int *value)
+{
+    char *end;
+    long v = strtol(token, &end, 10);
+    if (*token == '\0' || *end != '\0' || v < 0 || v > max)
+        return false;
+    *value = (int)v;
+    return true;
+}
+
+// Indice d'un nom dans une table, ajouté s'il n'y est pas
+static int intern(ScriptCompiler *c, char **table, int *count, const char *name)
+{
+    for (int i = 0; i < *count; i++)
+    {
+        if (strcmp(table[i], name) == 0)
+            return i;
+    }
+    if (*count >= SCRIPT_MAX_NAMES)
+    {
+        compile_error(c, "trop de noms différents", name);
+        return -1;
+    }
+    table[*count] = strdup(name);
+    if (!table[*count])
+        return -1;
+    return (*count)++;
+}
+
+static bool emit_label_ref(ScriptCompiler *c, const char *label)
+{
+    if (c->fixup_count >= SCRIPT_MAX_NAMES)
+        return compile_error(c, "trop de sauts", NULL);
+    ScriptLabel *f = &c->fixups[c->fixup_count++];
+    snprintf(f->name, sizeof(f->name), "%s", label);
+    f->address = c->code_size;
+    f->line = c->line;
+    return emit(c, 0);
+}
+
+// Compile une instruction déjà découpée ; 'text' est la chaîne entre guillemets éventuelle
+static bool compile_statement(ScriptCompiler *c, char **tokens, int count, const char *text)
+{
+    const char *op = tokens[0];
+    int value;
+
+    if (strcmp(op, "end") == 0 && count == 1)
+        return emit(c, OP_END);
+
+    if (strcmp(op, "walk") == 0 && count == 3)
+    {
+        int dir = parse_direction(tokens[1]);
+        if (dir < 0)
+            return compile_error(c, "direction inconnue", tokens[1]);
+        if (!parse_number(tokens[2], 255, &value))
+            return compile_error(c, "nombre de tuiles invalide", tokens[2]);
+        return emit(c, OP_WALK) && emit(c, dir) && emit(c, value);
+    }
+
+    if (strcmp(op, "walkto") == 0 && count == 3)
+    {
+        int x;
+        if (!parse_number(tokens[1], UINT16_MAX, &x))
+            return compile_error(c, "tuile invalide", tokens[1]);
+        if (!parse_number(tokens[2], UINT16_MAX, &value))
+            return compile_error(c, "tuile invalide", tokens[2]);
+        return emit(c, OP_WALK_TO) && emit(c, x) && emit(c, value);
+    }
+
+    if (strcmp(op, "face") == 0 && count == 2)
+    {
+        int dir = parse_direction(tokens[1]);
+        if (dir < 0)
+            return compile_error(c, "direction inconnue", tokens[1]);
+        return emit(c, OP_FACE) && emit(c, dir);
+    }
+
+    if (strcmp(op, "wait") == 0 && count == 2)
+    {
+        if (!parse_number(tokens[1], UINT16_MAX, &value))
+            return compile_error(c, "durée invalide", tokens[1]);
+        return emit(c, OP_WAIT) && emit(c, value);
+    }
+
+    if (strcmp(op, "say") == 0 && count == 1 && text)
+    {
+        int index = intern(c, c->strings, &c->string_count, text);
+        return index >= 0 && emit(c, OP_SAY) && emit(c, index);
+    }
+
+    if (strcmp(op, "goto") == 0 && count == 2)
+        return emit(c, OP_JUMP) && emit_label_ref(c, tokens[1]);
+
+    if ((strcmp(op, "if") == 0 || strcmp(op, "ifnot") == 0) && count == 4 && strcmp(tokens[2], "goto") == 0)
+    {
+        int flag = intern(c, c->flags, &c->flag_count, tokens[1]);
+        return flag >= 0 && emit(c, op[2] == 'n' ? OP_JUMP_IF_NOT : OP_JUMP_IF) && emit(c, flag) && emit_label_ref(c, tokens[3]);
+    }
+
+    return compile_error(c, "instruction invalide", op);
+}
+
+// Découpe et compile une ligne (modifiée sur place)
+static bool compile_line(ScriptCompiler *c, char *line)
+{
+    char *tokens[SCRIPT_MAX_TOKENS];
+    int count = 0;
+    const char *text = NULL;
+    char *p = line;
+
+    while (*p)
+    {
+        while (isspace((unsigned char)*p))
+            p++;
+        if (*p == '\0' || *p == '#')
+            break;
+
+        if (*p == '"')
+        {
+            text = ++p;
+            while (*p && *p != '"')
+                p++;
+            if (*p != '"')
+                return compile_error(c, "guillemet non fermé", NULL);
+            *p++ = '\0';
+            continue;
+        }
+
+        if (count >= SCRIPT_MAX_TOKENS)
+            return compile_error(c, "trop de mots", NULL);
+        tokens[count++] = p;
+        while (*p && !isspace((unsigned char)*p))
+            p++;
+        if (*p)
+            *p++ = '\0';
+    }
+
+    if (count == 0)
+        return true;
+
+    // Étiquette "nom:"
+    size_t len = strlen(tokens[0]);
+    if (count == 1 && !text && len > 1 && tokens[0][len - 1] == ':')
+    {
+        tokens[0][len - 1] = '\0';
+        if (c->label_count >= SCRIPT_MAX_NAMES)
+            return compile_error(c, "trop d'étiquettes", NULL);
+        ScriptLabel *l = &c->labels[c->label_count++];
+        snprintf(l->name, sizeof(l->name), "%s", tokens[0]);
+        l->address = c->code_size;
+        l->line = c->line;
+        return true;
+    }
+
+    return compile_statement(c, tokens, count, text);
+}
+
+static bool resolve_labels(ScriptCompiler *c)
+{
+    for (int f = 0; f < c->fixup_count; f++)
+    {
+        int target = -1;
+        for (int l = 0; l < c->label_count; l++)
+        {
+            if (strcmp(c->labels[l].name, c->fixups[f].name) == 0)
+            {
+                target = c->labels[l].address;
+                break;
+            }
+        }
+        if (target < 0)
+        {
+            c->line = c->fixups[f].line;
+            return compile_error(c, "étiquette inconnue", c->fixups[f].name);
+        }
+        c->code[c->fixups[f].address] = (uint16_t)target;
+    }
+    return true;
+}
+
+static char **copy_names(Arena *arena, char **names, int count)
+{
+    char **copy = Arena_alloc(arena, (count > 0 ? count : 1) * sizeof(char *));
+    if (!copy)
+        return NULL;
+    for (int i = 0; i < count; i++)
+    {
+        copy[i] = Arena_strdup(arena, names[i]);
+        if (!copy[i])
+            return NULL;
+    }
+    return copy;
+}
+
+Script *Script_compile(Arena *arena, const char *source, const char *name)
+{
+    if (!arena || !source)
+        return NULL;
+
+    ScriptCompiler *c = calloc(1, sizeof(ScriptCompiler));
+    char *text = strdup(source);
+    if (!c || !text)
+    {
+        fprintf(stderr, "Erreur d'allocation mémoire pour la compilation du script.\n");
+        free(c);
+        free(text);
+        return NULL;
+    }
+    c->name = name ? name : "?";
+
+    // Lignes (ou instructions séparées par ';')
+    bool ok = true;
+    char *line = text;
+    while (ok && line)
+    {
+        c->line++;
+        char *next = line;
+        bool quoted = false;
+        while (*next && *next != '\n' && (*next != ';' || quoted))
+        {
+            if (*next == '"')
+                quoted = !quoted;
+            next++;
+        }
+        if (*next)
+            *next++ = '\0';
+        else
+            next = NULL;
+        ok = compile_line(c, line);
+        line = next;
+    }
+    ok = ok && emit(c, OP_END) && resolve_labels(c);
+
+    Script *script = NULL;
+    if (ok)
+    {
+        script = Arena_alloc(arena, sizeof(Script));
+        if (script)
+        {
+            script->code = Arena_alloc(arena, c->code_size * sizeof(uint16_t));
+            script->strings = copy_names(arena, c->strings, c->string_count);
+            script->flags = copy_names(arena, c->flags, c->flag_count);
+            script->flag_ids = Arena_alloc(arena, (c->flag_count > 0 ? c->flag_count : 1) * sizeof(int));
+            if (!script->code || !script->strings || !script->flags || !script->flag_ids)
+            {
+                script = NULL;
+            }
+            else
+            {
+                memcpy(script->code, c->code, c->code_size * sizeof(uint16_t));
+                script->code_size = c->code_size;
+                script->string_count = c->string_count;
+                script->flag_count = c->flag_count;
+                for (int i = 0; i < c->flag_count; i++)
+                    script->flag_ids[i] = -1;
+            }
+        }
+    }
+
+    for (int i = 0; i < c->string_count; i++)
+        free(c->strings[i]);
+    for (int i = 0; i < c->flag_count; i++)
+        free(c->flags[i]);
+    free(c);
+    free(text);
+    return script;
+}
+
+Script *Script_compileFile(Arena *arena, const char *path)
+{
+    FILE *file = fopen(path, "rb");
+    if (!file)
+    {
+        fprintf(stderr, "Impossible d'ouvrir le script %s\n", path);
+        return NULL;
+    }
+
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+
+    char *source = malloc(size + 1);
+    if (!source)
+    {
+        fclose(file);
+        return NULL;
+    }
+    size_t read = fread(source, 1, size, file);
+    source[read] = '\0';
+    fclose(file);
+
+    Script *script = Script_compile(arena, source, path);
+    free(source);
+    return script;
+}
+
+void Script_bindFlags(const Script *script, const ScriptHost *host)
+{
+    if (!script)
+        return;
+    for (int i = 0; i < script->flag_count; i++)
+    {
+        script->flag_ids[i] = (host && host->resolve_flag) ? host->resolve_flag(host->user, script->flags[i]) : -1;
+        if (host && host->resolve_flag && script->flag_ids[i] < 0)
+            fprintf(stderr, "Script: flag inconnu %s\n", script->flags[i]);
+    }
+}
@@ -0,0 +1,73 @@
+#ifndef SCRIPT_H
+#define SCRIPT_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "../systems/arena.h"
+
+// Routines de comportement des PNJs, écrites en texte (propriété TMX "script"
+// ou fichier désigné par "script_file") et compilées au chargement en bytecode.
+// Une instruction par ligne (ou séparées par ';'), '#' commence un commentaire :
+//
+//   debut:                  étiquette
+//   walk left 3             marche de N tuiles (left, right, up, down)
+//   walkto 12 7             va jusqu'à la tuile (x, y) en contournant les obstacles
+//   face down               se tourner
+//   wait 1500               attendre N millisecondes
+//   say "Bonjour !"         afficher une réplique
+//   if flag_nom goto fin    saut si le flag est levé (ifnot : s'il ne l'est pas)
+//   goto debut
+//   fin:
+//   end                     fin du script (implicite en fin de texte)
+
+#define SCRIPT_TILE_SIZE 16
+#define SCRIPT_MAX_STEPS 32 // Instructions max exécutées par PNJ et par tick
+
+typedef enum
+{
+    OP_END,
+    OP_WALK,        // direction, nombre de tuiles
+    OP_WALK_TO,     // tuile x, tuile y
+    OP_FACE,        // direction
+    OP_WAIT,        // millisecondes
+    OP_SAY,         // indice de chaîne
+    OP_JUMP,        // adresse
+    OP_JUMP_IF,     // indice de flag, adresse
+    OP_JUMP_IF_NOT  // indice de flag, adresse
+} ScriptOp;
+
+typedef struct
+{
+    uint16_t *code;
+    int code_size;
+
+    char **strings; // Répliques de "say"
+    int string_count;
+
+    char **flags; // Noms des flags testés par if/ifnot
+    int *flag_ids; // Indices des flags côté jeu (Script_bindFlags), FLAG_NONE tant que non résolus
+    int flag_count;
+} Script;
+
+// Services fournis par le jeu. Les noms de flags sont résolus une fois en indices
+// (resolve_flag) au chargement du script, get_flag ne reçoit que des indices.
+typedef struct
+{
+    void *user;
+    int (*resolve_flag)(void *user, const char *name); // -1 si inconnu
+    bool (*get_flag)(void *user, int flag);
+    void (*say)(void *user, void *owner, const char *text); // 'owner' : PNJ qui parle
+    bool (*walk_to)(void *user, void *owner, int tileX, int tileY); // false si aucune recherche n'a été lancée
+    void (*cancel_walk)(void *user, void *owner); // "walk" : une recherche en cours ne doit plus déplacer le PNJ
+} ScriptHost;
+
+// Compile une routine (toute la mémoire vient de 'arena'), NULL en cas d'erreur
+Script *Script_compile(Arena *arena, const char *source, const char *name);
+
+// Lit et compile un fichier de routine
+Script *Script_compileFile(Arena *arena, const char *path);
+
+// Résout les noms de flags du script auprès de 'host' (à refaire si le host change)
+void Script_bindFlags(const Script *script, const ScriptHost *host);
+
+#endif
@@ -0,0 +1,202 @@
+#include "spatial_hash.h"
+#include <stdlib.h>
+#include <stdio.h>
+#include <math.h>
+
+static inline unsigned hash_cell(SpatialHash *hash, int cx, int cy)
+{
+    return ((unsigned)cx * 73856093u ^ (unsigned)cy * 19349663u) & hash->bucket_mask;
+}
+
+static inline int cell_of(SpatialHash *hash, float v)
+{
+    return (int)floorf(v / hash->cell_size);
+}
+
+static inline bool overlaps(Hitbox a, Hitbox b)
+{
+    return a.x < b.x + b.width && a.x + a.width > b.x &&
+           a.y < b.y + b.height && a.y + a.height > b.y;
+}
+
+static bool grow_array(void **array, size_t element_size, int capacity)
+{
+    void *p = realloc(*array, element_size * capacity);
+    if (!p)
+        return false;
+    *array = p;
+    return true;
+}
+
+static bool SpatialHash_grow(SpatialHash *hash, int capacity)
+{
+    bool ok = grow_array((void **)&hash->next, sizeof(int), capacity) &&
+              grow_array((void **)&hash->prev, sizeof(int), capacity) &&
+              grow_array((void **)&hash->cell_x, sizeof(int), capacity) &&
+              grow_array((void **)&hash->cell_y, sizeof(int), capacity) &&
+              grow_array((void **)&hash->rect, sizeof(Hitbox), capacity) &&
+              grow_array((void **)&hash->used, sizeof(uint8_t), capacity);
+    if (!ok)
+        return false;
+
+    for (int i = hash->capacity; i < capacity; i++)
+        hash->used[i] = 0;
+    hash->capacity = capacity;
+    return true;
+}
+
+SpatialHash *SpatialHash_create(int capacity, int cellSize)
+{
+    SpatialHash *hash = calloc(1, sizeof(SpatialHash));
+    if (!hash)
+        return NULL;
+
+    hash->cell_size = cellSize > 0 ? cellSize : SPATIAL_CELL_SIZE;
+    int buckets = 64;
+    while (buckets < capacity * 2)
+        buckets *= 2;
+    hash->buckets = malloc(buckets * sizeof(int));
+
+    if (!hash->buckets || !SpatialHash_grow(hash, capacity > 0 ? capacity : 16))
+    {
+        fprintf(stderr, "Erreur d'allocation mémoire pour la table spatiale.\n");
+        SpatialHash_free(hash);
+        return NULL;
+    }
+    hash->bucket_mask = buckets - 1;
+    for (int b = 0; b < buckets; b++)
+        hash->buckets[b] = SPATIAL_NONE;
+    return hash;
+}
+
+void SpatialHash_free(SpatialHash *hash)
+{
+    if (!hash)
+        return;
+    free(hash->buckets);
+    free(hash->next);
+    free(hash->prev);
+    free(hash->cell_x);
+    free(hash->cell_y);
+    free(hash->rect);
+    free(hash->used);
+    free(hash);
+}
+
+static void unlink_item(SpatialHash *hash, int id)
+{
+    if (hash->prev[id] != SPATIAL_NONE)
+        hash->next[hash->prev[id]] = hash->next[id];
+    else
+        hash->buckets[hash_cell(hash, hash->cell_x[id], hash->cell_y[id])] = hash->next[id];
+    if (hash->next[id] != SPATIAL_NONE)
+        hash->prev[hash->next[id]] = hash->prev[id];
+}
+
+static void link_item(SpatialHash *hash, int id, int cx, int cy)
+{
+    unsigned b = hash_cell(hash, cx, cy);
+    hash->cell_x[id] = cx;
+    hash->cell_y[id] = cy;
+    hash->prev[id] = SPATIAL_NONE;
+    hash->next[id] = hash->buckets[b];
+    if (hash->buckets[b] != SPATIAL_NONE)
+        hash->prev[hash->buckets[b]] = id;
+    hash->buckets[b] = id;
+}
+
+bool SpatialHash_update(SpatialHash *hash, int id, Hitbox rect)
+{
+    if (!hash || id < 0)
+        return false;
+
+    if (id >= hash->capacity)
+    {
+        int capacity = hash->capacity;
+        while (capacity <= id)
+            capacity *= 2;
+        if (!SpatialHash_grow(hash, capacity))
+        {
+            fprintf(stderr, "Erreur d'allocation mémoire pour la table spatiale.\n");
+            return false;
+        }
+    }
+
+    int cx = cell_of(hash, rect.x);
+    int cy = cell_of(hash, rect.y);
+    hash->rect[id] = rect;
+    hash->max_w = fmaxf(hash->max_w, rect.width);
+    hash->max_h = fmaxf(hash->max_h, rect.height);
+
+    if (hash->used[id])
+    {
+        // Même cellule : seule la hitbox change
+        if (hash->cell_x[id] == cx && hash->cell_y[id] == cy)
+            return true;
+        unlink_item(hash, id);
+    }
+    hash->used[id] = 1;
+    link_item(hash, id, cx, cy);
+    return true;
+}
+
+void SpatialHash_remove(SpatialHash *hash, int id)
+{
+    if (!hash || id < 0 || id >= hash->capacity || !hash->used[id])
+        return;
+    unlink_item(hash, id);
+    hash->used[id] = 0;
+}
+
+int SpatialHash_query(SpatialHash *hash, Hitbox area, int *out, int max)
+{
+    if (!hash)
+        return 0;
+
+    // Un élément est rangé par son coin haut-gauche : il peut dépasser à gauche
+    // et en haut de sa cellule d'au plus sa taille
+    int x0 = cell_of(hash, area.x - hash->max_w), x1 = cell_of(hash, area.x + area.width);
+    int y0 = cell_of(hash, area.y - hash->max_h), y1 = cell_of(hash, area.y + area.height);
+
+    int count = 0;
+    for (int cy = y0; cy <= y1; cy++)
+    {
+        for (int cx = x0; cx <= x1; cx++)
+        {
+            for (int id = hash->buckets[hash_cell(hash, cx, cy)]; id != SPATIAL_NONE; id = hash->next[id])
+            {
+                if (hash->cell_x[id] != cx || hash->cell_y[id] != cy || !overlaps(hash->rect[id], area))
+                    continue;
+                if (count < max)
+                    out[count] = id;
+                count++;
+            }
+        }
+    }
+    return count < max ? count : max;
+}
+
+// Parcourt les cellules comme SpatialHash_query, sans limite de résultats :
+// un bloqueur n'est jamais ignoré, même dans une zone très peuplée
+bool SpatialHash_blocked(SpatialHash *hash, Hitbox from, Hitbox to, int self)
+{
+    if (!hash)
+        return false;
+
+    int x0 = cell_of(hash, to.x - hash->max_w), x1 = cell_of(hash, to.x + to.width);
+    int y0 = cell_of(hash, to.y - hash->max_h), y1 = cell_of(hash, to.y + to.height);
+    for (int cy = y0; cy <= y1; cy++)
+    {
+        for (int cx = x0; cx <= x1; cx++)
+        {
+            for (int id = hash->buckets[hash_cell(hash, cx, cy)]; id != SPATIAL_NONE; id = hash->next[id])
+            {
+                if (hash->cell_x[id] != cx || hash->cell_y[id] != cy || id == self)
+                    continue;
+                if (overlaps(hash->rect[id], to) && !overlaps(hash->rect[id], from))
+                    return true;
+            }
+        }
+    }
+    return false;
+}
@@ -0,0 +1,49 @@
+#ifndef SPATIAL_HASH_H
+#define SPATIAL_HASH_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "entity.h"
+
+// Table de hachage spatiale des hitbox des entités mobiles (joueur, PNJs).
+// Chaque élément est rangé dans la cellule de son coin haut-gauche et ne change
+// de liste que lorsqu'il passe d'une cellule à une autre. Une requête ne parcourt
+// que les cellules voisines de la zone demandée : O(1) par entité en moyenne.
+//
+// Les identifiants sont des petits entiers (slot d'entité + 1, 0 pour le joueur).
+
+#define SPATIAL_CELL_SIZE 32
+#define SPATIAL_ID_PLAYER 0
+#define SPATIAL_NONE -1
+
+typedef struct
+{
+    int cell_size;
+    int *buckets; // Premier élément de chaque liste, SPATIAL_NONE si vide
+    int bucket_mask;
+
+    // Par identifiant
+    int capacity;
+    int *next, *prev;
+    int *cell_x, *cell_y;
+    Hitbox *rect;  // Hitbox au dernier SpatialHash_update
+    uint8_t *used;
+
+    float max_w, max_h; // Plus grande hitbox rangée (étend les requêtes)
+} SpatialHash;
+
+SpatialHash *SpatialHash_create(int capacity, int cellSize);
+void SpatialHash_free(SpatialHash *hash);
+
+// Ajoute ou déplace un élément
+bool SpatialHash_update(SpatialHash *hash, int id, Hitbox rect);
+void SpatialHash_remove(SpatialHash *hash, int id);
+
+// Identifiants dont la hitbox chevauche 'area' (au plus 'max'), retourne leur nombre
+int SpatialHash_query(SpatialHash *hash, Hitbox area, int *out, int max);
+
+// Vrai si se déplacer de 'from' à 'to' fait entrer 'self' dans un autre élément.
+// Un chevauchement déjà présent en 'from' ne bloque pas, pour pouvoir se dégager.
+bool SpatialHash_blocked(SpatialHash *hash, Hitbox from, Hitbox to, int self);
+
+#endif
@@ -0,0 +1,196 @@
+#include "ambience.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Teintes clés de la journée, interpolées linéairement entre elles
+typedef struct
+{
+    int minutes;
+    Uint8 r, g, b;
+} TintKey;
+
+static const TintKey tint_keys[] = {
+    {0 * 60, 70, 80, 140},
+    {5 * 60, 80, 88, 150},
+    {7 * 60, 255, 200, 170},
+    {9 * 60, 255, 255, 255},
+    {17 * 60, 255, 255, 255},
+    {19 * 60, 255, 170, 130},
+    {21 * 60, 100, 100, 165},
+    {24 * 60, 70, 80, 140},
+};
+
+SDL_Color DayNight_tint(int minutes)
+{
+    minutes = ((minutes % DAY_MINUTES) + DAY_MINUTES) % DAY_MINUTES;
+    int k = 0;
+    while (tint_keys[k + 1].minutes <= minutes)
+        k++;
+
+    const TintKey *a = &tint_keys[k], *b = &tint_keys[k + 1];
+    int t = minutes - a->minutes, span = b->minutes - a->minutes;
+    return (SDL_Color){
+        (Uint8)(a->r + (b->r - a->r) * t / span),
+        (Uint8)(a->g + (b->g - a->g) * t / span),
+        (Uint8)(a->b + (b->b - a->b) * t / span),
+        255};
+}
+
+// Paramètres de chaque type de temps
+typedef struct
+{
+    const char *name;
+    int count;
+    float min_speed, max_speed;
+    float wind;
+    float width, length; // Taille d'une particule
+    SDL_Color color;
+} WeatherStyle;
+
+static const WeatherStyle styles[WEATHER_TYPE_COUNT] = {
+    [WEATHER_CLEAR] = {"clear", 0, 0, 0, 0, 0, 0, {0, 0, 0, 0}},
+    [WEATHER_RAIN] = {"rain", 320, 260, 360, -60, 1, 7, {170, 190, 230, 170}},
+    [WEATHER_SNOW] = {"snow", 220, 25, 55, 10, 2, 2, {250, 250, 255, 230}},
+};
+
+Weather *Weather_create(int width, int height, uint64_t seed)
+{
+    Weather *weather = calloc(1, sizeof(Weather));
+    if (!weather)
+    {
+        fprintf(stderr, "Erreur d'allocation mémoire pour la météo.\n");
+        return NULL;
+    }
+    weather->width = width;
+    weather->height = height;
+    Random_seed(&weather->rng, seed);
+
+    // Deux triangles par particule : 0 1 2, 2 1 3
+    for (int p = 0; p < WEATHER_MAX_PARTICLES; p++)
+    {
+        int *i = &weather->indices[p * 6], v = p * 4;
+        i[0] = v;
+        i[1] = v + 1;
+        i[2] = v + 2;
+        i[3] = v + 2;
+        i[4] = v + 1;
+        i[5] = v + 3;
+    }
+    return weather;
+}
+
+void Weather_free(Weather *weather)
+{
+    free(weather);
+}
+
+int Weather_parse(const char *name)
+{
+    for (int t = 0; t < WEATHER_TYPE_COUNT; t++)
+    {
+        if (name && strcmp(name, styles[t].name) == 0)
+            return t;
+    }
+    return -1;
+}
+
+static float random_float(Random *rng, float min, float max)
+{
+    return min + (max - min) * (Random_next(rng) / 4294967296.0f);
+}
+
+static void spawn(Weather *weather, int p, float y)
+{
+    const WeatherStyle *style = &styles[weather->type];
+    weather->x[p] = random_float(&weather->rng, 0, (float)weather->width);
+    weather->y[p] = y;
+    weather->speed[p] = random_float(&weather->rng, style->min_speed, style->max_speed);
+    weather->phase[p] = random_float(&weather->rng, 0, 6.2831853f);
+}
+
+void Weather_setType(Weather *weather, WeatherType type)
+{
+    if (type < 0 || type >= WEATHER_TYPE_COUNT || type == weather->type)
+        return;
+
+    const WeatherStyle *style = &styles[type];
+    weather->type = type;
+    weather->count = SDL_min(style->count, WEATHER_MAX_PARTICLES);
+    weather->wind = style->wind;
+
+    // Répartition sur tout l'écran pour ne pas voir arriver un front de particules
+    for (int p = 0; p < weather->count; p++)
+        spawn(weather, p, random_float(&weather->rng, 0, (float)weather->height));
+
+    // La couleur ne dépend que du type : posée une fois sur tous les sommets
+    for (int v = 0; v < weather->count * 4; v++)
+    {
+        weather->vertices[v].color = style->color;
+        weather->vertices[v].tex_coord = (SDL_FPoint){0, 0};
+    }
+}
+
+void Weather_update(Weather *weather, float deltaTime, int viewX, int viewY)
+{
+    if (weather->count == 0)
+        return;
+
+    // Déplacement de la caméra : les particules bougent à l'opposé, comme le monde
+    float dx = 0.0f, dy = 0.0f;
+    if (weather->has_view)
+    {
+        dx = (float)(weather->last_view_x - viewX);
+        dy = (float)(weather->last_view_y - viewY);
+    }
+    weather->last_view_x = viewX;
+    weather->last_view_y = viewY;
+    weather->has_view = true;
+
+    const float w = (float)weather->width, h = (float)weather->height;
+    const bool snow = weather->type == WEATHER_SNOW;
+    for (int p = 0; p < weather->count; p++)
+    {
+        float sway = 0.0f;
+        if (snow)
+        {
+            weather->phase[p] += deltaTime * 2.0f;
+            sway = sinf(weather->phase[p]) * 12.0f;
+        }
+        weather->x[p] += dx + (weather->wind + sway) * deltaTime;
+        weather->y[p] += dy + weather->speed[p] * deltaTime;
+
+        // Sortie par le bas : nouvelle particule en haut ; sur les côtés : bouclage
+        if (weather->y[p] > h)
+            spawn(weather, p, weather->y[p] - h - random_float(&weather->rng, 0, 16));
+        else if (weather->y[p] < -16.0f)
+            weather->y[p] += h;
+        if (weather->x[p] < 0.0f)
+            weather->x[p] += w;
+        else if (weather->x[p] >= w)
+            weather->x[p] -= w;
+    }
+}
+
+void Weather_render(Weather *weather, SDL_Renderer *renderer)
+{
+    if (weather->count == 0)
+        return;
+
+    // Goutte : trait incliné dans le sens du vent ; flocon : carré
+    const WeatherStyle *style = &styles[weather->type];
+    float slant = weather->type == WEATHER_RAIN ? weather->wind / style->max_speed * style->length : 0.0f;
+    for (int p = 0; p < weather->count; p++)
+    {
+        SDL_Vertex *v = &weather->vertices[p * 4];
+        float x = weather->x[p], y = weather->y[p];
+        v[0].position = (SDL_FPoint){x, y};
+        v[1].position = (SDL_FPoint){x + style->width, y};
+        v[2].position = (SDL_FPoint){x + slant, y + style->length};
+        v[3].position = (SDL_FPoint){x + slant + style->width, y + style->length};
+    }
+
+    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+    SDL_RenderGeometry(renderer, NULL, weather->vertices, weather->count * 4, weather->indices, weather->count * 6);
+}
@@ -0,0 +1,62 @@
+#ifndef AMBIENCE_H
+#define AMBIENCE_H
+
+#include <SDL2/SDL.h>
+#include <stdbool.h>
+#include "random.h"
+
+// Ambiance du monde, appliquée après coup à l'image du monde, pour un coût qui
+// ne dépend pas de la taille de la carte :
+//  - cycle jour/nuit : le monde est dessiné dans une texture cible, copiée à
+//    l'écran avec une teinte (SDL_SetTextureColorMod) selon l'heure ;
+//  - météo : un pool de particules de capacité fixe (tableaux par champ), toutes
+//    dessinées en un seul SDL_RenderGeometry.
+
+#define DAY_MINUTES (24 * 60)
+#define WEATHER_MAX_PARTICLES 512
+
+typedef enum
+{
+    WEATHER_CLEAR,
+    WEATHER_RAIN,
+    WEATHER_SNOW,
+    WEATHER_TYPE_COUNT
+} WeatherType;
+
+// Teinte du monde à 'minutes' depuis minuit (blanc en plein jour)
+SDL_Color DayNight_tint(int minutes);
+
+typedef struct
+{
+    WeatherType type;
+    int width, height; // Zone couverte (l'écran)
+    int count;         // Particules actives
+
+    // Particules, un tableau par champ, en coordonnées écran
+    float x[WEATHER_MAX_PARTICLES];
+    float y[WEATHER_MAX_PARTICLES];
+    float speed[WEATHER_MAX_PARTICLES]; // Pixels par seconde vers le bas
+    float phase[WEATHER_MAX_PARTICLES]; // Balancement des flocons
+
+    float wind;                   // Dérive horizontale, pixels par seconde
+    int last_view_x, last_view_y; // Caméra à la frame précédente
+    bool has_view;
+
+    SDL_Vertex vertices[WEATHER_MAX_PARTICLES * 4];
+    int indices[WEATHER_MAX_PARTICLES * 6]; // Remplis une fois
+    Random rng;
+} Weather;
+
+Weather *Weather_create(int width, int height, uint64_t seed);
+void Weather_free(Weather *weather);
+
+void Weather_setType(Weather *weather, WeatherType type);
+// "clear", "rain", "snow" ; -1 si inconnu
+int Weather_parse(const char *name);
+
+// Avance les particules ; (viewX, viewY) : coin de la caméra, pour que la pluie
+// reste accrochée au monde quand la caméra se déplace
+void Weather_update(Weather *weather, float deltaTime, int viewX, int viewY);
+void Weather_render(Weather *weather, SDL_Renderer *renderer);
+
+#endif
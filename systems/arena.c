@@ -0,0 +1,106 @@
+#include "arena.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#define ARENA_ALIGNMENT 16
+#define ARENA_HEADER_SIZE ((sizeof(ArenaBlock) + ARENA_ALIGNMENT - 1) & ~(size_t)(ARENA_ALIGNMENT - 1))
+
+static unsigned char *block_data(ArenaBlock *block)
+{
+    return (unsigned char *)block + ARENA_HEADER_SIZE;
+}
+
+static ArenaBlock *new_block(size_t size)
+{
+    ArenaBlock *block = malloc(ARENA_HEADER_SIZE + size);
+    if (!block)
+        return NULL;
+    block->next = NULL;
+    block->size = size;
+    block->used = 0;
+    return block;
+}
+
+Arena *Arena_create(size_t block_size)
+{
+    Arena *arena = malloc(sizeof(Arena));
+    if (!arena)
+        return NULL;
+
+    arena->block_size = block_size > 0 ? block_size : 64 * 1024;
+    arena->total_used = 0;
+    arena->head = new_block(arena->block_size);
+    if (!arena->head)
+    {
+        free(arena);
+        return NULL;
+    }
+    return arena;
+}
+
+void Arena_free(Arena *arena)
+{
+    if (!arena)
+        return;
+
+    ArenaBlock *block = arena->head;
+    while (block)
+    {
+        ArenaBlock *next = block->next;
+        free(block);
+        block = next;
+    }
+    free(arena);
+}
+
+void *Arena_alloc(Arena *arena, size_t size)
+{
+    if (!arena)
+        return NULL;
+
+    size_t aligned = (size + ARENA_ALIGNMENT - 1) & ~(size_t)(ARENA_ALIGNMENT - 1);
+    ArenaBlock *block = arena->head;
+
+    if (!block || block->used + aligned > block->size)
+    {
+        // Les grosses allocations ont leur propre bloc
+        size_t size_needed = aligned > arena->block_size ? aligned : arena->block_size;
+        ArenaBlock *fresh = new_block(size_needed);
+        if (!fresh)
+        {
+            fprintf(stderr, "Erreur d'allocation mémoire pour l'arena.\n");
+            return NULL;
+        }
+        fresh->next = block;
+        arena->head = fresh;
+        block = fresh;
+    }
+
+    void *p = block_data(block) + block->used;
+    block->used += aligned;
+    arena->total_used += aligned;
+    return p;
+}
+
+void *Arena_calloc(Arena *arena, size_t count, size_t size)
+{
+    if (size != 0 && count > SIZE_MAX / size)
+        return NULL;
+    void *p = Arena_alloc(arena, count * size);
+    if (p)
+        memset(p, 0, count * size);
+    return p;
+}
+
+char *Arena_strdup(Arena *arena, const char *str)
+{
+    if (!str)
+        return NULL;
+    size_t len = strlen(str) + 1;
+    char *copy = Arena_alloc(arena, len);
+    if (copy)
+        memcpy(copy, str, len);
+    return copy;
+}
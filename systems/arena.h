@@ -0,0 +1,33 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <stddef.h>
+
+// Allocateur linéaire par blocs : les allocations ne sont jamais libérées
+// individuellement, tout est rendu d'un coup par Arena_free.
+// Utilisé pour les données dont la durée de vie est celle d'une carte.
+
+typedef struct ArenaBlock
+{
+    struct ArenaBlock *next;
+    size_t size;
+    size_t used;
+    // Les données suivent l'en-tête
+} ArenaBlock;
+
+typedef struct
+{
+    ArenaBlock *head;  // Bloc courant (les précédents sont chaînés derrière)
+    size_t block_size; // Taille par défaut d'un nouveau bloc
+    size_t total_used; // Octets alloués (statistique)
+} Arena;
+
+Arena *Arena_create(size_t block_size);
+void Arena_free(Arena *arena);
+
+// Allocation alignée ; retourne NULL si la mémoire est épuisée
+void *Arena_alloc(Arena *arena, size_t size);
+void *Arena_calloc(Arena *arena, size_t count, size_t size);
+char *Arena_strdup(Arena *arena, const char *str);
+
+#endif
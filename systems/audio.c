@@ -0,0 +1,371 @@
+#include "audio.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Arrête une piste depuis le callback : le fichier sera fermé par AudioManager_update
+static void stop_stream(AudioStream *stream)
+{
+    stream->playing = false;
+    stream->finished = true;
+}
+
+// Ajoute 'frames' frames de la piste à l'accumulateur, en lisant le fichier par blocs
+static void mix_stream(AudioStream *stream, Sint32 *mix, int frames, float volume)
+{
+    int done = 0;
+    while (done < frames && stream->playing)
+    {
+        if (stream->position >= stream->frames)
+        {
+            if (!stream->loop || SDL_RWseek(stream->file, stream->data_start, RW_SEEK_SET) < 0)
+            {
+                stop_stream(stream);
+                break;
+            }
+            stream->position = 0;
+        }
+
+        Uint32 want = SDL_min((Uint32)(frames - done), stream->frames - stream->position);
+        want = SDL_min(want, AUDIO_STREAM_FRAMES);
+        size_t got = SDL_RWread(stream->file, stream->chunk, (size_t)stream->channels * sizeof(Sint16), want);
+        if (got == 0)
+        {
+            stop_stream(stream);
+            break;
+        }
+
+        Sint32 *out = mix + done * AUDIO_CHANNELS;
+        for (size_t i = 0; i < got; i++)
+        {
+            stream->gain += stream->gain_step;
+            if (stream->gain >= 1.0f)
+            {
+                stream->gain = 1.0f;
+                stream->gain_step = 0.0f;
+            }
+            else if (stream->gain <= 0.0f && stream->gain_step < 0.0f)
+            {
+                stop_stream(stream);
+                return;
+            }
+
+            float gain = stream->gain * volume;
+            Sint16 left = (Sint16)SDL_SwapLE16(stream->chunk[i * stream->channels]);
+            Sint16 right = stream->channels == 2 ? (Sint16)SDL_SwapLE16(stream->chunk[i * 2 + 1]) : left;
+            out[i * 2] += (Sint32)(left * gain);
+            out[i * 2 + 1] += (Sint32)(right * gain);
+        }
+        stream->position += (Uint32)got;
+        done += (int)got;
+    }
+}
+
+static void mix_voices(AudioManager *audio, Sint32 *mix, int frames)
+{
+    for (int v = 0; v < AUDIO_VOICES; v++)
+    {
+        AudioVoice *voice = &audio->voices[v];
+        if (!voice->sound)
+            continue;
+
+        float gain = voice->volume * audio->sound_volume;
+        Uint32 count = SDL_min((Uint32)frames, voice->sound->frames - voice->position);
+        const Sint16 *in = voice->sound->samples + voice->position * AUDIO_CHANNELS;
+        for (Uint32 i = 0; i < count * AUDIO_CHANNELS; i++)
+            mix[i] += (Sint32)(in[i] * gain);
+
+        voice->position += count;
+        if (voice->position >= voice->sound->frames)
+            voice->sound = NULL;
+    }
+}
+
+// Thread audio de SDL : mixe voix et musiques bloc par bloc dans l'accumulateur
+static void audio_callback(void *user, Uint8 *stream, int len)
+{
+    AudioManager *audio = user;
+    Sint16 *out = (Sint16 *)stream;
+    int total = len / (int)(AUDIO_CHANNELS * sizeof(Sint16));
+
+    while (total > 0)
+    {
+        int frames = SDL_min(total, AUDIO_BUFFER_FRAMES);
+        memset(audio->mix, 0, (size_t)frames * AUDIO_CHANNELS * sizeof(Sint32));
+
+        for (int m = 0; m < 2; m++)
+        {
+            if (audio->music[m].playing)
+                mix_stream(&audio->music[m], audio->mix, frames, audio->music_volume);
+        }
+        mix_voices(audio, audio->mix, frames);
+
+        for (int i = 0; i < frames * AUDIO_CHANNELS; i++)
+            out[i] = (Sint16)SDL_clamp(audio->mix[i], -32768, 32767);
+        out += frames * AUDIO_CHANNELS;
+        total -= frames;
+    }
+}
+
+AudioManager *AudioManager_create(void)
+{
+    if (SDL_InitSubSystem(SDL_INIT_AUDIO) < 0)
+    {
+        fprintf(stderr, "Audio indisponible, le jeu sera muet : %s\n", SDL_GetError());
+        return NULL;
+    }
+
+    AudioManager *audio = calloc(1, sizeof(AudioManager));
+    if (!audio)
+    {
+        fprintf(stderr, "Erreur d'allocation mémoire pour l'audio.\n");
+        SDL_QuitSubSystem(SDL_INIT_AUDIO);
+        return NULL;
+    }
+
+    // Format imposé (pas de changement autorisé) : SDL convertit si le matériel diffère
+    SDL_AudioSpec want;
+    SDL_zero(want);
+    want.freq = AUDIO_FREQUENCY;
+    want.format = AUDIO_S16SYS;
+    want.channels = AUDIO_CHANNELS;
+    want.samples = AUDIO_BUFFER_FRAMES;
+    want.callback = audio_callback;
+    want.userdata = audio;
+    audio->device = SDL_OpenAudioDevice(NULL, 0, &want, &audio->spec, 0);
+    if (!audio->device)
+    {
+        fprintf(stderr, "Audio indisponible, le jeu sera muet : %s\n", SDL_GetError());
+        free(audio);
+        SDL_QuitSubSystem(SDL_INIT_AUDIO);
+        return NULL;
+    }
+
+    audio->music_volume = 1.0f;
+    audio->sound_volume = 1.0f;
+    SDL_PauseAudioDevice(audio->device, 0);
+    return audio;
+}
+
+static void close_stream(AudioStream *stream)
+{
+    if (stream->file)
+        SDL_RWclose(stream->file);
+    stream->file = NULL;
+    stream->playing = false;
+    stream->finished = false;
+    stream->path[0] = '\0';
+}
+
+void AudioManager_free(AudioManager *audio)
+{
+    if (!audio)
+        return;
+    SDL_CloseAudioDevice(audio->device); // Attend la fin du callback en cours
+    for (int m = 0; m < 2; m++)
+        close_stream(&audio->music[m]);
+    for (int s = 0; s < audio->sound_count; s++)
+        free(audio->sounds[s].samples);
+    free(audio);
+    SDL_QuitSubSystem(SDL_INIT_AUDIO);
+}
+
+int AudioManager_loadSound(AudioManager *audio, const char *path)
+{
+    if (!audio || !path)
+        return -1;
+    for (int s = 0; s < audio->sound_count; s++)
+    {
+        if (strcmp(audio->sounds[s].path, path) == 0)
+            return s;
+    }
+    if (audio->sound_count >= AUDIO_MAX_SOUNDS)
+    {
+        fprintf(stderr, "Trop de bruitages chargés, %s ignoré\n", path);
+        return -1;
+    }
+
+    SDL_AudioSpec wav;
+    Uint8 *data;
+    Uint32 length;
+    if (!SDL_LoadWAV(path, &wav, &data, &length))
+    {
+        fprintf(stderr, "Erreur lors du chargement du son %s : %s\n", path, SDL_GetError());
+        return -1;
+    }
+
+    // Conversion unique au format du périphérique : le mixage n'est plus qu'une somme
+    SDL_AudioCVT cvt;
+    if (SDL_BuildAudioCVT(&cvt, wav.format, wav.channels, wav.freq, audio->spec.format, audio->spec.channels, audio->spec.freq) < 0)
+    {
+        fprintf(stderr, "Format du son %s non convertible : %s\n", path, SDL_GetError());
+        SDL_FreeWAV(data);
+        return -1;
+    }
+    cvt.len = (int)length;
+    cvt.buf = malloc((size_t)length * cvt.len_mult);
+    if (!cvt.buf)
+    {
+        fprintf(stderr, "Erreur d'allocation mémoire pour le son %s\n", path);
+        SDL_FreeWAV(data);
+        return -1;
+    }
+    memcpy(cvt.buf, data, length);
+    SDL_FreeWAV(data);
+    if (cvt.needed && SDL_ConvertAudio(&cvt) < 0)
+    {
+        fprintf(stderr, "Erreur lors de la conversion du son %s : %s\n", path, SDL_GetError());
+        free(cvt.buf);
+        return -1;
+    }
+
+    AudioSound *sound = &audio->sounds[audio->sound_count];
+    snprintf(sound->path, sizeof(sound->path), "%s", path);
+    sound->samples = (Sint16 *)cvt.buf;
+    sound->frames = (Uint32)((cvt.needed ? cvt.len_cvt : cvt.len) / (AUDIO_CHANNELS * sizeof(Sint16)));
+    return audio->sound_count++;
+}
+
+void AudioManager_playSound(AudioManager *audio, int sound, float volume)
+{
+    if (!audio || sound < 0 || sound >= audio->sound_count)
+        return;
+
+    SDL_LockAudioDevice(audio->device);
+    // Voix libre, sinon la plus ancienne
+    int chosen = 0;
+    for (int v = 0; v < AUDIO_VOICES; v++)
+    {
+        if (!audio->voices[v].sound)
+        {
+            chosen = v;
+            break;
+        }
+        if (audio->voices[v].started < audio->voices[chosen].started)
+            chosen = v;
+    }
+    audio->voices[chosen] = (AudioVoice){&audio->sounds[sound], 0, volume, ++audio->voice_clock};
+    SDL_UnlockAudioDevice(audio->device);
+}
+
+// En-tête WAV : seuls le PCM 16 bits mono ou stéréo, à la fréquence du
+// périphérique, sont lus en flux (pas de conversion dans le callback)
+static bool open_stream(AudioManager *audio, AudioStream *stream, const char *path)
+{
+    SDL_RWops *file = SDL_RWFromFile(path, "rb");
+    if (!file)
+    {
+        fprintf(stderr, "Erreur lors de l'ouverture de la musique %s : %s\n", path, SDL_GetError());
+        return false;
+    }
+
+    bool valid = SDL_ReadLE32(file) == 0x46464952 /* RIFF */;
+    SDL_ReadLE32(file);
+    valid = valid && SDL_ReadLE32(file) == 0x45564157 /* WAVE */;
+
+    int format = 0, channels = 0, bits = 0, frequency = 0;
+    Sint64 data_start = -1;
+    Uint32 data_size = 0;
+    while (valid && data_start < 0)
+    {
+        Uint32 id = SDL_ReadLE32(file), size = SDL_ReadLE32(file);
+        Sint64 next = SDL_RWtell(file) + size + (size & 1);
+        if (size == 0 && id == 0)
+            break;
+        if (id == 0x20746D66 /* fmt  */)
+        {
+            format = SDL_ReadLE16(file);
+            channels = SDL_ReadLE16(file);
+            frequency = (int)SDL_ReadLE32(file);
+            SDL_ReadLE32(file);
+            SDL_ReadLE16(file);
+            bits = SDL_ReadLE16(file);
+        }
+        else if (id == 0x61746164 /* data */)
+        {
+            data_start = SDL_RWtell(file);
+            data_size = size;
+            break;
+        }
+        if (SDL_RWseek(file, next, RW_SEEK_SET) < 0)
+            break;
+    }
+
+    if (!valid || data_start < 0 || format != 1 || bits != 16 || channels < 1 || channels > 2 || frequency != audio->spec.freq)
+    {
+        fprintf(stderr, "Musique %s : WAV PCM 16 bits mono ou stéréo à %d Hz attendu\n", path, audio->spec.freq);
+        SDL_RWclose(file);
+        return false;
+    }
+
+    stream->file = file;
+    snprintf(stream->path, sizeof(stream->path), "%s", path);
+    stream->channels = channels;
+    stream->data_start = data_start;
+    stream->frames = data_size / (Uint32)(channels * sizeof(Sint16));
+    stream->position = 0;
+    stream->loop = true;
+    stream->finished = false;
+    return true;
+}
+
+bool AudioManager_playMusic(AudioManager *audio, const char *path, int fadeMs)
+{
+    if (!audio)
+        return false;
+
+    AudioStream *current = &audio->music[audio->current];
+    SDL_LockAudioDevice(audio->device);
+    bool same = path && current->playing && current->gain_step >= 0.0f && strcmp(current->path, path) == 0;
+    SDL_UnlockAudioDevice(audio->device);
+    if (same)
+        return true;
+
+    // L'autre piste peut encore s'éteindre d'un fondu précédent : elle est coupée
+    int next_index = 1 - audio->current;
+    AudioStream *next = &audio->music[next_index];
+    SDL_LockAudioDevice(audio->device);
+    next->playing = false;
+    SDL_UnlockAudioDevice(audio->device);
+    close_stream(next);
+
+    bool opened = path && open_stream(audio, next, path);
+
+    float step = fadeMs > 0 ? 1000.0f / ((float)fadeMs * (float)audio->spec.freq) : 1.0f;
+    SDL_LockAudioDevice(audio->device);
+    if (current->playing)
+        current->gain_step = -step;
+    if (opened)
+    {
+        next->gain = fadeMs > 0 ? 0.0f : 1.0f;
+        next->gain_step = step;
+        next->playing = true;
+    }
+    audio->current = next_index;
+    SDL_UnlockAudioDevice(audio->device);
+    return opened || !path;
+}
+
+void AudioManager_setVolumes(AudioManager *audio, float music, float sounds)
+{
+    if (!audio)
+        return;
+    SDL_LockAudioDevice(audio->device);
+    audio->music_volume = SDL_clamp(music, 0.0f, 1.0f);
+    audio->sound_volume = SDL_clamp(sounds, 0.0f, 1.0f);
+    SDL_UnlockAudioDevice(audio->device);
+}
+
+void AudioManager_update(AudioManager *audio)
+{
+    if (!audio)
+        return;
+    for (int m = 0; m < 2; m++)
+    {
+        SDL_LockAudioDevice(audio->device);
+        bool finished = audio->music[m].finished;
+        SDL_UnlockAudioDevice(audio->device);
+        if (finished)
+            close_stream(&audio->music[m]);
+    }
+}
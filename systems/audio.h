@@ -0,0 +1,93 @@
+#ifndef AUDIO_H
+#define AUDIO_H
+
+#include <SDL2/SDL.h>
+#include <stdbool.h>
+
+// Son et musique sur l'audio de SDL (sans SDL_mixer), fichiers WAV :
+//  - les bruitages sont décodés une fois au format du périphérique et gardés
+//    dans un cache partagé (un identifiant par fichier) ;
+//  - un pool fixe de voix les mixe, la plus ancienne est reprise s'il est plein ;
+//  - la musique est lue depuis le disque par petits blocs dans le callback
+//    audio, deux flux permettent un fondu enchaîné au changement de carte.
+// Le callback n'alloue ni ne libère rien : ouvrir et fermer les fichiers se
+// fait sur le thread principal (AudioManager_playMusic, AudioManager_update).
+//
+// Fonctionne avec le pilote factice de SDL (SDL_AUDIODRIVER=dummy) pour les
+// tests sans carte son.
+
+#define AUDIO_FREQUENCY 44100
+#define AUDIO_CHANNELS 2
+#define AUDIO_BUFFER_FRAMES 1024
+#define AUDIO_VOICES 16
+#define AUDIO_MAX_SOUNDS 32
+#define AUDIO_STREAM_FRAMES 1024 // Taille d'une lecture de musique sur le disque
+#define AUDIO_PATH_MAX 128
+
+typedef struct
+{
+    char path[AUDIO_PATH_MAX];
+    Sint16 *samples; // Format du périphérique, entrelacé
+    Uint32 frames;
+} AudioSound;
+
+typedef struct
+{
+    const AudioSound *sound; // NULL : voix libre
+    Uint32 position;         // Frame suivante
+    float volume;
+    Uint32 started; // Ordre de lancement, pour reprendre la plus ancienne
+} AudioVoice;
+
+typedef struct
+{
+    SDL_RWops *file; // Ouvert et fermé sur le thread principal
+    char path[AUDIO_PATH_MAX];
+    int channels;      // 1 ou 2 dans le fichier
+    Sint64 data_start; // Début des échantillons dans le fichier
+    Uint32 frames;     // Frames de la piste
+    Uint32 position;
+    bool loop;
+
+    float gain, gain_step; // Fondu : gain courant, variation par frame
+    bool playing;
+    bool finished; // Arrêtée par le callback, fichier à fermer
+
+    Sint16 chunk[AUDIO_STREAM_FRAMES * 2];
+} AudioStream;
+
+typedef struct
+{
+    SDL_AudioDeviceID device;
+    SDL_AudioSpec spec;
+
+    AudioSound sounds[AUDIO_MAX_SOUNDS];
+    int sound_count;
+    AudioVoice voices[AUDIO_VOICES];
+    Uint32 voice_clock;
+
+    AudioStream music[2]; // Piste courante et piste qui s'éteint
+    int current;
+    float music_volume, sound_volume;
+
+    Sint32 mix[AUDIO_BUFFER_FRAMES * AUDIO_CHANNELS]; // Accumulateur du callback
+} AudioManager;
+
+// NULL si aucun périphérique audio n'a pu être ouvert (le jeu reste muet) ;
+// toutes les fonctions acceptent un gestionnaire NULL
+AudioManager *AudioManager_create(void);
+void AudioManager_free(AudioManager *audio);
+
+// Identifiant du bruitage 'path' (chargé au premier appel), -1 en cas d'erreur
+int AudioManager_loadSound(AudioManager *audio, const char *path);
+void AudioManager_playSound(AudioManager *audio, int sound, float volume);
+
+// Passe à la musique 'path' (NULL : silence) en fondu de 'fadeMs' millisecondes ;
+// ne fait rien si elle joue déjà
+bool AudioManager_playMusic(AudioManager *audio, const char *path, int fadeMs);
+void AudioManager_setVolumes(AudioManager *audio, float music, float sounds);
+
+// Thread principal, chaque frame : ferme les pistes terminées
+void AudioManager_update(AudioManager *audio);
+
+#endif
@@ -0,0 +1,187 @@
+#include "image_cache.h"
+#include <SDL2/SDL_image.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define IMAGE_CACHE_FORMAT SDL_PIXELFORMAT_ARGB8888
+#define IMAGE_CACHE_PATH_MAX 64
+
+// Date de modification à la nanoseconde : deux enregistrements dans la même
+// seconde (rechargement à chaud) ne doivent pas réutiliser l'ancienne entrée
+static int64_t modification_time(const struct stat *st)
+{
+#ifdef __APPLE__
+    return (int64_t)st->st_mtimespec.tv_sec * 1000000000LL + st->st_mtimespec.tv_nsec;
+#else
+    return (int64_t)st->st_mtim.tv_sec * 1000000000LL + st->st_mtim.tv_nsec;
+#endif
+}
+
+// Fichier du cache de 'path' : empreinte FNV-1a du chemin
+static void entry_path(const char *path, char *out, size_t size)
+{
+    uint64_t hash = 1469598103934665603ULL;
+    for (const unsigned char *c = (const unsigned char *)path; *c; c++)
+    {
+        hash ^= *c;
+        hash *= 1099511628211ULL;
+    }
+    snprintf(out, size, "%s/%016llx.img", IMAGE_CACHE_DIR, (unsigned long long)hash);
+}
+
+static bool entry_valid(const ImageCacheHeader *h, size_t size, const char *path, const struct stat *source)
+{
+    return size >= sizeof(ImageCacheHeader) &&
+           h->magic == IMAGE_CACHE_MAGIC &&
+           h->version == IMAGE_CACHE_VERSION &&
+           h->format == IMAGE_CACHE_FORMAT &&
+           h->source_mtime == modification_time(source) &&
+           h->source_size == (int64_t)source->st_size &&
+           strncmp(h->source, path, sizeof(h->source)) == 0 &&
+           h->width > 0 && h->height > 0 && h->pitch >= h->width * 4 &&
+           size == sizeof(ImageCacheHeader) + (size_t)h->pitch * h->height;
+}
+
+static SDL_Surface *map_entry(const char *path, const struct stat *source, ImageCacheMapping *mapping)
+{
+    char file[IMAGE_CACHE_PATH_MAX];
+    entry_path(path, file, sizeof(file));
+
+    int fd = open(file, O_RDONLY);
+    if (fd < 0)
+        return NULL;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(ImageCacheHeader))
+    {
+        close(fd);
+        return NULL;
+    }
+
+    // Copie à l'écriture : la surface peut modifier ses pixels sans toucher au fichier
+    void *data = mmap(NULL, st.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED)
+        return NULL;
+
+    const ImageCacheHeader *h = data;
+    SDL_Surface *surface = NULL;
+    if (entry_valid(h, st.st_size, path, source))
+    {
+        surface = SDL_CreateRGBSurfaceWithFormatFrom((char *)data + sizeof(ImageCacheHeader),
+                                                     h->width, h->height, 32, h->pitch, h->format);
+    }
+    if (!surface)
+    {
+        munmap(data, st.st_size);
+        return NULL;
+    }
+    mapping->data = data;
+    mapping->size = st.st_size;
+    return surface;
+}
+
+static void make_dirs(void)
+{
+    char dir[IMAGE_CACHE_PATH_MAX];
+    snprintf(dir, sizeof(dir), "%s", IMAGE_CACHE_DIR);
+    for (char *slash = strchr(dir, '/');; slash = strchr(slash + 1, '/'))
+    {
+        if (slash)
+            *slash = '\0';
+        if (mkdir(dir, 0755) != 0 && errno != EEXIST)
+        {
+            fprintf(stderr, "Impossible de créer le dossier %s\n", dir);
+            return;
+        }
+        if (!slash)
+            return;
+        *slash = '/';
+    }
+}
+
+// Fichier temporaire renommé une fois complet : une entrée lue n'est jamais à moitié écrite
+static void store_entry(const char *path, const struct stat *source, SDL_Surface *surface)
+{
+    if (strlen(path) >= IMAGE_CACHE_SOURCE_MAX)
+        return;
+
+    ImageCacheHeader h;
+    memset(&h, 0, sizeof(h));
+    h.magic = IMAGE_CACHE_MAGIC;
+    h.version = IMAGE_CACHE_VERSION;
+    h.source_mtime = modification_time(source);
+    h.source_size = source->st_size;
+    h.format = surface->format->format;
+    h.width = surface->w;
+    h.height = surface->h;
+    h.pitch = surface->pitch;
+    strcpy(h.source, path);
+
+    char file[IMAGE_CACHE_PATH_MAX], tmp[IMAGE_CACHE_PATH_MAX + 4];
+    entry_path(path, file, sizeof(file));
+    snprintf(tmp, sizeof(tmp), "%s.tmp", file);
+    make_dirs();
+
+    FILE *out = fopen(tmp, "wb");
+    if (!out)
+        return;
+    size_t pixels = (size_t)surface->pitch * surface->h;
+    bool ok = fwrite(&h, sizeof(h), 1, out) == 1 && fwrite(surface->pixels, 1, pixels, out) == pixels;
+    ok = (fclose(out) == 0) && ok;
+    ok = ok && rename(tmp, file) == 0;
+    if (!ok)
+        remove(tmp);
+}
+
+SDL_Surface *ImageCache_load(const char *path, ImageCacheMapping *mapping)
+{
+    mapping->data = NULL;
+    mapping->size = 0;
+
+    struct stat source;
+    if (stat(path, &source) != 0)
+        return NULL;
+
+    SDL_Surface *surface = map_entry(path, &source, mapping);
+    if (surface)
+        return surface;
+
+    // Absente ou périmée : décodage du PNG, au format du cache
+    SDL_Surface *decoded = IMG_Load(path);
+    if (!decoded)
+        return NULL;
+    surface = SDL_ConvertSurfaceFormat(decoded, IMAGE_CACHE_FORMAT, 0);
+    if (!surface)
+        return decoded;
+    SDL_FreeSurface(decoded);
+    store_entry(path, &source, surface);
+    return surface;
+}
+
+SDL_Surface *ImageCache_loadCopy(const char *path)
+{
+    ImageCacheMapping mapping;
+    SDL_Surface *surface = ImageCache_load(path, &mapping);
+    if (surface && mapping.data)
+    {
+        SDL_Surface *copy = SDL_DuplicateSurface(surface);
+        SDL_FreeSurface(surface);
+        surface = copy;
+    }
+    ImageCache_unmap(&mapping);
+    return surface;
+}
+
+void ImageCache_unmap(ImageCacheMapping *mapping)
+{
+    if (mapping->data)
+        munmap(mapping->data, mapping->size);
+    mapping->data = NULL;
+    mapping->size = 0;
+}
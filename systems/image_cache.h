@@ -0,0 +1,52 @@
+#ifndef IMAGE_CACHE_H
+#define IMAGE_CACHE_H
+
+#include <SDL2/SDL.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Cache disque des images décodées : le premier chargement d'un PNG écrit ses
+// pixels (ARGB8888) dans IMAGE_CACHE_DIR ; les suivants projettent ce fichier
+// avec mmap et en font directement les pixels de la surface, sans inflate zlib.
+//
+// Une entrée est identifiée par le chemin du PNG (nom du fichier : empreinte du
+// chemin) et n'est utilisée que si la date de modification et la taille du PNG
+// sont celles enregistrées à l'écriture ; sinon elle est réécrite. Comme la base
+// de données, le fichier est dans l'ordre des octets de la machine.
+
+#define IMAGE_CACHE_DIR "cache/images"
+#define IMAGE_CACHE_MAGIC 0x43494B50u // "PKIC"
+#define IMAGE_CACHE_VERSION 1
+#define IMAGE_CACHE_SOURCE_MAX 256
+
+typedef struct
+{
+    uint32_t magic;
+    uint32_t version;
+    int64_t source_mtime; // Nanosecondes
+    int64_t source_size;
+    uint32_t format; // SDL_PixelFormatEnum des pixels
+    int32_t width, height, pitch;
+    char source[IMAGE_CACHE_SOURCE_MAX]; // Chemin du PNG (empreintes en collision)
+    // Les pixels suivent l'en-tête
+} ImageCacheHeader;
+
+// Fichier projeté qui porte les pixels d'une surface
+typedef struct
+{
+    void *data;
+    size_t size;
+} ImageCacheMapping;
+
+// Image 'path' : projetée depuis le cache si l'entrée est à jour (les pixels
+// restent dans 'mapping' : libérer la surface avant ImageCache_unmap), sinon
+// décodée avec IMG_Load puis écrite dans le cache ('mapping' reste vide).
+// Utilisable depuis les threads de travail. NULL si l'image est illisible.
+SDL_Surface *ImageCache_load(const char *path, ImageCacheMapping *mapping);
+
+// Variante dont la surface possède ses pixels (copiés si l'entrée était projetée)
+SDL_Surface *ImageCache_loadCopy(const char *path);
+
+void ImageCache_unmap(ImageCacheMapping *mapping);
+
+#endif
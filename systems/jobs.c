@@ -0,0 +1,404 @@
+#include "jobs.h"
+#include <stdlib.h>
+#include <stdio.h>
+
+// ---------------------------------------------------------------------------
+// File sans verrou : chaque case porte un numéro de séquence qui indique si elle
+// est libre pour la position d'écriture courante ou pleine pour la lecture.
+// ---------------------------------------------------------------------------
+
+static bool JobQueue_init(JobQueue *queue, int size)
+{
+    queue->cells = malloc(size * sizeof(JobCell));
+    if (!queue->cells)
+        return false;
+    queue->mask = size - 1;
+    for (int i = 0; i < size; i++)
+        SDL_AtomicSet(&queue->cells[i].sequence, i);
+    SDL_AtomicSet(&queue->enqueue_pos, 0);
+    SDL_AtomicSet(&queue->dequeue_pos, 0);
+    return true;
+}
+
+static bool JobQueue_push(JobQueue *queue, const Job *job)
+{
+    int pos = SDL_AtomicGet(&queue->enqueue_pos);
+    JobCell *cell;
+    for (;;)
+    {
+        cell = &queue->cells[pos & queue->mask];
+        int diff = (int)((unsigned)SDL_AtomicGet(&cell->sequence) - (unsigned)pos);
+        if (diff == 0)
+        {
+            if (SDL_AtomicCAS(&queue->enqueue_pos, pos, (int)((unsigned)pos + 1)))
+                break;
+        }
+        else if (diff < 0)
+        {
+            return false; // Pleine
+        }
+        pos = SDL_AtomicGet(&queue->enqueue_pos);
+    }
+
+    cell->job = *job;
+    SDL_AtomicSet(&cell->sequence, (int)((unsigned)pos + 1)); // Publie la tâche
+    return true;
+}
+
+static bool JobQueue_pop(JobQueue *queue, Job *job)
+{
+    int pos = SDL_AtomicGet(&queue->dequeue_pos);
+    JobCell *cell;
+    for (;;)
+    {
+        cell = &queue->cells[pos & queue->mask];
+        int diff = (int)((unsigned)SDL_AtomicGet(&cell->sequence) - ((unsigned)pos + 1));
+        if (diff == 0)
+        {
+            if (SDL_AtomicCAS(&queue->dequeue_pos, pos, (int)((unsigned)pos + 1)))
+                break;
+        }
+        else if (diff < 0)
+        {
+            return false; // Vide
+        }
+        pos = SDL_AtomicGet(&queue->dequeue_pos);
+    }
+
+    *job = cell->job;
+    SDL_AtomicSet(&cell->sequence, (int)((unsigned)pos + queue->mask + 1)); // Libère la case
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+// Deques de vol de travail
+// ---------------------------------------------------------------------------
+
+// Propriétaire : retire l'intervalle du bas
+static bool JobDeque_pop(JobDeque *deque, int *begin, int *end)
+{
+    int b = SDL_AtomicGet(&deque->bottom) - 1;
+    SDL_AtomicSet(&deque->bottom, b);
+    int t = SDL_AtomicGet(&deque->top);
+    if (t > b)
+    {
+        SDL_AtomicSet(&deque->bottom, b + 1); // Vide
+        return false;
+    }
+
+    *begin = deque->begin[b];
+    *end = deque->end[b];
+    if (t == b)
+    {
+        // Dernier élément : course possible avec un voleur
+        bool won = SDL_AtomicCAS(&deque->top, t, t + 1);
+        SDL_AtomicSet(&deque->bottom, b + 1);
+        return won;
+    }
+    return true;
+}
+
+// Autres participants : volent l'intervalle du haut
+static bool JobDeque_steal(JobDeque *deque, int *begin, int *end)
+{
+    int t = SDL_AtomicGet(&deque->top);
+    int b = SDL_AtomicGet(&deque->bottom);
+    if (t >= b)
+        return false;
+
+    *begin = deque->begin[t];
+    *end = deque->end[t];
+    return SDL_AtomicCAS(&deque->top, t, t + 1);
+}
+
+// Traite des intervalles jusqu'à ce qu'il n'y en ait plus à prendre
+static void run_batch(JobSystem *jobs, int self)
+{
+    JobBatch *batch = &jobs->batch;
+    int participants = jobs->worker_count + 1;
+    int begin, end;
+
+    while (SDL_AtomicGet(&batch->remaining) > 0)
+    {
+        bool got = JobDeque_pop(&batch->deques[self], &begin, &end);
+        for (int k = 1; !got && k < participants; k++)
+            got = JobDeque_steal(&batch->deques[(self + k) % participants], &begin, &end);
+        if (!got)
+            return; // Les intervalles restants sont en cours de traitement ailleurs
+
+        batch->fn(batch->data, begin, end);
+        SDL_AtomicAdd(&batch->remaining, -1);
+    }
+}
+
+// Tâche soumise à chaque thread de travail au début d'un parallelFor
+static void help_batch(void *data, int worker)
+{
+    JobSystem *jobs = data;
+    JobBatch *batch = &jobs->batch;
+
+    // S'enregistrer avant de vérifier qu'un parallelFor est ouvert (génération
+    // impaire) : le thread principal attend les threads enregistrés avant de
+    // remplir à nouveau les deques. Une aide en retard sert le parallelFor suivant.
+    SDL_AtomicAdd(&batch->helpers, 1);
+    if (SDL_AtomicGet(&batch->generation) & 1)
+        run_batch(jobs, worker);
+    SDL_AtomicAdd(&batch->helpers, -1);
+}
+
+// ---------------------------------------------------------------------------
+// Threads de travail
+// ---------------------------------------------------------------------------
+
+static bool group_cancelled(const Job *job)
+{
+    return job->group && SDL_AtomicGet(&job->group->cancelled);
+}
+
+// 'mainThread' : tâche exécutée directement par JobSystem_submit (aucun thread de travail)
+static void finish_job(JobSystem *jobs, const Job *job, bool mainThread)
+{
+    if (job->complete && !group_cancelled(job) && !JobQueue_push(&jobs->completed, job))
+    {
+        if (mainThread)
+        {
+            // Personne d'autre ne viderait la file : appliquée tout de suite
+            job->complete(job->data);
+        }
+        else
+        {
+            // Le thread principal vide la file à chaque frame : attente très rare.
+            // Il ne la vide plus pendant JobSystem_free ni JobSystem_cancelGroup :
+            // 'complete' est alors abandonné
+            while (SDL_AtomicGet(&jobs->running) && !group_cancelled(job) && !JobQueue_push(&jobs->completed, job))
+                SDL_Delay(1);
+        }
+    }
+    // Après la publication du 'complete' : JobSystem_cancelGroup le trouve en file
+    if (job->group)
+        SDL_AtomicAdd(&job->group->pending, -1);
+}
+
+static int worker_main(void *data)
+{
+    JobWorker *worker = data;
+    JobSystem *jobs = worker->jobs;
+    Job job;
+
+    while (SDL_AtomicGet(&jobs->running))
+    {
+        if (JobQueue_pop(&jobs->pending, &job))
+        {
+            job.run(job.data, worker->index);
+            finish_job(jobs, &job, false);
+            continue;
+        }
+
+        // Se déclarer endormi avant de revérifier la file : une soumission
+        // concurrente voit alors 'sleeping' et poste le sémaphore
+        SDL_AtomicAdd(&jobs->sleeping, 1);
+        if (JobQueue_pop(&jobs->pending, &job))
+        {
+            SDL_AtomicAdd(&jobs->sleeping, -1);
+            job.run(job.data, worker->index);
+            finish_job(jobs, &job, false);
+            continue;
+        }
+        SDL_SemWaitTimeout(jobs->wake, 100);
+        SDL_AtomicAdd(&jobs->sleeping, -1);
+    }
+    return 0;
+}
+
+JobSystem *JobSystem_create(int workerCount)
+{
+    JobSystem *jobs = calloc(1, sizeof(JobSystem));
+    if (!jobs)
+        return NULL;
+
+    if (!JobQueue_init(&jobs->pending, JOB_QUEUE_SIZE) || !JobQueue_init(&jobs->completed, JOB_QUEUE_SIZE))
+    {
+        fprintf(stderr, "Erreur d'allocation mémoire pour le système de tâches.\n");
+        JobSystem_free(jobs);
+        return NULL;
+    }
+
+    jobs->wake = SDL_CreateSemaphore(0);
+    if (!jobs->wake)
+    {
+        fprintf(stderr, "Erreur de création du sémaphore: %s\n", SDL_GetError());
+        JobSystem_free(jobs);
+        return NULL;
+    }
+
+    if (workerCount <= 0)
+        workerCount = SDL_GetCPUCount() - 1;
+    if (workerCount < 1)
+        workerCount = 1;
+    if (workerCount > JOB_MAX_WORKERS)
+        workerCount = JOB_MAX_WORKERS;
+
+    SDL_AtomicSet(&jobs->running, 1);
+    for (int i = 0; i < workerCount; i++)
+    {
+        JobWorker *worker = &jobs->workers[i];
+        worker->jobs = jobs;
+        worker->index = i;
+        worker->thread = SDL_CreateThread(worker_main, "worker", worker);
+        if (!worker->thread)
+        {
+            // Sans thread, les tâches sont exécutées directement par JobSystem_submit
+            fprintf(stderr, "Erreur de création du thread de travail: %s\n", SDL_GetError());
+            break;
+        }
+        jobs->worker_count++;
+    }
+    return jobs;
+}
+
+void JobSystem_free(JobSystem *jobs)
+{
+    if (!jobs)
+        return;
+
+    SDL_AtomicSet(&jobs->running, 0);
+    for (int i = 0; i < jobs->worker_count; i++)
+        SDL_SemPost(jobs->wake);
+    for (int i = 0; i < jobs->worker_count; i++)
+        SDL_WaitThread(jobs->workers[i].thread, NULL);
+
+    if (jobs->wake)
+        SDL_DestroySemaphore(jobs->wake);
+    free(jobs->pending.cells);
+    free(jobs->completed.cells);
+    free(jobs);
+}
+
+bool JobSystem_submit(JobSystem *jobs, JobFunction run, JobCompleteFunction complete, void *data)
+{
+    return JobSystem_submitToGroup(jobs, NULL, run, complete, data);
+}
+
+bool JobSystem_submitToGroup(JobSystem *jobs, JobGroup *group, JobFunction run, JobCompleteFunction complete, void *data)
+{
+    Job job = {run, complete, data, group};
+    if (group)
+        SDL_AtomicAdd(&group->pending, 1);
+
+    if (jobs->worker_count == 0)
+    {
+        run(data, 0);
+        finish_job(jobs, &job, true);
+        return true;
+    }
+
+    if (!JobQueue_push(&jobs->pending, &job))
+    {
+        if (group)
+            SDL_AtomicAdd(&group->pending, -1);
+        return false;
+    }
+
+    if (SDL_AtomicGet(&jobs->sleeping) > 0)
+        SDL_SemPost(jobs->wake);
+    return true;
+}
+
+void JobSystem_parallelFor(JobSystem *jobs, int count, int grain, JobRangeFunction fn, void *data)
+{
+    if (count <= 0)
+        return;
+    if (grain < 1)
+        grain = 1;
+    if (!jobs || jobs->worker_count == 0 || count <= grain)
+    {
+        fn(data, 0, count);
+        return;
+    }
+
+    JobBatch *batch = &jobs->batch;
+    int participants = jobs->worker_count + 1;
+    int chunks = (count + grain - 1) / grain;
+    if (chunks > participants * JOB_DEQUE_SIZE)
+    {
+        chunks = participants * JOB_DEQUE_SIZE;
+        grain = (count + chunks - 1) / chunks;
+        chunks = (count + grain - 1) / grain;
+    }
+
+    // Intervalles contigus par participant, pour la localité
+    for (int p = 0; p < participants; p++)
+    {
+        JobDeque *deque = &batch->deques[p];
+        int first = p * chunks / participants;
+        int last = (p + 1) * chunks / participants;
+        int n = 0;
+        for (int c = last - 1; c >= first; c--) // Dépilés dans l'ordre croissant
+        {
+            deque->begin[n] = c * grain;
+            deque->end[n] = SDL_min((c + 1) * grain, count);
+            n++;
+        }
+        SDL_AtomicSet(&deque->top, 0);
+        SDL_AtomicSet(&deque->bottom, n);
+    }
+
+    batch->fn = fn;
+    batch->data = data;
+    SDL_AtomicSet(&batch->remaining, chunks);
+    SDL_AtomicAdd(&batch->generation, 1); // Ouvre le parallelFor
+
+    for (int i = 0; i < jobs->worker_count; i++)
+    {
+        if (!JobSystem_submit(jobs, help_batch, NULL, jobs))
+            break; // File pleine : le thread principal fera le reste
+    }
+
+    run_batch(jobs, jobs->worker_count);
+    while (SDL_AtomicGet(&batch->remaining) > 0)
+        SDL_Delay(0); // Derniers intervalles en cours sur d'autres threads
+
+    // Fermer le parallelFor : les aides en retard ne toucheront plus aux deques
+    SDL_AtomicAdd(&batch->generation, 1);
+    while (SDL_AtomicGet(&batch->helpers) > 0)
+        SDL_Delay(0);
+}
+
+int JobSystem_update(JobSystem *jobs)
+{
+    if (!jobs)
+        return 0;
+
+    int count = 0;
+    Job job;
+    while (JobQueue_pop(&jobs->completed, &job))
+    {
+        if (!job.complete)
+            continue; // Retirée par JobSystem_cancelGroup
+        job.complete(job.data);
+        count++;
+    }
+    return count;
+}
+
+void JobSystem_cancelGroup(JobSystem *jobs, JobGroup *group)
+{
+    if (!jobs || !group)
+        return;
+    SDL_AtomicSet(&group->cancelled, 1);
+    while (SDL_AtomicGet(&group->pending) > 0)
+        SDL_Delay(0);
+
+    // Le thread principal est le seul à dépiler : les cases publiées entre les deux
+    // positions ne bougent pas. Toutes celles du groupe le sont, les autres cases
+    // (en cours d'écriture par un thread de travail) sont ignorées.
+    JobQueue *queue = &jobs->completed;
+    unsigned end = (unsigned)SDL_AtomicGet(&queue->enqueue_pos);
+    for (unsigned pos = (unsigned)SDL_AtomicGet(&queue->dequeue_pos); pos != end; pos++)
+    {
+        JobCell *cell = &queue->cells[pos & queue->mask];
+        if ((unsigned)SDL_AtomicGet(&cell->sequence) == pos + 1 && cell->job.group == group)
+            cell->job.complete = NULL;
+    }
+    SDL_AtomicSet(&group->cancelled, 0);
+}
@@ -0,0 +1,123 @@
+#ifndef JOBS_H
+#define JOBS_H
+
+#include <SDL2/SDL.h>
+#include <stdbool.h>
+
+// Système de tâches : un groupe fixe de threads exécute les tâches soumises par
+// le thread principal. Les files sont sans verrou (anneaux bornés à numéros de
+// séquence, atomiques SDL) ; un sémaphore réveille seulement les threads endormis.
+//
+// Une tâche a deux fonctions : 'run' sur un thread de travail, puis 'complete'
+// sur le thread principal, lors du JobSystem_update suivant. C'est dans
+// 'complete' que les résultats sont appliqués à l'état du jeu.
+//
+// JobSystem_parallelFor découpe une boucle en intervalles répartis dans une deque
+// par participant (threads de travail + thread principal). Chacun dépile les
+// siens puis vole ceux des autres quand il n'en a plus (vol de travail).
+
+#define JOB_MAX_WORKERS 8
+#define JOB_QUEUE_SIZE 1024 // Puissance de 2
+#define JOB_DEQUE_SIZE 256  // Intervalles max par participant d'un parallelFor
+
+// 'worker' : indice du thread dans [0, worker_count[, pour une mémoire de travail par thread
+typedef void (*JobFunction)(void *data, int worker);
+typedef void (*JobCompleteFunction)(void *data);
+// Traite les indices [begin, end[ ; ne doit écrire que dans son intervalle
+typedef void (*JobRangeFunction)(void *data, int begin, int end);
+
+// Tâches d'un même propriétaire, pour les attendre sans appliquer celles des autres
+typedef struct
+{
+    SDL_atomic_t pending;   // Soumises et pas encore terminées (leur 'complete' peut rester en file)
+    SDL_atomic_t cancelled; // Pendant JobSystem_cancelGroup : les 'complete' ne sont plus mis en file
+} JobGroup;
+
+typedef struct
+{
+    JobFunction run;
+    JobCompleteFunction complete; // Peut être NULL
+    void *data;
+    JobGroup *group;              // Peut être NULL
+} Job;
+
+typedef struct
+{
+    SDL_atomic_t sequence;
+    Job job;
+} JobCell;
+
+// File circulaire bornée multi-producteurs / multi-consommateurs
+typedef struct
+{
+    JobCell *cells;
+    int mask;
+    SDL_atomic_t enqueue_pos;
+    SDL_atomic_t dequeue_pos;
+} JobQueue;
+
+// Deque de Chase-Lev, remplie par le thread principal avant le début du parallelFor :
+// son propriétaire dépile en bas, les autres participants volent en haut
+typedef struct
+{
+    SDL_atomic_t top;
+    SDL_atomic_t bottom;
+    int begin[JOB_DEQUE_SIZE];
+    int end[JOB_DEQUE_SIZE];
+} JobDeque;
+
+// parallelFor en cours
+typedef struct
+{
+    JobRangeFunction fn;
+    void *data;
+    SDL_atomic_t remaining;  // Intervalles pas encore terminés
+    SDL_atomic_t generation; // Impaire pendant un parallelFor, paire sinon
+    SDL_atomic_t helpers;    // Threads de travail occupés sur ce parallelFor
+    JobDeque deques[JOB_MAX_WORKERS + 1]; // Le dernier utilisé est celui du thread principal
+} JobBatch;
+
+typedef struct
+{
+    struct JobSystem *jobs;
+    int index;
+    SDL_Thread *thread;
+} JobWorker;
+
+typedef struct JobSystem
+{
+    int worker_count;
+    JobWorker workers[JOB_MAX_WORKERS];
+
+    JobQueue pending;   // Thread principal -> threads de travail
+    JobQueue completed; // Threads de travail -> thread principal
+
+    SDL_sem *wake;
+    SDL_atomic_t sleeping; // Threads en attente sur 'wake'
+    SDL_atomic_t running;
+
+    JobBatch batch;
+} JobSystem;
+
+// 'workerCount' <= 0 : un thread par cœur moins le thread principal
+JobSystem *JobSystem_create(int workerCount);
+// Attend la fin des tâches en cours ; les 'complete' non appliqués sont perdus
+void JobSystem_free(JobSystem *jobs);
+
+// Retourne false si la file est pleine (la tâche n'est pas soumise)
+bool JobSystem_submit(JobSystem *jobs, JobFunction run, JobCompleteFunction complete, void *data);
+// Idem, la tâche est comptée dans 'group'
+bool JobSystem_submitToGroup(JobSystem *jobs, JobGroup *group, JobFunction run, JobCompleteFunction complete, void *data);
+// Thread principal : attend la fin des tâches de 'group' et retire leurs 'complete'
+// de la file, sans appliquer ceux des autres propriétaires
+void JobSystem_cancelGroup(JobSystem *jobs, JobGroup *group);
+
+// Thread principal : applique les tâches terminées, retourne leur nombre
+int JobSystem_update(JobSystem *jobs);
+
+// Thread principal : appelle fn sur [0, count[ découpé en intervalles de 'grain'
+// indices, en parallèle, et retourne quand tout est traité. Le résultat ne dépend
+// pas du découpage si chaque indice est indépendant des autres.
+void JobSystem_parallelFor(JobSystem *jobs, int count, int grain, JobRangeFunction fn, void *data);
+
+#endif
@@ -0,0 +1,623 @@
+#include "pathfinding.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+
+#define COST_STRAIGHT 10
+#define COST_DIAGONAL 14
+
+static inline bool walkable(const NavGrid *grid, int x, int y)
+{
+    return x >= 0 && y >= 0 && x < grid->width && y < grid->height && !grid->blocked[y * grid->width + x];
+}
+
+bool Pathfinder_isBlocked(const NavGrid *grid, int x, int y)
+{
+    return !walkable(grid, x, y);
+}
+
+static inline int sign(int v)
+{
+    return (v > 0) - (v < 0);
+}
+
+// Distance octile entre deux nœuds (aussi utilisée comme heuristique)
+static uint32_t octile(const NavGrid *grid, int a, int b)
+{
+    int dx = abs(a % grid->width - b % grid->width);
+    int dy = abs(a / grid->width - b / grid->width);
+    int dmin = dx < dy ? dx : dy;
+    int dmax = dx < dy ? dy : dx;
+    return (uint32_t)(COST_DIAGONAL * dmin + COST_STRAIGHT * (dmax - dmin));
+}
+
+// ---------------------------------------------------------------------------
+// Tas binaire (min sur f)
+// ---------------------------------------------------------------------------
+
+static void heap_swap(PathSearch *s, int i, int j)
+{
+    int32_t n = s->heap[i];
+    uint32_t f = s->heap_f[i];
+    s->heap[i] = s->heap[j];
+    s->heap_f[i] = s->heap_f[j];
+    s->heap[j] = n;
+    s->heap_f[j] = f;
+    s->heap_index[s->heap[i]] = i;
+    s->heap_index[s->heap[j]] = j;
+}
+
+static void heap_up(PathSearch *s, int i)
+{
+    while (i > 0)
+    {
+        int parent = (i - 1) / 2;
+        if (s->heap_f[parent] <= s->heap_f[i])
+            break;
+        heap_swap(s, i, parent);
+        i = parent;
+    }
+}
+
+static void heap_down(PathSearch *s, int i)
+{
+    for (;;)
+    {
+        int left = 2 * i + 1;
+        int right = left + 1;
+        int smallest = i;
+        if (left < s->heap_count && s->heap_f[left] < s->heap_f[smallest])
+            smallest = left;
+        if (right < s->heap_count && s->heap_f[right] < s->heap_f[smallest])
+            smallest = right;
+        if (smallest == i)
+            break;
+        heap_swap(s, i, smallest);
+        i = smallest;
+    }
+}
+
+static void heap_push_or_update(PathSearch *s, int node, uint32_t f)
+{
+    int i = s->heap_index[node];
+    if (i < 0)
+    {
+        i = s->heap_count++;
+        s->heap[i] = node;
+        s->heap_index[node] = i;
+    }
+    s->heap_f[i] = f;
+    heap_up(s, i);
+}
+
+static int heap_pop(PathSearch *s)
+{
+    int node = s->heap[0];
+    s->heap_index[node] = -1;
+    s->heap_count--;
+    if (s->heap_count > 0)
+    {
+        s->heap[0] = s->heap[s->heap_count];
+        s->heap_f[0] = s->heap_f[s->heap_count];
+        s->heap_index[s->heap[0]] = 0;
+        heap_down(s, 0);
+    }
+    return node;
+}
+
+// ---------------------------------------------------------------------------
+// Jump Point Search (diagonales autorisées seulement si les deux voisins
+// orthogonaux sont libres : pas de coin coupé)
+// ---------------------------------------------------------------------------
+
+// Saut en ligne droite depuis (x, y) dans la direction (dx, dy)
+// Retourne le point de saut trouvé ou -1
+static int jump_straight(const NavGrid *grid, int x, int y, int dx, int dy, int goal, int *work)
+{
+    for (;;)
+    {
+        if (!walkable(grid, x, y))
+            return -1;
+        (*work)++;
+
+        int node = y * grid->width + x;
+        if (node == goal)
+            return node;
+
+        // Voisin forcé : une ouverture latérale qui n'existait pas à la case précédente
+        if (dx != 0)
+        {
+            if ((walkable(grid, x, y - 1) && !walkable(grid, x - dx, y - 1)) ||
+                (walkable(grid, x, y + 1) && !walkable(grid, x - dx, y + 1)))
+                return node;
+        }
+        else
+        {
+            if ((walkable(grid, x - 1, y) && !walkable(grid, x - 1, y - dy)) ||
+                (walkable(grid, x + 1, y) && !walkable(grid, x + 1, y - dy)))
+                return node;
+        }
+
+        x += dx;
+        y += dy;
+    }
+}
+
+static int jump(const NavGrid *grid, int x, int y, int dx, int dy, int goal, int *work)
+{
+    if (dx == 0 || dy == 0)
+        return jump_straight(grid, x, y, dx, dy, goal, work);
+
+    for (;;)
+    {
+        if (!walkable(grid, x, y))
+            return -1;
+        (*work)++;
+
+        int node = y * grid->width + x;
+        if (node == goal)
+            return node;
+
+        // Un point de saut est atteignable horizontalement ou verticalement
+        if (jump_straight(grid, x + dx, y, dx, 0, goal, work) >= 0 ||
+            jump_straight(grid, x, y + dy, 0, dy, goal, work) >= 0)
+            return node;
+
+        if (!walkable(grid, x + dx, y) || !walkable(grid, x, y + dy))
+            return -1;
+        x += dx;
+        y += dy;
+    }
+}
+
+// Directions à explorer depuis un nœud, selon la direction d'arrivée
+static int find_neighbors(const NavGrid *grid, int x, int y, int dx, int dy, int dirs[8][2])
+{
+    int n = 0;
+
+    if (dx == 0 && dy == 0)
+    {
+        // Nœud de départ : toutes les directions
+        for (int j = -1; j <= 1; j++)
+            for (int i = -1; i <= 1; i++)
+            {
+                if (i == 0 && j == 0)
+                    continue;
+                if (!walkable(grid, x + i, y + j))
+                    continue;
+                if (i != 0 && j != 0 && (!walkable(grid, x + i, y) || !walkable(grid, x, y + j)))
+                    continue;
+                dirs[n][0] = i;
+                dirs[n][1] = j;
+                n++;
+            }
+        return n;
+    }
+
+    if (dx != 0 && dy != 0)
+    {
+        bool vertical = walkable(grid, x, y + dy);
+        bool horizontal = walkable(grid, x + dx, y);
+        if (vertical)
+        {
+            dirs[n][0] = 0;
+            dirs[n][1] = dy;
+            n++;
+        }
+        if (horizontal)
+        {
+            dirs[n][0] = dx;
+            dirs[n][1] = 0;
+            n++;
+        }
+        if (vertical && horizontal)
+        {
+            dirs[n][0] = dx;
+            dirs[n][1] = dy;
+            n++;
+        }
+        return n;
+    }
+
+    // Déplacement droit : la direction elle-même, plus les ouvertures latérales
+    int px = dy != 0 ? 1 : 0; // Axe perpendiculaire
+    int py = dx != 0 ? 1 : 0;
+    bool next = walkable(grid, x + dx, y + dy);
+    bool sideA = walkable(grid, x + px, y + py);
+    bool sideB = walkable(grid, x - px, y - py);
+
+    if (next)
+    {
+        dirs[n][0] = dx;
+        dirs[n][1] = dy;
+        n++;
+        if (sideA)
+        {
+            dirs[n][0] = dx + px;
+            dirs[n][1] = dy + py;
+            n++;
+        }
+        if (sideB)
+        {
+            dirs[n][0] = dx - px;
+            dirs[n][1] = dy - py;
+            n++;
+        }
+    }
+    if (sideA)
+    {
+        dirs[n][0] = px;
+        dirs[n][1] = py;
+        n++;
+    }
+    if (sideB)
+    {
+        dirs[n][0] = -px;
+        dirs[n][1] = -py;
+        n++;
+    }
+    return n;
+}
+
+// ---------------------------------------------------------------------------
+// Recherche
+// ---------------------------------------------------------------------------
+
+bool PathSearch_init(PathSearch *search, Arena *arena, const NavGrid *grid)
+{
+    size_t cells = (size_t)grid->width * grid->height;
+    memset(search, 0, sizeof(PathSearch));
+
+    search->g = Arena_alloc(arena, cells * sizeof(uint32_t));
+    search->parent = Arena_alloc(arena, cells * sizeof(int32_t));
+    search->stamp = Arena_calloc(arena, cells, sizeof(uint32_t));
+    search->closed = Arena_calloc(arena, cells, sizeof(uint32_t));
+    search->heap = Arena_alloc(arena, cells * sizeof(int32_t));
+    search->heap_f = Arena_alloc(arena, cells * sizeof(uint32_t));
+    search->heap_index = Arena_alloc(arena, cells * sizeof(int32_t));
+
+    if (!search->g || !search->parent || !search->stamp || !search->closed ||
+        !search->heap || !search->heap_f || !search->heap_index)
+    {
+        fprintf(stderr, "Erreur d'allocation mémoire pour la recherche de chemin.\n");
+        return false;
+    }
+    search->status = PATH_NOT_FOUND;
+    return true;
+}
+
+static void open_node(PathSearch *s, const NavGrid *grid, int node, int parent, uint32_t g)
+{
+    if (s->stamp[node] != s->search_id)
+    {
+        s->stamp[node] = s->search_id;
+        s->heap_index[node] = -1;
+    }
+    s->g[node] = g;
+    s->parent[node] = parent;
+    heap_push_or_update(s, node, g + octile(grid, node, s->goal_node));
+}
+
+PathStatus PathSearch_begin(PathSearch *search, const NavGrid *grid, SDL_Point start, SDL_Point goal)
+{
+    search->heap_count = 0;
+    if (!walkable(grid, start.x, start.y) || !walkable(grid, goal.x, goal.y))
+    {
+        search->status = PATH_NOT_FOUND;
+        return search->status;
+    }
+
+    search->search_id++;
+    if (search->search_id == 0)
+    {
+        // Rebouclage du compteur : les anciens tampons redeviendraient valides
+        size_t cells = (size_t)grid->width * grid->height;
+        memset(search->stamp, 0, cells * sizeof(uint32_t));
+        memset(search->closed, 0, cells * sizeof(uint32_t));
+        search->search_id = 1;
+    }
+
+    search->start_node = start.y * grid->width + start.x;
+    search->goal_node = goal.y * grid->width + goal.x;
+    open_node(search, grid, search->start_node, -1, 0);
+    search->status = PATH_SEARCHING;
+    return search->status;
+}
+
+PathStatus PathSearch_step(PathSearch *search, const NavGrid *grid, int *budget)
+{
+    while (search->status == PATH_SEARCHING && *budget > 0)
+    {
+        if (search->heap_count == 0)
+        {
+            search->status = PATH_NOT_FOUND;
+            break;
+        }
+
+        int node = heap_pop(search);
+        search->closed[node] = search->search_id;
+        if (node == search->goal_node)
+        {
+            search->status = PATH_FOUND;
+            break;
+        }
+
+        int x = node % grid->width;
+        int y = node / grid->width;
+        int dx = 0, dy = 0;
+        if (search->parent[node] >= 0)
+        {
+            dx = sign(x - search->parent[node] % grid->width);
+            dy = sign(y - search->parent[node] / grid->width);
+        }
+
+        int dirs[8][2];
+        int count = find_neighbors(grid, x, y, dx, dy, dirs);
+        int work = 1;
+        for (int i = 0; i < count; i++)
+        {
+            int jp = jump(grid, x + dirs[i][0], y + dirs[i][1], dirs[i][0], dirs[i][1], search->goal_node, &work);
+            if (jp < 0 || search->closed[jp] == search->search_id)
+                continue;
+
+            uint32_t g = search->g[node] + octile(grid, node, jp);
+            if (search->stamp[jp] != search->search_id || g < search->g[jp])
+                open_node(search, grid, jp, node, g);
+        }
+        *budget -= work;
+    }
+    return search->status;
+}
+
+static void path_append(Path *path, int x, int y)
+{
+    if (path->count >= PATH_MAX_POINTS)
+    {
+        path->truncated = true;
+        return;
+    }
+    path->points[path->count].x = x;
+    path->points[path->count].y = y;
+    path->count++;
+}
+
+void PathSearch_buildPath(PathSearch *search, const NavGrid *grid, Path *path)
+{
+    path->count = 0;
+    path->truncated = false;
+    if (search->status != PATH_FOUND)
+        return;
+
+    // Points de saut du but vers le départ (le tas n'est plus utilisé)
+    int32_t *jumps = search->heap;
+    int jumpCount = 0;
+    for (int node = search->goal_node; node >= 0; node = search->parent[node])
+        jumps[jumpCount++] = node;
+
+    // Chaque saut suit une seule direction (droite ou diagonale) : les points de
+    // saut suffisent, deux sauts alignés sont fusionnés en un seul segment
+    int x = search->start_node % grid->width;
+    int y = search->start_node / grid->width;
+    int lastDx = 0, lastDy = 0;
+    for (int i = jumpCount - 2; i >= 0; i--)
+    {
+        int tx = jumps[i] % grid->width;
+        int ty = jumps[i] / grid->width;
+        int dx = sign(tx - x), dy = sign(ty - y);
+        if (path->count > 0 && dx == lastDx && dy == lastDy)
+            path->count--;
+        path_append(path, tx, ty);
+        if (path->truncated)
+            break;
+        x = tx;
+        y = ty;
+        lastDx = dx;
+        lastDy = dy;
+    }
+}
+
+// ---------------------------------------------------------------------------
+// File de requêtes
+// ---------------------------------------------------------------------------
+
+Pathfinder *Pathfinder_create(Arena *arena, int width, int height, int tileSize)
+{
+    Pathfinder *pf = Arena_calloc(arena, 1, sizeof(Pathfinder));
+    if (!pf)
+    {
+        fprintf(stderr, "Erreur d'allocation mémoire pour le pathfinder.\n");
+        return NULL;
+    }
+
+    pf->grid.width = width;
+    pf->grid.height = height;
+    pf->grid.tile_size = tileSize;
+    pf->grid.blocked = Arena_calloc(arena, (size_t)width * height, sizeof(uint8_t));
+    if (!pf->grid.blocked || !PathSearch_init(&pf->search, arena, &pf->grid))
+    {
+        fprintf(stderr, "Erreur d'allocation mémoire pour la grille de navigation.\n");
+        return NULL;
+    }
+    pf->next_id = 1;
+    return pf;
+}
+
+void Pathfinder_setBlocked(Pathfinder *pf, int x, int y, bool blocked)
+{
+    if (x < 0 || y < 0 || x >= pf->grid.width || y >= pf->grid.height)
+        return;
+    pf->grid.blocked[y * pf->grid.width + x] = blocked ? 1 : 0;
+}
+
+int Pathfinder_request(Pathfinder *pf, SDL_Point start, SDL_Point goal, PathCallback callback, void *user)
+{
+    if (pf->request_count >= PATH_MAX_REQUESTS)
+    {
+        fprintf(stderr, "File de recherche de chemin pleine.\n");
+        return -1;
+    }
+
+    PathRequest *req = &pf->requests[(pf->request_head + pf->request_count) % PATH_MAX_REQUESTS];
+    req->id = pf->next_id++;
+    if (pf->next_id < 0)
+        pf->next_id = 1;
+    req->start = start;
+    req->goal = goal;
+    req->callback = callback;
+    req->user = user;
+    req->cancelled = false;
+    pf->request_count++;
+    return req->id;
+}
+
+void Pathfinder_cancel(Pathfinder *pf, int requestId)
+{
+    // Une recherche déjà partie sur un thread se termine, mais sans callback
+    for (int i = 0; pf->job_slots && i < PATH_MAX_JOBS; i++)
+    {
+        if (pf->job_slots[i].in_use && pf->job_slots[i].request.id == requestId)
+        {
+            pf->job_slots[i].request.cancelled = true;
+            return;
+        }
+    }
+
+    for (int i = 0; i < pf->request_count; i++)
+    {
+        PathRequest *req = &pf->requests[(pf->request_head + i) % PATH_MAX_REQUESTS];
+        if (req->id == requestId)
+        {
+            req->cancelled = true;
+            return;
+        }
+    }
+}
+
+// Thread de travail : recherche complète, sans budget
+static void run_path_job(void *data, int worker)
+{
+    PathJob *job = data;
+    Pathfinder *pf = job->pf;
+    PathSearch *search = &pf->worker_search[worker];
+    int budget = INT32_MAX;
+
+    PathSearch_begin(search, &pf->grid, job->request.start, job->request.goal);
+    job->status = PathSearch_step(search, &pf->grid, &budget);
+    PathSearch_buildPath(search, &pf->grid, &job->path);
+}
+
+// Thread principal, au JobSystem_update suivant
+static void complete_path_job(void *data)
+{
+    PathJob *job = data;
+    job->in_use = false;
+    if (!job->request.cancelled && job->request.callback)
+        job->request.callback(job->request.user, job->status, &job->path);
+}
+
+static PathJob *find_free_job(Pathfinder *pf)
+{
+    for (int i = 0; i < PATH_MAX_JOBS; i++)
+        if (!pf->job_slots[i].in_use)
+            return &pf->job_slots[i];
+    return NULL;
+}
+
+static void submit_requests(Pathfinder *pf)
+{
+    while (pf->request_count > 0)
+    {
+        PathRequest *req = &pf->requests[pf->request_head];
+        if (!req->cancelled)
+        {
+            PathJob *job = find_free_job(pf);
+            if (!job)
+                return; // Tous les emplacements sont pris : reprise à la frame suivante
+
+            job->pf = pf;
+            job->request = *req;
+            job->in_use = true;
+            if (!JobSystem_submitToGroup(pf->jobs, &pf->job_group, run_path_job, complete_path_job, job))
+            {
+                job->in_use = false;
+                return;
+            }
+        }
+        pf->request_head = (pf->request_head + 1) % PATH_MAX_REQUESTS;
+        pf->request_count--;
+    }
+}
+
+bool Pathfinder_attachJobs(Pathfinder *pf, Arena *arena, JobSystem *jobs)
+{
+    if (!pf || !jobs)
+        return false;
+
+    int workers = jobs->worker_count > 0 ? jobs->worker_count : 1;
+    pf->worker_search = Arena_alloc(arena, workers * sizeof(PathSearch));
+    pf->job_slots = Arena_calloc(arena, PATH_MAX_JOBS, sizeof(PathJob));
+    if (!pf->worker_search || !pf->job_slots)
+    {
+        fprintf(stderr, "Erreur d'allocation mémoire pour les recherches parallèles.\n");
+        return false;
+    }
+    for (int i = 0; i < workers; i++)
+    {
+        if (!PathSearch_init(&pf->worker_search[i], arena, &pf->grid))
+            return false;
+    }
+
+    pf->jobs = jobs;
+    return true;
+}
+
+void Pathfinder_detachJobs(Pathfinder *pf)
+{
+    if (!pf || !pf->jobs)
+        return;
+
+    // Seules les recherches de ce pathfinder sont attendues : les résultats des
+    // autres systèmes restent en file pour leur JobSystem_update habituel
+    JobSystem_cancelGroup(pf->jobs, &pf->job_group);
+    for (int i = 0; i < PATH_MAX_JOBS; i++)
+        pf->job_slots[i].in_use = false;
+    pf->jobs = NULL;
+}
+
+void Pathfinder_update(Pathfinder *pf, int maxNodes)
+{
+    if (pf->jobs)
+    {
+        submit_requests(pf);
+        return;
+    }
+
+    int budget = maxNodes;
+
+    while (pf->request_count > 0 && budget > 0)
+    {
+        PathRequest *req = &pf->requests[pf->request_head];
+
+        PathStatus status = PATH_NOT_FOUND;
+        if (!req->cancelled)
+        {
+            if (!pf->searching)
+            {
+                PathSearch_begin(&pf->search, &pf->grid, req->start, req->goal);
+                pf->searching = true;
+            }
+            status = PathSearch_step(&pf->search, &pf->grid, &budget);
+            if (status == PATH_SEARCHING)
+                return; // Budget épuisé, reprise à la frame suivante
+
+            Path path;
+            PathSearch_buildPath(&pf->search, &pf->grid, &path);
+            if (req->callback)
+                req->callback(req->user, status, &path);
+        }
+
+        pf->searching = false;
+        pf->request_head = (pf->request_head + 1) % PATH_MAX_REQUESTS;
+        pf->request_count--;
+    }
+}
@@ -0,0 +1,134 @@
+#ifndef PATHFINDING_H
+#define PATHFINDING_H
+
+#include <SDL2/SDL.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include "arena.h"
+#include "jobs.h"
+
+// Recherche de chemin sur la grille de tuiles (16 px) par Jump Point Search.
+// Les déplacements diagonaux ne coupent jamais un coin bloqué ; le chemin final
+// est la suite des points de saut, reliés par des segments droits ou diagonaux.
+//
+// Toutes les structures de recherche sont allouées une fois (dans l'arena de la
+// carte). Les requêtes sont mises en file et traitées par Pathfinder_update avec
+// un budget de nœuds développés par frame : une recherche longue s'étale sur
+// plusieurs frames au lieu de provoquer un pic.
+// Avec un JobSystem (Pathfinder_attachJobs), les requêtes sont résolues en
+// parallèle par les threads de travail, chacun avec sa propre mémoire de
+// recherche ; les callbacks sont appelés par le thread principal (JobSystem_update).
+
+#define PATH_MAX_POINTS 64       // Points de passage max d'un chemin
+#define PATH_MAX_REQUESTS 256    // Requêtes en attente max
+#define PATHFINDER_NODES_PER_FRAME 2048 // Cases examinées par frame
+#define PATH_MAX_JOBS 64                 // Recherches confiées aux threads en même temps
+
+typedef enum
+{
+    PATH_SEARCHING,
+    PATH_FOUND,
+    PATH_NOT_FOUND
+} PathStatus;
+
+// Chemin en coordonnées de tuiles, sans le point de départ
+typedef struct
+{
+    int count;
+    SDL_Point points[PATH_MAX_POINTS];
+    bool truncated; // Plus de PATH_MAX_POINTS points : seul le début est fourni, la suite est à redemander depuis le dernier
+} Path;
+
+// Appelé une fois la recherche terminée (jamais pour une requête annulée)
+typedef void (*PathCallback)(void *user, PathStatus status, const Path *path);
+
+typedef struct
+{
+    int id;
+    SDL_Point start, goal;
+    PathCallback callback;
+    void *user;
+    bool cancelled;
+} PathRequest;
+
+// Grille de navigation (partagée en lecture seule entre les recherches)
+typedef struct
+{
+    int width, height; // En tuiles
+    int tile_size;
+    uint8_t *blocked; // 1 = tuile infranchissable
+} NavGrid;
+
+// Mémoire de travail d'une recherche, réutilisée d'une requête à l'autre
+typedef struct
+{
+    uint32_t *g;         // Coût depuis le départ
+    int32_t *parent;     // Nœud précédent (point de saut)
+    uint32_t *stamp;     // Vaut search_id si g/parent/heap_index sont valides
+    uint32_t *closed;    // Vaut search_id si le nœud est fermé
+    int32_t *heap;       // Tas binaire de nœuds ouverts
+    uint32_t *heap_f;    // Coût estimé total, parallèle à 'heap'
+    int32_t *heap_index; // Position d'un nœud dans le tas (-1 = absent)
+    int heap_count;
+    uint32_t search_id;  // Incrémenté à chaque recherche : rien à remettre à zéro
+
+    int start_node, goal_node;
+    PathStatus status;
+} PathSearch;
+
+// Recherche confiée à un thread de travail
+typedef struct
+{
+    struct Pathfinder *pf;
+    PathRequest request;
+    PathStatus status;
+    Path path;
+    bool in_use;
+} PathJob;
+
+typedef struct Pathfinder
+{
+    NavGrid grid;
+    PathSearch search;
+
+    // File circulaire de requêtes
+    PathRequest requests[PATH_MAX_REQUESTS];
+    int request_head;
+    int request_count;
+    int next_id;
+
+    bool searching; // La requête en tête est en cours de recherche
+
+    // Résolution sur les threads de travail (NULL : recherche sur le thread principal)
+    JobSystem *jobs;
+    PathSearch *worker_search; // Une mémoire de recherche par thread
+    PathJob *job_slots;        // PATH_MAX_JOBS emplacements
+    JobGroup job_group;        // Recherches soumises, attendues par Pathfinder_detachJobs
+} Pathfinder;
+
+Pathfinder *Pathfinder_create(Arena *arena, int width, int height, int tileSize);
+void Pathfinder_setBlocked(Pathfinder *pf, int x, int y, bool blocked);
+bool Pathfinder_isBlocked(const NavGrid *grid, int x, int y);
+
+// Met une requête en file, retourne son identifiant ou -1 si la file est pleine
+int Pathfinder_request(Pathfinder *pf, SDL_Point start, SDL_Point goal, PathCallback callback, void *user);
+void Pathfinder_cancel(Pathfinder *pf, int requestId);
+
+// Fait avancer les recherches en développant au plus 'maxNodes' nœuds,
+// ou soumet les requêtes en attente au JobSystem s'il y en a un
+void Pathfinder_update(Pathfinder *pf, int maxNodes);
+
+// Confie les recherches aux threads de 'jobs' (mémoire allouée dans 'arena')
+bool Pathfinder_attachJobs(Pathfinder *pf, Arena *arena, JobSystem *jobs);
+// Annule les recherches en cours et attend leur fin (avant de libérer la carte)
+void Pathfinder_detachJobs(Pathfinder *pf);
+
+// Recherche seule, sans file (utilisable avec sa propre mémoire de travail)
+bool PathSearch_init(PathSearch *search, Arena *arena, const NavGrid *grid);
+PathStatus PathSearch_begin(PathSearch *search, const NavGrid *grid, SDL_Point start, SDL_Point goal);
+// Continue la recherche ; 'budget' est décrémenté du nombre de cases examinées
+PathStatus PathSearch_step(PathSearch *search, const NavGrid *grid, int *budget);
+// Construit le chemin d'une recherche terminée avec PATH_FOUND
+void PathSearch_buildPath(PathSearch *search, const NavGrid *grid, Path *path);
+
+#endif
@@ -0,0 +1,55 @@
+#ifndef RANDOM_H
+#define RANDOM_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Générateur pseudo-aléatoire rapide (PCG32) à graine explicite : une même graine
+// donne toujours la même suite, ce qui rend rencontres et combats reproductibles.
+// Chaque système garde son propre état, aucun état global.
+
+typedef struct
+{
+    uint64_t state;
+    uint64_t inc; // Toujours impair
+} Random;
+
+static inline uint32_t Random_next(Random *rng)
+{
+    uint64_t old = rng->state;
+    rng->state = old * 6364136223846793005ULL + rng->inc;
+    uint32_t xorshifted = (uint32_t)(((old >> 18u) ^ old) >> 27u);
+    uint32_t rot = (uint32_t)(old >> 59u);
+    return (xorshifted >> rot) | (xorshifted << ((-rot) & 31));
+}
+
+static inline void Random_seed(Random *rng, uint64_t seed)
+{
+    rng->state = 0;
+    rng->inc = (seed << 1u) | 1u;
+    Random_next(rng);
+    rng->state += seed ^ 0x853c49e6748fea9bULL;
+    Random_next(rng);
+}
+
+// Entier uniforme dans [0, n[ (multiplication plutôt que modulo), 0 si n vaut 0
+static inline uint32_t Random_range(Random *rng, uint32_t n)
+{
+    return (uint32_t)(((uint64_t)Random_next(rng) * n) >> 32);
+}
+
+// Entier uniforme dans [min, max]
+static inline int Random_between(Random *rng, int min, int max)
+{
+    if (max <= min)
+        return min;
+    return min + (int)Random_range(rng, (uint32_t)(max - min) + 1);
+}
+
+// Vrai avec une probabilité de 'chance' sur 'outOf'
+static inline bool Random_chance(Random *rng, uint32_t chance, uint32_t outOf)
+{
+    return Random_range(rng, outOf) < chance;
+}
+
+#endif
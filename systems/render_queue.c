@@ -0,0 +1,182 @@
+#include "render_queue.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <stdbool.h>
+
+#define RENDER_KEY_LAYER_BITS 4
+#define RENDER_KEY_Y_BITS 16
+#define RENDER_KEY_TEXTURE_BITS 12
+#define RENDER_KEY_Y_BIAS 32768 // Les y négatifs restent triables
+
+static bool RenderQueue_grow(RenderQueue *queue, int capacity)
+{
+    RenderItem *items = realloc(queue->items, capacity * sizeof(RenderItem));
+    if (!items)
+        return false;
+    queue->items = items;
+
+    uint32_t *keys = realloc(queue->keys, capacity * sizeof(uint32_t));
+    if (!keys)
+        return false;
+    queue->keys = keys;
+
+    uint32_t *order = realloc(queue->order, capacity * sizeof(uint32_t));
+    if (!order)
+        return false;
+    queue->order = order;
+
+    uint32_t *scratch = realloc(queue->scratch, capacity * sizeof(uint32_t));
+    if (!scratch)
+        return false;
+    queue->scratch = scratch;
+
+    queue->capacity = capacity;
+    return true;
+}
+
+RenderQueue *RenderQueue_create(int capacity)
+{
+    RenderQueue *queue = calloc(1, sizeof(RenderQueue));
+    if (!queue)
+        return NULL;
+
+    if (!RenderQueue_grow(queue, capacity > 0 ? capacity : 256))
+    {
+        fprintf(stderr, "Erreur d'allocation mémoire pour la file de rendu.\n");
+        RenderQueue_free(queue);
+        return NULL;
+    }
+    return queue;
+}
+
+void RenderQueue_free(RenderQueue *queue)
+{
+    if (!queue)
+        return;
+    free(queue->items);
+    free(queue->keys);
+    free(queue->order);
+    free(queue->scratch);
+    free(queue);
+}
+
+void RenderQueue_begin(RenderQueue *queue)
+{
+    queue->count = 0;
+    queue->texture_count = 0;
+    queue->frame++;
+}
+
+// Identifiant compact de la texture pour cette frame
+static uint32_t texture_id(RenderQueue *queue, SDL_Texture *texture)
+{
+    uintptr_t h = (uintptr_t)texture;
+    h ^= h >> 17;
+    h *= 0x9E3779B1u;
+    unsigned slot = (unsigned)(h >> 7) & (RENDER_QUEUE_TEXTURE_SLOTS - 1);
+
+    for (int probe = 0; probe < RENDER_QUEUE_TEXTURE_SLOTS; probe++)
+    {
+        unsigned s = (slot + probe) & (RENDER_QUEUE_TEXTURE_SLOTS - 1);
+        if (queue->texture_frame[s] != queue->frame)
+        {
+            queue->texture_frame[s] = queue->frame;
+            queue->texture_keys[s] = texture;
+            queue->texture_ids[s] = (uint16_t)(queue->texture_count < (1 << RENDER_KEY_TEXTURE_BITS) ? queue->texture_count++ : (1 << RENDER_KEY_TEXTURE_BITS) - 1);
+            return queue->texture_ids[s];
+        }
+        if (queue->texture_keys[s] == texture)
+            return queue->texture_ids[s];
+    }
+    return (1 << RENDER_KEY_TEXTURE_BITS) - 1;
+}
+
+void RenderQueue_push(RenderQueue *queue, SDL_Texture *texture, const SDL_Rect *src, const SDL_Rect *dst,
+                      SDL_RendererFlip flip, double angle, int layer, float footY)
+{
+    if (!queue || !texture)
+        return;
+
+    if (queue->count >= queue->capacity && !RenderQueue_grow(queue, queue->capacity * 2))
+        return;
+
+    int i = queue->count++;
+    RenderItem *item = &queue->items[i];
+    item->texture = texture;
+    item->src = *src;
+    item->dst = *dst;
+    item->flip = flip;
+    item->angle = angle;
+
+    if (layer < 0)
+        layer = 0;
+    if (layer > (1 << RENDER_KEY_LAYER_BITS) - 1)
+        layer = (1 << RENDER_KEY_LAYER_BITS) - 1;
+
+    int y = (int)footY + RENDER_KEY_Y_BIAS;
+    if (y < 0)
+        y = 0;
+    if (y > (1 << RENDER_KEY_Y_BITS) - 1)
+        y = (1 << RENDER_KEY_Y_BITS) - 1;
+
+    queue->keys[i] = ((uint32_t)layer << (RENDER_KEY_Y_BITS + RENDER_KEY_TEXTURE_BITS)) |
+                     ((uint32_t)y << RENDER_KEY_TEXTURE_BITS) |
+                     texture_id(queue, texture);
+}
+
+// Tri radix LSD sur 4 octets (stable) ; les passes dont l'octet est constant sont sautées
+static void radix_sort(const uint32_t *keys, uint32_t *order, uint32_t *scratch, int n)
+{
+    uint32_t *src = order;
+    uint32_t *dst = scratch;
+
+    for (int i = 0; i < n; i++)
+        src[i] = (uint32_t)i;
+
+    for (int shift = 0; shift < 32; shift += 8)
+    {
+        int counts[256] = {0};
+        for (int i = 0; i < n; i++)
+            counts[(keys[src[i]] >> shift) & 0xFF]++;
+
+        if (counts[(keys[src[0]] >> shift) & 0xFF] == n)
+            continue;
+
+        int offset = 0;
+        for (int b = 0; b < 256; b++)
+        {
+            int c = counts[b];
+            counts[b] = offset;
+            offset += c;
+        }
+        for (int i = 0; i < n; i++)
+            dst[counts[(keys[src[i]] >> shift) & 0xFF]++] = src[i];
+
+        uint32_t *tmp = src;
+        src = dst;
+        dst = tmp;
+    }
+
+    if (src != order)
+        memcpy(order, src, n * sizeof(uint32_t));
+}
+
+void RenderQueue_flush(RenderQueue *queue, SDL_Renderer *renderer)
+{
+    if (!queue || queue->count == 0)
+        return;
+
+    radix_sort(queue->keys, queue->order, queue->scratch, queue->count);
+
+    // Les items consécutifs partageant une texture sont regroupés par le batching SDL
+    for (int i = 0; i < queue->count; i++)
+    {
+        RenderItem *item = &queue->items[queue->order[i]];
+        if (item->flip == SDL_FLIP_NONE && item->angle == 0.0)
+            SDL_RenderCopy(renderer, item->texture, &item->src, &item->dst);
+        else
+            SDL_RenderCopyEx(renderer, item->texture, &item->src, &item->dst, item->angle, NULL, item->flip);
+    }
+    queue->count = 0;
+}
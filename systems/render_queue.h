@@ -0,0 +1,52 @@
+#ifndef RENDER_QUEUE_H
+#define RENDER_QUEUE_H
+
+#include <SDL2/SDL.h>
+#include <stdint.h>
+
+// File de rendu triée en profondeur : les entités et les objets hauts de la carte
+// y déposent leurs sprites, triés chaque frame par (layer, y des pieds) avec un
+// tri radix, puis dessinés en regroupant les textures identiques.
+
+#define RENDER_QUEUE_TEXTURE_SLOTS 1024 // Puissance de 2
+
+typedef struct
+{
+    SDL_Texture *texture;
+    SDL_Rect src;
+    SDL_Rect dst; // Coordonnées écran
+    SDL_RendererFlip flip;
+    double angle;
+} RenderItem;
+
+typedef struct
+{
+    RenderItem *items;
+    uint32_t *keys;    // Clé de tri : layer (4 bits) | y des pieds (16 bits) | texture (12 bits)
+    uint32_t *order;   // Indices triés
+    uint32_t *scratch; // Tampon du tri radix
+    int count;
+    int capacity;
+
+    // Identifiants de texture de la frame (hachage ouvert, invalidé par 'frame')
+    SDL_Texture *texture_keys[RENDER_QUEUE_TEXTURE_SLOTS];
+    uint16_t texture_ids[RENDER_QUEUE_TEXTURE_SLOTS];
+    uint32_t texture_frame[RENDER_QUEUE_TEXTURE_SLOTS];
+    uint32_t frame;
+    int texture_count;
+} RenderQueue;
+
+RenderQueue *RenderQueue_create(int capacity);
+void RenderQueue_free(RenderQueue *queue);
+
+// Vide la file au début de chaque frame
+void RenderQueue_begin(RenderQueue *queue);
+
+// Ajoute un sprite ; 'footY' est la coordonnée monde du bas de l'objet
+void RenderQueue_push(RenderQueue *queue, SDL_Texture *texture, const SDL_Rect *src, const SDL_Rect *dst,
+                      SDL_RendererFlip flip, double angle, int layer, float footY);
+
+// Trie et dessine tout le contenu de la file
+void RenderQueue_flush(RenderQueue *queue, SDL_Renderer *renderer);
+
+#endif
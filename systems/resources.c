@@ -0,0 +1,162 @@
+#include "resources.h"
+#include <SDL2/SDL_image.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static ResourceManifest *active_manifest = NULL;
+
+ResourceManifest *ResourceManifest_create(JobSystem *jobs)
+{
+    ResourceManifest *manifest = calloc(1, sizeof(ResourceManifest));
+    if (!manifest)
+    {
+        fprintf(stderr, "Erreur d'allocation mémoire pour le manifeste des ressources.\n");
+        return NULL;
+    }
+    manifest->jobs = jobs;
+    return manifest;
+}
+
+void ResourceManifest_free(ResourceManifest *manifest)
+{
+    if (!manifest)
+        return;
+    if (active_manifest == manifest)
+        active_manifest = NULL;
+    for (int i = 0; i < manifest->count; i++)
+    {
+        SDL_FreeSurface(manifest->images[i].surface);
+        ImageCache_unmap(&manifest->images[i].mapping);
+    }
+    free(manifest->images);
+    free(manifest);
+}
+
+static int find_image(ResourceManifest *manifest, const char *path)
+{
+    for (int i = 0; i < manifest->count; i++)
+    {
+        if (strcmp(manifest->images[i].path, path) == 0)
+            return i;
+    }
+    return -1;
+}
+
+int ResourceManifest_add(ResourceManifest *manifest, const char *path)
+{
+    if (!manifest || !path || !path[0])
+        return -1;
+    int index = find_image(manifest, path);
+    if (index >= 0)
+        return index;
+
+    if (strlen(path) >= RESOURCE_PATH_MAX)
+    {
+        fprintf(stderr, "Chemin de ressource trop long : %s\n", path);
+        return -1;
+    }
+    if (manifest->count >= manifest->capacity)
+    {
+        int capacity = manifest->capacity == 0 ? 16 : manifest->capacity * 2;
+        ResourceImage *images = realloc(manifest->images, capacity * sizeof(ResourceImage));
+        if (!images)
+        {
+            fprintf(stderr, "Erreur d'allocation mémoire pour le manifeste des ressources.\n");
+            return -1;
+        }
+        manifest->images = images;
+        manifest->capacity = capacity;
+    }
+
+    ResourceImage *image = &manifest->images[manifest->count];
+    memset(image, 0, sizeof(ResourceImage));
+    strcpy(image->path, path);
+    return manifest->count++;
+}
+
+// Sur un thread de travail : chaque index n'écrit que dans son entrée
+static void decode_image(ResourceImage *image)
+{
+    image->surface = ImageCache_load(image->path, &image->mapping);
+    image->decoded = true;
+}
+
+static void decode_range(void *data, int begin, int end)
+{
+    ResourceManifest *manifest = data;
+    for (int i = begin; i < end; i++)
+    {
+        if (!manifest->images[i].decoded)
+            decode_image(&manifest->images[i]);
+    }
+}
+
+void ResourceManifest_decode(ResourceManifest *manifest)
+{
+    if (!manifest || manifest->count == 0)
+        return;
+
+    // Une image par intervalle : les tailles des PNG sont très inégales
+    if (manifest->jobs)
+        JobSystem_parallelFor(manifest->jobs, manifest->count, 1, decode_range, manifest);
+    else
+        decode_range(manifest, 0, manifest->count);
+
+    // Erreurs signalées ici : IMG_GetError est propre à chaque thread
+    for (int i = 0; i < manifest->count; i++)
+    {
+        if (!manifest->images[i].surface)
+            fprintf(stderr, "Erreur SDL_Image: impossible de décoder %s\n", manifest->images[i].path);
+    }
+}
+
+SDL_Surface *ResourceManifest_surface(ResourceManifest *manifest, int index)
+{
+    if (!manifest || index < 0 || index >= manifest->count)
+        return NULL;
+
+    // Image ajoutée après le décodage groupé : décodée ici, une fois
+    ResourceImage *image = &manifest->images[index];
+    if (!image->decoded)
+        decode_image(image);
+    if (!image->surface)
+        return NULL;
+    image->surface->refcount++;
+    return image->surface;
+}
+
+void Resources_setActive(ResourceManifest *manifest)
+{
+    active_manifest = manifest;
+}
+
+ResourceManifest *Resources_getActive(void)
+{
+    return active_manifest;
+}
+
+SDL_Surface *Resources_loadSurface(const char *path)
+{
+    if (active_manifest)
+    {
+        int index = find_image(active_manifest, path);
+        SDL_Surface *surface = ResourceManifest_surface(active_manifest, index);
+        if (surface)
+            return surface;
+    }
+    return ImageCache_loadCopy(path);
+}
+
+SDL_Texture *Resources_loadTexture(SDL_Renderer *renderer, const char *path)
+{
+    SDL_Surface *surface = Resources_loadSurface(path);
+    if (!surface)
+    {
+        fprintf(stderr, "Erreur SDL_Image: %s\n", IMG_GetError());
+        return NULL;
+    }
+    SDL_Texture *texture = SDL_CreateTextureFromSurface(renderer, surface);
+    SDL_FreeSurface(surface);
+    return texture;
+}
@@ -0,0 +1,61 @@
+#ifndef RESOURCES_H
+#define RESOURCES_H
+
+#include <SDL2/SDL.h>
+#include <stdbool.h>
+#include "jobs.h"
+#include "image_cache.h"
+
+// Manifeste des images à charger : les chemins sont collectés d'abord (feuilles
+// du joueur, tilesets et PNJs de la carte), puis tous les PNG sont décodés en
+// parallèle en surfaces sur les threads du JobSystem. Les textures sont ensuite
+// créées sur le thread principal, seul autorisé à utiliser le renderer.
+//
+// Pendant le chargement, le manifeste est rendu actif : les chargeurs
+// (Resources_loadSurface / Resources_loadTexture) y prennent les surfaces déjà
+// décodées au lieu de relire le fichier.
+//
+// Les images passent par le cache disque (image_cache.h) : une image déjà vue
+// est projetée en mémoire au lieu d'être décodée, ses pixels restent dans le
+// fichier projeté jusqu'à ResourceManifest_free.
+
+#define RESOURCE_PATH_MAX 256
+
+typedef struct
+{
+    char path[RESOURCE_PATH_MAX];
+    SDL_Surface *surface; // NULL tant que l'image n'est pas décodée, ou en cas d'erreur
+    ImageCacheMapping mapping; // Pixels de la surface si elle vient du cache
+    bool decoded;
+} ResourceImage;
+
+typedef struct
+{
+    JobSystem *jobs; // NULL : décodage sur le thread principal
+    ResourceImage *images;
+    int count;
+    int capacity;
+} ResourceManifest;
+
+ResourceManifest *ResourceManifest_create(JobSystem *jobs);
+void ResourceManifest_free(ResourceManifest *manifest);
+
+// Ajoute une image (une seule entrée par chemin) ; retourne son index, -1 en cas d'erreur
+int ResourceManifest_add(ResourceManifest *manifest, const char *path);
+
+// Décode en parallèle les images pas encore décodées, retourne quand tout est prêt
+void ResourceManifest_decode(ResourceManifest *manifest);
+
+// Surface décodée de l'image 'index' (référence en plus : à libérer avec
+// SDL_FreeSurface avant ResourceManifest_free), NULL si elle n'a pas pu être décodée
+SDL_Surface *ResourceManifest_surface(ResourceManifest *manifest, int index);
+
+// Manifeste consulté par les chargeurs ci-dessous, NULL : aucun
+void Resources_setActive(ResourceManifest *manifest);
+ResourceManifest *Resources_getActive(void);
+
+// Surface de 'path' prise dans le manifeste actif, sinon lue via le cache disque
+SDL_Surface *Resources_loadSurface(const char *path);
+SDL_Texture *Resources_loadTexture(SDL_Renderer *renderer, const char *path);
+
+#endif
@@ -0,0 +1,445 @@
+#include "save.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#define SAVE_HEADER_SIZE 12
+#define SAVE_SECTION_HEADER_SIZE 16
+
+// Image complète du fichier, remise au thread d'écriture
+typedef struct
+{
+    SaveManager *save;
+    uint8_t *image;
+    size_t size;
+    char path[SAVE_PATH_MAX];
+    bool ok;
+} SaveJob;
+
+static bool writer_reserve(SaveWriter *w, size_t extra)
+{
+    if (w->error)
+        return false;
+    if (w->size + extra <= w->capacity)
+        return true;
+    size_t capacity = w->capacity ? w->capacity * 2 : 256;
+    while (capacity < w->size + extra)
+        capacity *= 2;
+    uint8_t *data = realloc(w->data, capacity);
+    if (!data)
+    {
+        w->error = true;
+        return false;
+    }
+    w->data = data;
+    w->capacity = capacity;
+    return true;
+}
+
+void SaveWriter_bytes(SaveWriter *w, const void *data, size_t size)
+{
+    if (!writer_reserve(w, size))
+        return;
+    memcpy(w->data + w->size, data, size);
+    w->size += size;
+}
+
+void SaveWriter_u8(SaveWriter *w, uint8_t v)
+{
+    SaveWriter_bytes(w, &v, 1);
+}
+
+void SaveWriter_u16(SaveWriter *w, uint16_t v)
+{
+    uint8_t b[2] = {(uint8_t)v, (uint8_t)(v >> 8)};
+    SaveWriter_bytes(w, b, 2);
+}
+
+void SaveWriter_u32(SaveWriter *w, uint32_t v)
+{
+    uint8_t b[4] = {(uint8_t)v, (uint8_t)(v >> 8), (uint8_t)(v >> 16), (uint8_t)(v >> 24)};
+    SaveWriter_bytes(w, b, 4);
+}
+
+void SaveWriter_u64(SaveWriter *w, uint64_t v)
+{
+    SaveWriter_u32(w, (uint32_t)v);
+    SaveWriter_u32(w, (uint32_t)(v >> 32));
+}
+
+void SaveWriter_f32(SaveWriter *w, float v)
+{
+    uint32_t bits;
+    memcpy(&bits, &v, sizeof(bits));
+    SaveWriter_u32(w, bits);
+}
+
+void SaveWriter_string(SaveWriter *w, const char *str)
+{
+    size_t len = str ? strlen(str) : 0;
+    if (len > UINT16_MAX)
+        len = UINT16_MAX;
+    SaveWriter_u16(w, (uint16_t)len);
+    SaveWriter_bytes(w, str, len);
+}
+
+bool SaveReader_bytes(SaveReader *r, void *out, size_t size)
+{
+    if (r->error || size > r->size - r->pos)
+    {
+        r->error = true;
+        memset(out, 0, size);
+        return false;
+    }
+    memcpy(out, r->data + r->pos, size);
+    r->pos += size;
+    return true;
+}
+
+uint8_t SaveReader_u8(SaveReader *r)
+{
+    uint8_t v;
+    SaveReader_bytes(r, &v, 1);
+    return v;
+}
+
+uint16_t SaveReader_u16(SaveReader *r)
+{
+    uint8_t b[2];
+    SaveReader_bytes(r, b, 2);
+    return (uint16_t)(b[0] | (b[1] << 8));
+}
+
+uint32_t SaveReader_u32(SaveReader *r)
+{
+    uint8_t b[4];
+    SaveReader_bytes(r, b, 4);
+    return (uint32_t)b[0] | ((uint32_t)b[1] << 8) | ((uint32_t)b[2] << 16) | ((uint32_t)b[3] << 24);
+}
+
+uint64_t SaveReader_u64(SaveReader *r)
+{
+    uint64_t low = SaveReader_u32(r);
+    return low | ((uint64_t)SaveReader_u32(r) << 32);
+}
+
+float SaveReader_f32(SaveReader *r)
+{
+    uint32_t bits = SaveReader_u32(r);
+    float v;
+    memcpy(&v, &bits, sizeof(v));
+    return v;
+}
+
+bool SaveReader_string(SaveReader *r, char *out, size_t size)
+{
+    size_t len = SaveReader_u16(r);
+    if (r->error || len > r->size - r->pos)
+    {
+        r->error = true;
+        if (size)
+            out[0] = '\0';
+        return false;
+    }
+    size_t copy = len < size ? len : size - 1;
+    memcpy(out, r->data + r->pos, copy);
+    out[copy] = '\0';
+    r->pos += len;
+    return true;
+}
+
+// FNV-1a : détecte une section tronquée ou abîmée
+static uint32_t checksum(const uint8_t *data, size_t size)
+{
+    uint32_t h = 2166136261u;
+    for (size_t i = 0; i < size; i++)
+        h = (h ^ data[i]) * 16777619u;
+    return h;
+}
+
+SaveManager *SaveManager_create(const char *path, JobSystem *jobs)
+{
+    SaveManager *save = calloc(1, sizeof(SaveManager));
+    if (!save)
+    {
+        fprintf(stderr, "Erreur d'allocation mémoire pour le SaveManager.\n");
+        return NULL;
+    }
+    snprintf(save->path, sizeof(save->path), "%s", path);
+    save->jobs = jobs;
+    save->last_ok = true;
+    return save;
+}
+
+void SaveManager_free(SaveManager *save)
+{
+    if (!save)
+        return;
+
+    // La tâche d'écriture référence le SaveManager jusqu'à son 'complete'
+    while (save->writing)
+    {
+        JobSystem_update(save->jobs);
+        SDL_Delay(1);
+    }
+    for (int i = 0; i < save->section_count; i++)
+        free(save->sections[i].data.data);
+    free(save);
+}
+
+static SaveSection *find_section(SaveManager *save, uint32_t id)
+{
+    for (int i = 0; i < save->section_count; i++)
+    {
+        if (save->sections[i].id == id)
+            return &save->sections[i];
+    }
+    return NULL;
+}
+
+bool SaveManager_register(SaveManager *save, uint32_t id, uint32_t version, SaveCaptureFunction capture, SaveRestoreFunction restore, void *user)
+{
+    if (!save || find_section(save, id))
+        return false;
+    if (save->section_count >= SAVE_MAX_SECTIONS)
+    {
+        fprintf(stderr, "Trop de sections de sauvegarde (max %d)\n", SAVE_MAX_SECTIONS);
+        return false;
+    }
+    SaveSection *s = &save->sections[save->section_count++];
+    memset(s, 0, sizeof(SaveSection));
+    s->id = id;
+    s->version = version;
+    s->capture = capture;
+    s->restore = restore;
+    s->user = user;
+    s->dirty = true;
+    return true;
+}
+
+void SaveManager_markDirty(SaveManager *save, uint32_t id)
+{
+    SaveSection *s = save ? find_section(save, id) : NULL;
+    if (s)
+        s->dirty = true;
+}
+
+void SaveManager_markAllDirty(SaveManager *save)
+{
+    for (int i = 0; save && i < save->section_count; i++)
+        save->sections[i].dirty = true;
+}
+
+// Crée le dossier du fichier s'il n'existe pas (un seul niveau)
+static void make_parent_dir(const char *path)
+{
+    char dir[SAVE_PATH_MAX];
+    snprintf(dir, sizeof(dir), "%s", path);
+    char *slash = strrchr(dir, '/');
+    if (!slash || slash == dir)
+        return;
+    *slash = '\0';
+    if (mkdir(dir, 0755) != 0 && errno != EEXIST)
+        fprintf(stderr, "Impossible de créer le dossier %s\n", dir);
+}
+
+// Thread de travail : fichier temporaire, synchronisé sur disque, puis renommé
+static void write_save(void *data, int worker)
+{
+    SaveJob *job = data;
+    char tmp[SAVE_PATH_MAX + 4];
+    snprintf(tmp, sizeof(tmp), "%s.tmp", job->path);
+    make_parent_dir(job->path);
+
+    FILE *file = fopen(tmp, "wb");
+    if (!file)
+    {
+        job->ok = false;
+        return;
+    }
+    bool ok = fwrite(job->image, 1, job->size, file) == job->size;
+    ok = ok && fflush(file) == 0 && fsync(fileno(file)) == 0;
+    ok = (fclose(file) == 0) && ok;
+    ok = ok && rename(tmp, job->path) == 0;
+    if (!ok)
+        remove(tmp);
+    job->ok = ok;
+}
+
+static void start_write(SaveManager *save);
+
+// Thread principal
+static void save_written(void *data)
+{
+    SaveJob *job = data;
+    SaveManager *save = job->save;
+    save->writing = false;
+    save->last_ok = job->ok;
+    if (!job->ok)
+        fprintf(stderr, "Échec de l'écriture de la sauvegarde %s\n", job->path);
+    free(job->image);
+    free(job);
+
+    if (save->pending)
+    {
+        save->pending = false;
+        start_write(save);
+    }
+}
+
+// Assemble l'image du fichier à partir des dernières captures et la confie à un thread
+static void start_write(SaveManager *save)
+{
+    SaveWriter image = {0};
+    SaveWriter_u32(&image, SAVE_MAGIC);
+    SaveWriter_u32(&image, SAVE_FORMAT_VERSION);
+    SaveWriter_u32(&image, (uint32_t)save->section_count);
+    for (int i = 0; i < save->section_count; i++)
+    {
+        SaveSection *s = &save->sections[i];
+        SaveWriter_u32(&image, s->id);
+        SaveWriter_u32(&image, s->version);
+        SaveWriter_u32(&image, (uint32_t)s->data.size);
+        SaveWriter_u32(&image, checksum(s->data.data, s->data.size));
+        SaveWriter_bytes(&image, s->data.data, s->data.size);
+    }
+
+    SaveJob *job = malloc(sizeof(SaveJob));
+    if (image.error || !job)
+    {
+        fprintf(stderr, "Erreur d'allocation mémoire pour la sauvegarde.\n");
+        free(image.data);
+        free(job);
+        save->last_ok = false;
+        return;
+    }
+    job->save = save;
+    job->image = image.data;
+    job->size = image.size;
+    job->ok = false;
+    snprintf(job->path, sizeof(job->path), "%s", save->path);
+
+    save->writing = true;
+    if (!save->jobs)
+    {
+        write_save(job, 0);
+        save_written(job);
+    }
+    else if (!JobSystem_submit(save->jobs, write_save, save_written, job))
+    {
+        // File pleine : écriture immédiate plutôt que de perdre la sauvegarde
+        write_save(job, 0);
+        save_written(job);
+    }
+}
+
+bool SaveManager_save(SaveManager *save)
+{
+    if (!save)
+        return false;
+
+    for (int i = 0; i < save->section_count; i++)
+    {
+        SaveSection *s = &save->sections[i];
+        if (!s->dirty)
+            continue;
+        s->data.size = 0;
+        s->data.error = false;
+        if (!s->capture(s->user, &s->data) || s->data.error)
+        {
+            fprintf(stderr, "Échec de la capture de la section de sauvegarde %u\n", s->id);
+            s->data.size = 0;
+            return false;
+        }
+        s->dirty = false;
+    }
+
+    // L'image est copiée : les captures suivantes ne touchent pas l'écriture en cours
+    if (save->writing)
+        save->pending = true;
+    else
+        start_write(save);
+    return true;
+}
+
+bool SaveManager_exists(const SaveManager *save)
+{
+    struct stat st;
+    return save && stat(save->path, &st) == 0;
+}
+
+bool SaveManager_load(SaveManager *save)
+{
+    if (!save)
+        return false;
+
+    FILE *file = fopen(save->path, "rb");
+    if (!file)
+    {
+        fprintf(stderr, "Aucune sauvegarde (%s)\n", save->path);
+        return false;
+    }
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    uint8_t *data = size > 0 ? malloc(size) : NULL;
+    if (!data || fread(data, 1, size, file) != (size_t)size)
+    {
+        fprintf(stderr, "Impossible de lire la sauvegarde %s\n", save->path);
+        fclose(file);
+        free(data);
+        return false;
+    }
+    fclose(file);
+
+    SaveReader r = {data, (size_t)size, 0, false};
+    uint32_t magic = SaveReader_u32(&r);
+    uint32_t format = SaveReader_u32(&r);
+    uint32_t count = SaveReader_u32(&r);
+    if (r.error || magic != SAVE_MAGIC || format > SAVE_FORMAT_VERSION)
+    {
+        fprintf(stderr, "Sauvegarde %s invalide ou d'une version plus récente\n", save->path);
+        free(data);
+        return false;
+    }
+
+    bool ok = true;
+    for (uint32_t i = 0; i < count && !r.error; i++)
+    {
+        uint32_t id = SaveReader_u32(&r);
+        uint32_t version = SaveReader_u32(&r);
+        uint32_t length = SaveReader_u32(&r);
+        uint32_t sum = SaveReader_u32(&r);
+        if (r.error || length > r.size - r.pos)
+        {
+            ok = false;
+            break;
+        }
+
+        SaveReader section = {r.data + r.pos, length, 0, false};
+        r.pos += length;
+        SaveSection *s = find_section(save, id);
+        if (!s)
+            continue; // Section d'un autre système ou d'une autre version du jeu
+        if (checksum(section.data, length) != sum)
+        {
+            fprintf(stderr, "Section de sauvegarde %u abîmée, ignorée\n", id);
+            ok = false;
+            continue;
+        }
+        if (version > s->version || !s->restore(s->user, &section, version) || section.error)
+        {
+            fprintf(stderr, "Section de sauvegarde %u illisible (version %u)\n", id, version);
+            ok = false;
+        }
+    }
+    ok = ok && !r.error;
+
+    // L'état restauré devient la référence des prochaines captures
+    SaveManager_markAllDirty(save);
+    free(data);
+    return ok;
+}
@@ -0,0 +1,111 @@
+#ifndef SAVE_H
+#define SAVE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "jobs.h"
+
+// Sauvegarde binaire versionnée, découpée en sections indépendantes :
+//
+//   en-tête   : "PKSV", version du format, nombre de sections
+//   section   : identifiant, version de la section, taille, somme de contrôle, données
+//
+// Tout est écrit en little-endian champ par champ : le fichier ne dépend ni de la
+// machine ni de la disposition des structures. Une section inconnue est ignorée au
+// chargement, une section absente laisse l'état correspondant tel quel.
+//
+// Chaque système enregistre sa section (capture / restauration). Une capture ne
+// resérialise que les sections marquées modifiées, les autres réutilisent leurs
+// octets précédents. L'écriture se fait sur un thread de travail, dans un fichier
+// temporaire renommé ensuite sur le fichier final (remplacement atomique).
+
+#define SAVE_MAGIC 0x56534B50u // "PKSV"
+#define SAVE_FORMAT_VERSION 1
+#define SAVE_MAX_SECTIONS 16
+#define SAVE_PATH_MAX 256
+
+// Tampon de sérialisation
+typedef struct
+{
+    uint8_t *data;
+    size_t size;
+    size_t capacity;
+    bool error; // Allocation impossible : le contenu est incomplet
+} SaveWriter;
+
+typedef struct
+{
+    const uint8_t *data;
+    size_t size;
+    size_t pos;
+    bool error; // Lecture au-delà de la fin : les valeurs lues valent 0
+} SaveReader;
+
+void SaveWriter_u8(SaveWriter *w, uint8_t v);
+void SaveWriter_u16(SaveWriter *w, uint16_t v);
+void SaveWriter_u32(SaveWriter *w, uint32_t v);
+void SaveWriter_u64(SaveWriter *w, uint64_t v);
+void SaveWriter_f32(SaveWriter *w, float v);
+void SaveWriter_bytes(SaveWriter *w, const void *data, size_t size);
+void SaveWriter_string(SaveWriter *w, const char *str); // Longueur (u16) puis octets
+
+uint8_t SaveReader_u8(SaveReader *r);
+uint16_t SaveReader_u16(SaveReader *r);
+uint32_t SaveReader_u32(SaveReader *r);
+uint64_t SaveReader_u64(SaveReader *r);
+float SaveReader_f32(SaveReader *r);
+bool SaveReader_bytes(SaveReader *r, void *out, size_t size);
+bool SaveReader_string(SaveReader *r, char *out, size_t size); // Tronquée à 'size' - 1
+
+// Écrit l'état de la section dans 'out'
+typedef bool (*SaveCaptureFunction)(void *user, SaveWriter *out);
+// Restaure l'état ; 'version' : version de la section au moment de l'écriture
+typedef bool (*SaveRestoreFunction)(void *user, SaveReader *in, uint32_t version);
+
+typedef struct
+{
+    uint32_t id;
+    uint32_t version;
+    SaveCaptureFunction capture;
+    SaveRestoreFunction restore;
+    void *user;
+
+    SaveWriter data; // Dernière capture
+    bool dirty;
+} SaveSection;
+
+typedef struct SaveManager
+{
+    char path[SAVE_PATH_MAX];
+    JobSystem *jobs; // NULL : écriture sur le thread appelant
+
+    SaveSection sections[SAVE_MAX_SECTIONS];
+    int section_count;
+
+    bool writing; // Une écriture est en cours sur un thread
+    bool pending; // Sauvegarde demandée pendant l'écriture : relancée à la fin
+    bool last_ok; // Résultat de la dernière écriture terminée
+} SaveManager;
+
+SaveManager *SaveManager_create(const char *path, JobSystem *jobs);
+// Attend la fin de l'écriture en cours
+void SaveManager_free(SaveManager *save);
+
+// Les sections sont écrites dans l'ordre d'enregistrement ; une nouvelle section est modifiée
+bool SaveManager_register(SaveManager *save, uint32_t id, uint32_t version, SaveCaptureFunction capture, SaveRestoreFunction restore, void *user);
+
+// Marque une section à resérialiser à la prochaine sauvegarde
+void SaveManager_markDirty(SaveManager *save, uint32_t id);
+void SaveManager_markAllDirty(SaveManager *save);
+
+// Capture les sections modifiées puis lance l'écriture en arrière-plan.
+// Retourne false si une capture a échoué (rien n'est écrit)
+bool SaveManager_save(SaveManager *save);
+
+// Lit le fichier et restaure les sections connues (sur le thread appelant)
+bool SaveManager_load(SaveManager *save);
+
+bool SaveManager_exists(const SaveManager *save);
+
+#endif
@@ -0,0 +1,546 @@
+#include "text.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define FONT_ATLAS_COLUMNS 16
+
+// Police intégrée : une rangée de 5 bits par ligne de pixels (bit 4 : colonne de gauche).
+// Majuscules et chiffres sur les lignes 1 à 7, minuscules sur 3 à 7, jambages sur 8 et 9,
+// accents des minuscules sur 1 et 2, des majuscules sur 0. 'width' : colonnes utilisées.
+typedef struct
+{
+    uint32_t codepoint;
+    uint8_t width;
+    uint8_t rows[FONT_GLYPH_HEIGHT];
+} FontGlyphData;
+
+static const FontGlyphData font_data[] = {
+    {0x0020, 3, {0}},
+    {0x0021, 1, {0x00, 0x10, 0x10, 0x10, 0x10, 0x10, 0x00, 0x10, 0x00, 0x00}}, // !
+    {0x0022, 3, {0x00, 0x14, 0x14, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}}, // "
+    {0x0023, 5, {0x00, 0x0A, 0x0A, 0x1F, 0x0A, 0x1F, 0x0A, 0x0A, 0x00, 0x00}}, // #
+    {0x0024, 5, {0x00, 0x04, 0x0F, 0x14, 0x0E, 0x05, 0x1E, 0x04, 0x00, 0x00}}, // $
+    {0x0025, 5, {0x00, 0x19, 0x19, 0x02, 0x04, 0x08, 0x13, 0x13, 0x00, 0x00}}, // %
+    {0x0026, 5, {0x00, 0x0C, 0x12, 0x14, 0x08, 0x15, 0x12, 0x0D, 0x00, 0x00}}, // &
+    {0x0027, 1, {0x00, 0x10, 0x10, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}}, // '
+    {0x0028, 3, {0x00, 0x04, 0x08, 0x10, 0x10, 0x10, 0x08, 0x04, 0x00, 0x00}}, // (
+    {0x0029, 3, {0x00, 0x10, 0x08, 0x04, 0x04, 0x04, 0x08, 0x10, 0x00, 0x00}}, // )
+    {0x002A, 5, {0x00, 0x00, 0x04, 0x15, 0x0E, 0x15, 0x04, 0x00, 0x00, 0x00}}, // *
+    {0x002B, 5, {0x00, 0x00, 0x00, 0x04, 0x04, 0x1F, 0x04, 0x04, 0x00, 0x00}}, // +
+    {0x002C, 2, {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x08, 0x08, 0x10, 0x00}}, // ,
+    {0x002D, 4, {0x00, 0x00, 0x00, 0x00, 0x00, 0x1E, 0x00, 0x00, 0x00, 0x00}}, // -
+    {0x002E, 2, {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x18, 0x18, 0x00, 0x00}}, // .
+    {0x002F, 5, {0x00, 0x01, 0x01, 0x02, 0x04, 0x08, 0x10, 0x10, 0x00, 0x00}}, // /
+    {0x0030, 5, {0x00, 0x0E, 0x11, 0x13, 0x15, 0x19, 0x11, 0x0E, 0x00, 0x00}}, // 0
+    {0x0031, 3, {0x00, 0x08, 0x18, 0x08, 0x08, 0x08, 0x08, 0x1C, 0x00, 0x00}}, // 1
+    {0x0032, 5, {0x00, 0x0E, 0x11, 0x01, 0x02, 0x04, 0x08, 0x1F, 0x00, 0x00}}, // 2
+    {0x0033, 5, {0x00, 0x1E, 0x01, 0x01, 0x0E, 0x01, 0x01, 0x1E, 0x00, 0x00}}, // 3
+    {0x0034, 5, {0x00, 0x02, 0x06, 0x0A, 0x12, 0x1F, 0x02, 0x02, 0x00, 0x00}}, // 4
+    {0x0035, 5, {0x00, 0x1F, 0x10, 0x1E, 0x01, 0x01, 0x11, 0x0E, 0x00, 0x00}}, // 5
+    {0x0036, 5, {0x00, 0x06, 0x08, 0x10, 0x1E, 0x11, 0x11, 0x0E, 0x00, 0x00}}, // 6
+    {0x0037, 5, {0x00, 0x1F, 0x01, 0x02, 0x04, 0x08, 0x08, 0x08, 0x00, 0x00}}, // 7
+    {0x0038, 5, {0x00, 0x0E, 0x11, 0x11, 0x0E, 0x11, 0x11, 0x0E, 0x00, 0x00}}, // 8
+    {0x0039, 5, {0x00, 0x0E, 0x11, 0x11, 0x0F, 0x01, 0x02, 0x0C, 0x00, 0x00}}, // 9
+    {0x003A, 2, {0x00, 0x00, 0x00, 0x18, 0x18, 0x00, 0x18, 0x18, 0x00, 0x00}}, // :
+    {0x003B, 2, {0x00, 0x00, 0x00, 0x18, 0x18, 0x00, 0x18, 0x08, 0x10, 0x00}}, // ;
+    {0x003C, 4, {0x00, 0x02, 0x04, 0x08, 0x10, 0x08, 0x04, 0x02, 0x00, 0x00}}, // <
+    {0x003D, 5, {0x00, 0x00, 0x00, 0x1F, 0x00, 0x1F, 0x00, 0x00, 0x00, 0x00}}, // =
+    {0x003E, 4, {0x00, 0x10, 0x08, 0x04, 0x02, 0x04, 0x08, 0x10, 0x00, 0x00}}, // >
+    {0x003F, 5, {0x00, 0x0E, 0x11, 0x01, 0x02, 0x04, 0x00, 0x04, 0x00, 0x00}}, // ?
+    {0x0040, 5, {0x00, 0x0E, 0x11, 0x17, 0x15, 0x17, 0x10, 0x0E, 0x00, 0x00}}, // @
+    {0x0041, 5, {0x00, 0x0E, 0x11, 0x11, 0x1F, 0x11, 0x11, 0x11, 0x00, 0x00}}, // A
+    {0x0042, 5, {0x00, 0x1E, 0x11, 0x11, 0x1E, 0x11, 0x11, 0x1E, 0x00, 0x00}}, // B
+    {0x0043, 5, {0x00, 0x0E, 0x11, 0x10, 0x10, 0x10, 0x11, 0x0E, 0x00, 0x00}}, // C
+    {0x0044, 5, {0x00, 0x1E, 0x11, 0x11, 0x11, 0x11, 0x11, 0x1E, 0x00, 0x00}}, // D
+    {0x0045, 5, {0x00, 0x1F, 0x10, 0x10, 0x1E, 0x10, 0x10, 0x1F, 0x00, 0x00}}, // E
+    {0x0046, 5, {0x00, 0x1F, 0x10, 0x10, 0x1E, 0x10, 0x10, 0x10, 0x00, 0x00}}, // F
+    {0x0047, 5, {0x00, 0x0E, 0x11, 0x10, 0x17, 0x11, 0x11, 0x0F, 0x00, 0x00}}, // G
+    {0x0048, 5, {0x00, 0x11, 0x11, 0x11, 0x1F, 0x11, 0x11, 0x11, 0x00, 0x00}}, // H
+    {0x0049, 3, {0x00, 0x1C, 0x08, 0x08, 0x08, 0x08, 0x08, 0x1C, 0x00, 0x00}}, // I
+    {0x004A, 5, {0x00, 0x07, 0x02, 0x02, 0x02, 0x02, 0x12, 0x0C, 0x00, 0x00}}, // J
+    {0x004B, 5, {0x00, 0x11, 0x12, 0x14, 0x18, 0x14, 0x12, 0x11, 0x00, 0x00}}, // K
+    {0x004C, 5, {0x00, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x1F, 0x00, 0x00}}, // L
+    {0x004D, 5, {0x00, 0x11, 0x1B, 0x15, 0x15, 0x11, 0x11, 0x11, 0x00, 0x00}}, // M
+    {0x004E, 5, {0x00, 0x11, 0x19, 0x15, 0x13, 0x11, 0x11, 0x11, 0x00, 0x00}}, // N
+    {0x004F, 5, {0x00, 0x0E, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0E, 0x00, 0x00}}, // O
+    {0x0050, 5, {0x00, 0x1E, 0x11, 0x11, 0x1E, 0x10, 0x10, 0x10, 0x00, 0x00}}, // P
+    {0x0051, 5, {0x00, 0x0E, 0x11, 0x11, 0x11, 0x15, 0x12, 0x0D, 0x00, 0x00}}, // Q
+    {0x0052, 5, {0x00, 0x1E, 0x11, 0x11, 0x1E, 0x14, 0x12, 0x11, 0x00, 0x00}}, // R
+    {0x0053, 5, {0x00, 0x0F, 0x10, 0x10, 0x0E, 0x01, 0x01, 0x1E, 0x00, 0x00}}, // S
+    {0x0054, 5, {0x00, 0x1F, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x00, 0x00}}, // T
+    {0x0055, 5, {0x00, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0E, 0x00, 0x00}}, // U
+    {0x0056, 5, {0x00, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0A, 0x04, 0x00, 0x00}}, // V
+    {0x0057, 5, {0x00, 0x11, 0x11, 0x11, 0x15, 0x15, 0x15, 0x0A, 0x00, 0x00}}, // W
+    {0x0058, 5, {0x00, 0x11, 0x11, 0x0A, 0x04, 0x0A, 0x11, 0x11, 0x00, 0x00}}, // X
+    {0x0059, 5, {0x00, 0x11, 0x11, 0x0A, 0x04, 0x04, 0x04, 0x04, 0x00, 0x00}}, // Y
+    {0x005A, 5, {0x00, 0x1F, 0x01, 0x02, 0x04, 0x08, 0x10, 0x1F, 0x00, 0x00}}, // Z
+    {0x005B, 3, {0x00, 0x1C, 0x10, 0x10, 0x10, 0x10, 0x10, 0x1C, 0x00, 0x00}}, // [
+    {0x005C, 5, {0x00, 0x10, 0x10, 0x08, 0x04, 0x02, 0x01, 0x01, 0x00, 0x00}}, // barre oblique inverse
+    {0x005D, 3, {0x00, 0x1C, 0x04, 0x04, 0x04, 0x04, 0x04, 0x1C, 0x00, 0x00}}, // ]
+    {0x005E, 5, {0x00, 0x04, 0x0A, 0x11, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}}, // ^
+    {0x005F, 5, {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1F, 0x00}}, // _
+    {0x0060, 2, {0x00, 0x10, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}}, // `
+    {0x0061, 5, {0x00, 0x00, 0x00, 0x0E, 0x01, 0x0F, 0x11, 0x0F, 0x00, 0x00}}, // a
+    {0x0062, 5, {0x00, 0x10, 0x10, 0x1E, 0x11, 0x11, 0x11, 0x1E, 0x00, 0x00}}, // b
+    {0x0063, 5, {0x00, 0x00, 0x00, 0x0E, 0x10, 0x10, 0x11, 0x0E, 0x00, 0x00}}, // c
+    {0x0064, 5, {0x00, 0x01, 0x01, 0x0F, 0x11, 0x11, 0x11, 0x0F, 0x00, 0x00}}, // d
+    {0x0065, 5, {0x00, 0x00, 0x00, 0x0E, 0x11, 0x1F, 0x10, 0x0E, 0x00, 0x00}}, // e
+    {0x0066, 4, {0x00, 0x06, 0x08, 0x08, 0x1C, 0x08, 0x08, 0x08, 0x00, 0x00}}, // f
+    {0x0067, 5, {0x00, 0x00, 0x00, 0x0F, 0x11, 0x11, 0x0F, 0x01, 0x01, 0x0E}}, // g
+    {0x0068, 5, {0x00, 0x10, 0x10, 0x1E, 0x11, 0x11, 0x11, 0x11, 0x00, 0x00}}, // h
+    {0x0069, 3, {0x00, 0x08, 0x00, 0x18, 0x08, 0x08, 0x08, 0x1C, 0x00, 0x00}}, // i
+    {0x006A, 4, {0x00, 0x02, 0x00, 0x06, 0x02, 0x02, 0x02, 0x02, 0x12, 0x0C}}, // j
+    {0x006B, 4, {0x00, 0x10, 0x10, 0x12, 0x14, 0x18, 0x14, 0x12, 0x00, 0x00}}, // k
+    {0x006C, 3, {0x00, 0x18, 0x08, 0x08, 0x08, 0x08, 0x08, 0x1C, 0x00, 0x00}}, // l
+    {0x006D, 5, {0x00, 0x00, 0x00, 0x1A, 0x15, 0x15, 0x15, 0x15, 0x00, 0x00}}, // m
+    {0x006E, 5, {0x00, 0x00, 0x00, 0x1E, 0x11, 0x11, 0x11, 0x11, 0x00, 0x00}}, // n
+    {0x006F, 5, {0x00, 0x00, 0x00, 0x0E, 0x11, 0x11, 0x11, 0x0E, 0x00, 0x00}}, // o
+    {0x0070, 5, {0x00, 0x00, 0x00, 0x1E, 0x11, 0x11, 0x1E, 0x10, 0x10, 0x10}}, // p
+    {0x0071, 5, {0x00, 0x00, 0x00, 0x0F, 0x11, 0x11, 0x0F, 0x01, 0x01, 0x01}}, // q
+    {0x0072, 5, {0x00, 0x00, 0x00, 0x16, 0x19, 0x10, 0x10, 0x10, 0x00, 0x00}}, // r
+    {0x0073, 5, {0x00, 0x00, 0x00, 0x0F, 0x10, 0x0E, 0x01, 0x1E, 0x00, 0x00}}, // s
+    {0x0074, 4, {0x00, 0x08, 0x08, 0x1C, 0x08, 0x08, 0x08, 0x06, 0x00, 0x00}}, // t
+    {0x0075, 5, {0x00, 0x00, 0x00, 0x11, 0x11, 0x11, 0x13, 0x0D, 0x00, 0x00}}, // u
+    {0x0076, 5, {0x00, 0x00, 0x00, 0x11, 0x11, 0x11, 0x0A, 0x04, 0x00, 0x00}}, // v
+    {0x0077, 5, {0x00, 0x00, 0x00, 0x11, 0x11, 0x15, 0x15, 0x0A, 0x00, 0x00}}, // w
+    {0x0078, 5, {0x00, 0x00, 0x00, 0x11, 0x0A, 0x04, 0x0A, 0x11, 0x00, 0x00}}, // x
+    {0x0079, 5, {0x00, 0x00, 0x00, 0x11, 0x11, 0x11, 0x0F, 0x01, 0x01, 0x0E}}, // y
+    {0x007A, 5, {0x00, 0x00, 0x00, 0x1F, 0x02, 0x04, 0x08, 0x1F, 0x00, 0x00}}, // z
+    {0x007B, 3, {0x00, 0x04, 0x08, 0x08, 0x10, 0x08, 0x08, 0x04, 0x00, 0x00}}, // {
+    {0x007C, 1, {0x00, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x00, 0x00}}, // |
+    {0x007D, 3, {0x00, 0x10, 0x08, 0x08, 0x04, 0x08, 0x08, 0x10, 0x00, 0x00}}, // }
+    {0x007E, 5, {0x00, 0x00, 0x00, 0x08, 0x15, 0x02, 0x00, 0x00, 0x00, 0x00}}, // ~
+    {0x00E9, 5, {0x00, 0x02, 0x04, 0x0E, 0x11, 0x1F, 0x10, 0x0E, 0x00, 0x00}}, // é
+    {0x00E8, 5, {0x00, 0x08, 0x04, 0x0E, 0x11, 0x1F, 0x10, 0x0E, 0x00, 0x00}}, // è
+    {0x00EA, 5, {0x00, 0x04, 0x0A, 0x0E, 0x11, 0x1F, 0x10, 0x0E, 0x00, 0x00}}, // ê
+    {0x00EB, 5, {0x00, 0x0A, 0x00, 0x0E, 0x11, 0x1F, 0x10, 0x0E, 0x00, 0x00}}, // ë
+    {0x00E0, 5, {0x00, 0x08, 0x04, 0x0E, 0x01, 0x0F, 0x11, 0x0F, 0x00, 0x00}}, // à
+    {0x00E2, 5, {0x00, 0x04, 0x0A, 0x0E, 0x01, 0x0F, 0x11, 0x0F, 0x00, 0x00}}, // â
+    {0x00E4, 5, {0x00, 0x0A, 0x00, 0x0E, 0x01, 0x0F, 0x11, 0x0F, 0x00, 0x00}}, // ä
+    {0x00F4, 5, {0x00, 0x04, 0x0A, 0x0E, 0x11, 0x11, 0x11, 0x0E, 0x00, 0x00}}, // ô
+    {0x00F6, 5, {0x00, 0x0A, 0x00, 0x0E, 0x11, 0x11, 0x11, 0x0E, 0x00, 0x00}}, // ö
+    {0x00F9, 5, {0x00, 0x08, 0x04, 0x11, 0x11, 0x11, 0x13, 0x0D, 0x00, 0x00}}, // ù
+    {0x00FB, 5, {0x00, 0x04, 0x0A, 0x11, 0x11, 0x11, 0x13, 0x0D, 0x00, 0x00}}, // û
+    {0x00FC, 5, {0x00, 0x0A, 0x00, 0x11, 0x11, 0x11, 0x13, 0x0D, 0x00, 0x00}}, // ü
+    {0x00EE, 4, {0x00, 0x04, 0x0A, 0x0C, 0x04, 0x04, 0x04, 0x0E, 0x00, 0x00}}, // î
+    {0x00EF, 4, {0x00, 0x0A, 0x00, 0x0C, 0x04, 0x04, 0x04, 0x0E, 0x00, 0x00}}, // ï
+    {0x00E7, 5, {0x00, 0x00, 0x00, 0x0E, 0x10, 0x10, 0x11, 0x0E, 0x04, 0x08}}, // ç
+    {0x00C7, 5, {0x00, 0x0E, 0x11, 0x10, 0x10, 0x10, 0x11, 0x0E, 0x04, 0x08}}, // Ç
+    {0x00C9, 5, {0x02, 0x1F, 0x10, 0x10, 0x1E, 0x10, 0x10, 0x1F, 0x00, 0x00}}, // É
+    {0x00C8, 5, {0x08, 0x1F, 0x10, 0x10, 0x1E, 0x10, 0x10, 0x1F, 0x00, 0x00}}, // È
+    {0x00CA, 5, {0x0A, 0x1F, 0x10, 0x10, 0x1E, 0x10, 0x10, 0x1F, 0x00, 0x00}}, // Ê
+    {0x00C0, 5, {0x08, 0x0E, 0x11, 0x11, 0x1F, 0x11, 0x11, 0x11, 0x00, 0x00}}, // À
+    {0x0153, 5, {0x00, 0x00, 0x00, 0x0A, 0x15, 0x17, 0x14, 0x0F, 0x00, 0x00}}, // œ
+    {0x00AB, 5, {0x00, 0x00, 0x00, 0x05, 0x0A, 0x14, 0x0A, 0x05, 0x00, 0x00}}, // «
+    {0x00BB, 5, {0x00, 0x00, 0x00, 0x14, 0x0A, 0x05, 0x0A, 0x14, 0x00, 0x00}}, // »
+    {0x2019, 1, {0x00, 0x10, 0x10, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}}, // ’
+    {0x2026, 5, {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x15, 0x00, 0x00}}, // …
+    {0x00B0, 3, {0x00, 0x08, 0x14, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}}, // °
+};
+
+#define FONT_DATA_COUNT ((int)(sizeof(font_data) / sizeof(font_data[0])))
+
+Font *Font_createDefault(SDL_Renderer *renderer, int scale)
+{
+    Font *font = calloc(1, sizeof(Font));
+    if (!font)
+        return NULL;
+    font->glyphs = malloc(FONT_DATA_COUNT * sizeof(FontGlyph));
+    if (!font->glyphs)
+    {
+        fprintf(stderr, "Erreur d'allocation mémoire pour la police.\n");
+        free(font);
+        return NULL;
+    }
+    font->scale = scale > 0 ? scale : 1;
+    font->glyph_count = FONT_DATA_COUNT;
+
+    // Un glyphe par case de l'atlas, avec une colonne et une ligne vides pour éviter
+    // que le filtrage ne mélange deux glyphes voisins
+    const int cell_w = FONT_GLYPH_WIDTH + 1, cell_h = FONT_GLYPH_HEIGHT + 1;
+    font->atlas_width = FONT_ATLAS_COLUMNS * cell_w;
+    font->atlas_height = ((FONT_DATA_COUNT + FONT_ATLAS_COLUMNS - 1) / FONT_ATLAS_COLUMNS) * cell_h;
+    SDL_Surface *surface = SDL_CreateRGBSurfaceWithFormat(0, font->atlas_width, font->atlas_height, 32, SDL_PIXELFORMAT_RGBA32);
+    if (!surface)
+    {
+        fprintf(stderr, "Impossible de créer l'atlas de la police: %s\n", SDL_GetError());
+        Font_free(font);
+        return NULL;
+    }
+    SDL_LockSurface(surface);
+    memset(surface->pixels, 0, (size_t)surface->pitch * surface->h);
+
+    for (int i = 0; i < 95; i++)
+        font->ascii[i] = -1;
+    for (int i = 0; i < FONT_DATA_COUNT; i++)
+    {
+        const FontGlyphData *data = &font_data[i];
+        int cx = (i % FONT_ATLAS_COLUMNS) * cell_w, cy = (i / FONT_ATLAS_COLUMNS) * cell_h;
+        for (int row = 0; row < FONT_GLYPH_HEIGHT; row++)
+        {
+            uint32_t *line = (uint32_t *)((uint8_t *)surface->pixels + (cy + row) * surface->pitch);
+            for (int col = 0; col < FONT_GLYPH_WIDTH; col++)
+            {
+                if (data->rows[row] & (0x10 >> col))
+                    line[cx + col] = 0xFFFFFFFFu; // Blanc opaque, teinté par la couleur des sommets
+            }
+        }
+
+        font->glyphs[i].codepoint = data->codepoint;
+        font->glyphs[i].src = (SDL_Rect){cx, cy, data->width, FONT_GLYPH_HEIGHT};
+        font->glyphs[i].advance = data->width + 1;
+        if (data->codepoint >= 32 && data->codepoint < 127)
+            font->ascii[data->codepoint - 32] = i;
+    }
+    SDL_UnlockSurface(surface);
+    font->fallback = font->ascii['?' - 32];
+
+    font->atlas = SDL_CreateTextureFromSurface(renderer, surface);
+    SDL_FreeSurface(surface);
+    if (!font->atlas)
+    {
+        fprintf(stderr, "Impossible de créer la texture de la police: %s\n", SDL_GetError());
+        Font_free(font);
+        return NULL;
+    }
+    SDL_SetTextureBlendMode(font->atlas, SDL_BLENDMODE_BLEND);
+    return font;
+}
+
+void Font_free(Font *font)
+{
+    if (!font)
+        return;
+    if (font->atlas)
+        SDL_DestroyTexture(font->atlas);
+    free(font->glyphs);
+    free(font);
+}
+
+static int find_glyph(const Font *font, uint32_t codepoint)
+{
+    if (codepoint >= 32 && codepoint < 127)
+        return font->ascii[codepoint - 32] >= 0 ? font->ascii[codepoint - 32] : font->fallback;
+    if (codepoint == 0x00A0 || codepoint == 0x202F) // Espaces insécables (avant ! ? : ;)
+        return font->ascii[0];
+    for (int i = 95; i < font->glyph_count; i++)
+    {
+        if (font->glyphs[i].codepoint == codepoint)
+            return i;
+    }
+    return font->fallback;
+}
+
+// Décode un caractère UTF-8 et avance 's' ; les séquences invalides donnent U+FFFD
+static uint32_t next_codepoint(const char **s)
+{
+    const unsigned char *p = (const unsigned char *)*s;
+    uint32_t c = *p++;
+    int extra = c >= 0xF0 ? 3 : c >= 0xE0 ? 2 : c >= 0xC0 ? 1 : 0;
+    if (c >= 0x80 && extra == 0)
+    {
+        *s = (const char *)p;
+        return 0xFFFD;
+    }
+    c &= 0xFF >> (extra + 1 + (extra > 0));
+    for (int i = 0; i < extra; i++, p++)
+    {
+        if ((*p & 0xC0) != 0x80)
+        {
+            *s = (const char *)p;
+            return 0xFFFD;
+        }
+        c = (c << 6) | (*p & 0x3F);
+    }
+    *s = (const char *)p;
+    return c;
+}
+
+static uint32_t hash_text(const char *text, int maxWidth)
+{
+    uint32_t h = 2166136261u ^ (uint32_t)maxWidth;
+    for (; *text; text++)
+        h = (h ^ (unsigned char)*text) * 16777619u;
+    return h;
+}
+
+TextCache *TextCache_create(Font *font)
+{
+    TextCache *cache = calloc(1, sizeof(TextCache));
+    if (!cache)
+    {
+        fprintf(stderr, "Erreur d'allocation mémoire pour le cache de texte.\n");
+        return NULL;
+    }
+    cache->font = font;
+    for (int i = 0; i < TEXT_CACHE_BUCKETS; i++)
+        cache->buckets[i] = -1;
+    return cache;
+}
+
+static void free_layout(TextLayout *layout)
+{
+    free(layout->text);
+    free(layout->vertices);
+    free(layout->line_first);
+    layout->text = NULL;
+    layout->vertices = NULL;
+    layout->line_first = NULL;
+}
+
+void TextCache_free(TextCache *cache)
+{
+    if (!cache)
+        return;
+    for (int i = 0; i < cache->count; i++)
+        free_layout(&cache->entries[i]);
+    free(cache->indices);
+    free(cache);
+}
+
+// Indices partagés pour au moins 'glyphs' quads
+static bool ensure_indices(TextCache *cache, int glyphs)
+{
+    if (glyphs <= cache->index_glyphs)
+        return true;
+    int capacity = cache->index_glyphs ? cache->index_glyphs : 256;
+    while (capacity < glyphs)
+        capacity *= 2;
+    int *indices = realloc(cache->indices, capacity * 6 * sizeof(int));
+    if (!indices)
+        return false;
+    for (int g = cache->index_glyphs; g < capacity; g++)
+    {
+        int v = g * 4;
+        int *out = &indices[g * 6];
+        out[0] = v;
+        out[1] = v + 1;
+        out[2] = v + 2;
+        out[3] = v + 2;
+        out[4] = v + 1;
+        out[5] = v + 3;
+    }
+    cache->indices = indices;
+    cache->index_glyphs = capacity;
+    return true;
+}
+
+// Mise en page à l'origine (0, 0) : position de chaque glyphe, coupures de lignes
+static bool build_layout(TextCache *cache, TextLayout *layout)
+{
+    const Font *font = cache->font;
+    const int scale = font->scale, line_h = FONT_LINE_HEIGHT * scale;
+    size_t length = strlen(layout->text);
+
+    // Au plus un glyphe et une ligne par octet
+    int *glyph = malloc((length + 1) * sizeof(int));
+    int *gx = malloc((length + 1) * sizeof(int));
+    int *gline = malloc((length + 1) * sizeof(int));
+    layout->line_first = malloc((length + 2) * sizeof(int));
+    if (!glyph || !gx || !gline || !layout->line_first)
+    {
+        free(glyph);
+        free(gx);
+        free(gline);
+        return false;
+    }
+
+    int count = 0, line = 0, x = 0, width = 0;
+    int break_glyph = -1, break_x = 0; // Premier glyphe après le dernier espace de la ligne
+    layout->line_first[0] = 0;
+    for (const char *s = layout->text; *s;)
+    {
+        uint32_t c = next_codepoint(&s);
+        if (c == '\n')
+        {
+            width = SDL_max(width, x);
+            layout->line_first[++line] = count;
+            x = 0;
+            break_glyph = -1;
+            continue;
+        }
+
+        int g = find_glyph(font, c);
+        int advance = font->glyphs[g].advance * scale;
+        if (c == ' ')
+        {
+            x += advance;
+            break_glyph = count;
+            break_x = x;
+            continue;
+        }
+
+        // Dépassement : le mot en cours passe à la ligne suivante
+        if (layout->max_width > 0 && x + advance - scale > layout->max_width && x > 0)
+        {
+            if (break_glyph > layout->line_first[line])
+            {
+                for (int k = break_glyph; k < count; k++)
+                {
+                    gx[k] -= break_x;
+                    gline[k] = line + 1;
+                }
+                width = SDL_max(width, break_x - font->glyphs[font->ascii[0]].advance * scale);
+                x -= break_x;
+                layout->line_first[++line] = break_glyph;
+            }
+            else
+            {
+                // Mot plus long que la ligne : coupé là où il déborde
+                width = SDL_max(width, x);
+                layout->line_first[++line] = count;
+                x = 0;
+            }
+            break_glyph = -1;
+        }
+
+        glyph[count] = g;
+        gx[count] = x;
+        gline[count] = line;
+        count++;
+        x += advance;
+    }
+    width = SDL_max(width, x);
+
+    layout->line_count = line + 1;
+    layout->line_first[layout->line_count] = count;
+    layout->glyph_count = count;
+    layout->width = width > 0 ? width - scale : 0; // Sans l'espacement après le dernier glyphe
+    layout->height = layout->line_count * line_h;
+
+    layout->vertices = malloc((count > 0 ? count : 1) * 4 * sizeof(SDL_Vertex));
+    if (!layout->vertices || !ensure_indices(cache, count))
+    {
+        free(glyph);
+        free(gx);
+        free(gline);
+        return false;
+    }
+
+    const float inv_w = 1.0f / font->atlas_width, inv_h = 1.0f / font->atlas_height;
+    for (int k = 0; k < count; k++)
+    {
+        const SDL_Rect *src = &font->glyphs[glyph[k]].src;
+        float x0 = (float)gx[k], y0 = (float)(gline[k] * line_h);
+        float x1 = x0 + src->w * scale, y1 = y0 + src->h * scale;
+        float u0 = src->x * inv_w, v0 = src->y * inv_h;
+        float u1 = (src->x + src->w) * inv_w, v1 = (src->y + src->h) * inv_h;
+        SDL_Vertex *v = &layout->vertices[k * 4];
+        v[0] = (SDL_Vertex){{x0, y0}, {255, 255, 255, 255}, {u0, v0}};
+        v[1] = (SDL_Vertex){{x1, y0}, {255, 255, 255, 255}, {u1, v0}};
+        v[2] = (SDL_Vertex){{x0, y1}, {255, 255, 255, 255}, {u0, v1}};
+        v[3] = (SDL_Vertex){{x1, y1}, {255, 255, 255, 255}, {u1, v1}};
+    }
+    layout->origin_x = layout->origin_y = 0.0f;
+    layout->color = (SDL_Color){255, 255, 255, 255};
+
+    free(glyph);
+    free(gx);
+    free(gline);
+    return true;
+}
+
+static void unlink_entry(TextCache *cache, int index)
+{
+    int *link = &cache->buckets[cache->entries[index].hash & (TEXT_CACHE_BUCKETS - 1)];
+    while (*link != index)
+        link = &cache->entries[*link].next;
+    *link = cache->entries[index].next;
+}
+
+TextLayout *TextCache_get(TextCache *cache, const char *text, int maxWidth)
+{
+    if (!cache || !text)
+        return NULL;
+    cache->clock++;
+
+    uint32_t hash = hash_text(text, maxWidth);
+    int *bucket = &cache->buckets[hash & (TEXT_CACHE_BUCKETS - 1)];
+    for (int i = *bucket; i >= 0; i = cache->entries[i].next)
+    {
+        TextLayout *layout = &cache->entries[i];
+        if (layout->hash == hash && layout->max_width == maxWidth && strcmp(layout->text, text) == 0)
+        {
+            layout->last_used = cache->clock;
+            return layout;
+        }
+    }
+
+    // Absente : nouvelle entrée, ou remplacement de la moins récemment utilisée
+    int index = cache->count;
+    if (cache->count < TEXT_CACHE_CAPACITY)
+    {
+        cache->count++;
+    }
+    else
+    {
+        index = 0;
+        for (int i = 1; i < TEXT_CACHE_CAPACITY; i++)
+        {
+            if (cache->entries[i].last_used < cache->entries[index].last_used)
+                index = i;
+        }
+        unlink_entry(cache, index);
+        free_layout(&cache->entries[index]);
+    }
+
+    TextLayout *layout = &cache->entries[index];
+    memset(layout, 0, sizeof(TextLayout));
+    layout->text = strdup(text);
+    layout->max_width = maxWidth;
+    layout->hash = hash;
+    layout->last_used = cache->clock;
+    if (!layout->text || !build_layout(cache, layout))
+    {
+        fprintf(stderr, "Erreur d'allocation mémoire pour la mise en page du texte.\n");
+        free_layout(layout);
+        // L'entrée vide est rendue au cache en la déplaçant depuis la fin
+        cache->count--;
+        if (index != cache->count)
+        {
+            unlink_entry(cache, cache->count);
+            cache->entries[index] = cache->entries[cache->count];
+            int *moved = &cache->buckets[cache->entries[index].hash & (TEXT_CACHE_BUCKETS - 1)];
+            cache->entries[index].next = *moved;
+            *moved = index;
+        }
+        return NULL;
+    }
+    layout->next = *bucket;
+    *bucket = index;
+    return layout;
+}
+
+void Text_draw(TextCache *cache, SDL_Renderer *renderer, TextLayout *layout, int x, int y, SDL_Color color, int first, int count)
+{
+    if (!cache || !layout || first < 0 || first >= layout->glyph_count)
+        return;
+    if (count < 0 || first + count > layout->glyph_count)
+        count = layout->glyph_count - first;
+    if (count <= 0)
+        return;
+
+    // Les sommets gardent la dernière position et couleur : rien à refaire si elles n'ont pas changé
+    float dx = x - layout->origin_x, dy = y - layout->origin_y;
+    bool recolor = memcmp(&color, &layout->color, sizeof(SDL_Color)) != 0;
+    if (dx != 0.0f || dy != 0.0f || recolor)
+    {
+        for (int v = 0; v < layout->glyph_count * 4; v++)
+        {
+            layout->vertices[v].position.x += dx;
+            layout->vertices[v].position.y += dy;
+            layout->vertices[v].color = color;
+        }
+        layout->origin_x = (float)x;
+        layout->origin_y = (float)y;
+        layout->color = color;
+    }
+
+    SDL_RenderGeometry(renderer, cache->font->atlas, layout->vertices + first * 4, count * 4, cache->indices, count * 6);
+}
+
+void Text_drawString(TextCache *cache, SDL_Renderer *renderer, const char *text, int x, int y, SDL_Color color)
+{
+    Text_draw(cache, renderer, TextCache_get(cache, text, 0), x, y, color, 0, -1);
+}
@@ -0,0 +1,88 @@
+#ifndef TEXT_H
+#define TEXT_H
+
+#include <SDL2/SDL.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+// Rendu de texte avec une police bitmap. Les glyphes de la police intégrée
+// (5x10 pixels, ASCII et lettres accentuées du français) sont copiés une fois
+// dans une texture atlas. Une chaîne est mise en page une seule fois (UTF-8,
+// retour à la ligne sur les espaces) en une liste de quads gardée dans un cache
+// indexé par (texte, largeur) ; l'afficher est un seul SDL_RenderGeometry sur
+// l'atlas, quelle que soit sa longueur. N'afficher que les N premiers glyphes
+// (effet machine à écrire) ne refait pas la mise en page.
+
+#define FONT_GLYPH_WIDTH 5
+#define FONT_GLYPH_HEIGHT 10
+#define FONT_LINE_HEIGHT 11
+#define TEXT_CACHE_CAPACITY 64
+#define TEXT_CACHE_BUCKETS 128 // Puissance de 2
+
+typedef struct
+{
+    uint32_t codepoint;
+    SDL_Rect src; // Dans l'atlas
+    int advance;
+} FontGlyph;
+
+typedef struct
+{
+    SDL_Texture *atlas;
+    int atlas_width, atlas_height;
+    FontGlyph *glyphs;
+    int glyph_count;
+    int ascii[95]; // Glyphe des caractères 32 à 126, -1 si absent
+    int fallback;  // Glyphe des caractères inconnus ('?')
+    int scale;     // Facteur entier d'agrandissement des pixels
+} Font;
+
+typedef struct
+{
+    char *text;
+    int max_width; // 0 : pas de retour à la ligne automatique
+    uint32_t hash;
+
+    SDL_Vertex *vertices; // 4 par glyphe visible, dans l'ordre du texte
+    int glyph_count;
+    int *line_first; // Premier glyphe de chaque ligne
+    int line_count;
+    int width, height;
+
+    // Position et couleur actuellement appliquées aux sommets
+    float origin_x, origin_y;
+    SDL_Color color;
+
+    uint32_t last_used;
+    int next; // Entrée suivante du même seau, -1 en fin de liste
+} TextLayout;
+
+typedef struct
+{
+    Font *font;
+    TextLayout entries[TEXT_CACHE_CAPACITY];
+    int count;
+    int buckets[TEXT_CACHE_BUCKETS];
+    int *indices; // 0 1 2 2 1 3, 4 5 6 6 5 7, ... partagés par tous les textes
+    int index_glyphs;
+    uint32_t clock;
+} TextCache;
+
+Font *Font_createDefault(SDL_Renderer *renderer, int scale);
+void Font_free(Font *font);
+
+TextCache *TextCache_create(Font *font);
+void TextCache_free(TextCache *cache);
+
+// Mise en page de 'text' sur 'maxWidth' pixels, calculée au premier appel puis
+// reprise du cache. Le pointeur reste valide jusqu'au prochain TextCache_get.
+TextLayout *TextCache_get(TextCache *cache, const char *text, int maxWidth);
+
+// Dessine les glyphes [first, first + count[ d'une mise en page, en un appel
+// ; 'count' < 0 : jusqu'à la fin
+void Text_draw(TextCache *cache, SDL_Renderer *renderer, TextLayout *layout, int x, int y, SDL_Color color, int first, int count);
+
+// Raccourci : mise en page (sans retour à la ligne) et dessin d'une chaîne
+void Text_drawString(TextCache *cache, SDL_Renderer *renderer, const char *text, int x, int y, SDL_Color color);
+
+#endif
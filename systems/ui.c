@@ -0,0 +1,396 @@
+#include "ui.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+UI *UI_create(SDL_Renderer *renderer, TextCache *text, int width, int height)
+{
+    UI *ui = calloc(1, sizeof(UI));
+    if (!ui)
+    {
+        fprintf(stderr, "Erreur d'allocation mémoire pour l'interface.\n");
+        return NULL;
+    }
+
+    ui->target = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, width, height);
+    if (!ui->target)
+    {
+        fprintf(stderr, "Erreur lors de la création de la texture de l'interface : %s\n", SDL_GetError());
+        free(ui);
+        return NULL;
+    }
+    SDL_SetTextureBlendMode(ui->target, SDL_BLENDMODE_BLEND);
+    ui->width = width;
+    ui->height = height;
+    ui->text = text;
+    UI_invalidate(ui);
+    return ui;
+}
+
+void UI_free(UI *ui)
+{
+    if (!ui)
+        return;
+    SDL_DestroyTexture(ui->target);
+    free(ui);
+}
+
+static void mark(UI *ui, const SDL_Rect *rect)
+{
+    if (rect->w <= 0 || rect->h <= 0)
+        return;
+    if (ui->has_dirty)
+        SDL_UnionRect(&ui->dirty, rect, &ui->dirty);
+    else
+        ui->dirty = *rect;
+    ui->has_dirty = true;
+}
+
+void UI_clear(UI *ui)
+{
+    ui->count = 0;
+    ui->row_count = 0;
+    UI_invalidate(ui);
+}
+
+void UI_invalidate(UI *ui)
+{
+    ui->dirty = (SDL_Rect){0, 0, ui->width, ui->height};
+    ui->has_dirty = true;
+}
+
+static UIWidget *get(UI *ui, int id, UIWidgetType type)
+{
+    if (id < 0 || id >= ui->count || ui->widgets[id].type != type)
+        return NULL;
+    return &ui->widgets[id];
+}
+
+static int add_widget(UI *ui, int parent, UIWidgetType type, SDL_Rect rect)
+{
+    if (ui->count >= UI_MAX_WIDGETS || parent >= ui->count)
+    {
+        fprintf(stderr, "Interface pleine ou parent inconnu (%d widgets)\n", ui->count);
+        return UI_NONE;
+    }
+
+    UIWidget *w = &ui->widgets[ui->count];
+    memset(w, 0, sizeof(UIWidget));
+    w->type = type;
+    w->visible = true;
+    w->parent = parent < 0 ? UI_NONE : parent;
+    w->bounds = rect;
+    if (parent >= 0)
+    {
+        w->bounds.x += ui->widgets[parent].bounds.x;
+        w->bounds.y += ui->widgets[parent].bounds.y;
+    }
+    mark(ui, &w->bounds);
+    return ui->count++;
+}
+
+int UI_addPanel(UI *ui, int parent, SDL_Rect rect, SDL_Color fill, SDL_Color border)
+{
+    int id = add_widget(ui, parent, UI_PANEL, rect);
+    if (id != UI_NONE)
+    {
+        ui->widgets[id].color = fill;
+        ui->widgets[id].accent = border;
+    }
+    return id;
+}
+
+int UI_addLabel(UI *ui, int parent, SDL_Rect rect, const char *text, SDL_Color ink)
+{
+    int id = add_widget(ui, parent, UI_LABEL, rect);
+    if (id != UI_NONE)
+    {
+        ui->widgets[id].color = ink;
+        snprintf(ui->widgets[id].text, UI_TEXT_MAX, "%s", text ? text : "");
+    }
+    return id;
+}
+
+int UI_addList(UI *ui, int parent, SDL_Rect rect, int capacity, SDL_Color ink, SDL_Color highlight)
+{
+    if (ui->row_count + capacity > UI_MAX_ROWS)
+    {
+        fprintf(stderr, "Plus de lignes disponibles pour une liste de %d lignes\n", capacity);
+        return UI_NONE;
+    }
+
+    int id = add_widget(ui, parent, UI_LIST, rect);
+    if (id == UI_NONE)
+        return UI_NONE;
+
+    UIWidget *w = &ui->widgets[id];
+    w->color = ink;
+    w->accent = highlight;
+    w->first_row = ui->row_count;
+    w->row_capacity = capacity;
+    w->row_height = FONT_LINE_HEIGHT * ui->text->font->scale + 3;
+    memset(&ui->rows[w->first_row], 0, capacity * sizeof(UIListRow));
+    ui->row_count += capacity;
+    return id;
+}
+
+int UI_addBar(UI *ui, int parent, SDL_Rect rect, SDL_Color fill, SDL_Color back)
+{
+    int id = add_widget(ui, parent, UI_BAR, rect);
+    if (id != UI_NONE)
+    {
+        ui->widgets[id].color = fill;
+        ui->widgets[id].accent = back;
+    }
+    return id;
+}
+
+int UI_addIcon(UI *ui, int parent, SDL_Rect rect, SDL_Texture *texture, SDL_Rect src)
+{
+    int id = add_widget(ui, parent, UI_ICON, rect);
+    if (id != UI_NONE)
+    {
+        ui->widgets[id].texture = texture;
+        ui->widgets[id].src = src;
+    }
+    return id;
+}
+
+void UI_setVisible(UI *ui, int id, bool visible)
+{
+    if (id < 0 || id >= ui->count || ui->widgets[id].visible == visible)
+        return;
+    ui->widgets[id].visible = visible;
+    mark(ui, &ui->widgets[id].bounds);
+}
+
+void UI_setText(UI *ui, int id, const char *text)
+{
+    UIWidget *w = get(ui, id, UI_LABEL);
+    if (!w || strncmp(w->text, text, UI_TEXT_MAX - 1) == 0)
+        return;
+    snprintf(w->text, UI_TEXT_MAX, "%s", text);
+    mark(ui, &w->bounds);
+}
+
+void UI_setColor(UI *ui, int id, SDL_Color color)
+{
+    if (id < 0 || id >= ui->count)
+        return;
+    UIWidget *w = &ui->widgets[id];
+    if (memcmp(&w->color, &color, sizeof(SDL_Color)) == 0)
+        return;
+    w->color = color;
+    mark(ui, &w->bounds);
+}
+
+void UI_setBar(UI *ui, int id, int value, int max)
+{
+    UIWidget *w = get(ui, id, UI_BAR);
+    if (!w || (w->value == value && w->max == max))
+        return;
+    w->value = value;
+    w->max = max;
+    mark(ui, &w->bounds);
+}
+
+void UI_setIcon(UI *ui, int id, SDL_Texture *texture, SDL_Rect src)
+{
+    UIWidget *w = get(ui, id, UI_ICON);
+    if (!w || (w->texture == texture && SDL_RectEquals(&w->src, &src)))
+        return;
+    w->texture = texture;
+    w->src = src;
+    mark(ui, &w->bounds);
+}
+
+static int visible_rows(const UIWidget *w)
+{
+    return w->row_height > 0 ? w->bounds.h / w->row_height : 0;
+}
+
+// Rectangle d'une ligne de liste, vide si elle est hors de la partie affichée
+static SDL_Rect row_rect(const UIWidget *w, int row)
+{
+    int shown = row - w->scroll;
+    if (shown < 0 || shown >= visible_rows(w))
+        return (SDL_Rect){0, 0, 0, 0};
+    return (SDL_Rect){w->bounds.x, w->bounds.y + shown * w->row_height, w->bounds.w, w->row_height};
+}
+
+void UI_setListRow(UI *ui, int id, int row, const char *text, const char *detail)
+{
+    UIWidget *w = get(ui, id, UI_LIST);
+    if (!w || row < 0 || row >= w->row_capacity)
+        return;
+
+    UIListRow *r = &ui->rows[w->first_row + row];
+    if (!detail)
+        detail = "";
+    if (strncmp(r->text, text, UI_TEXT_MAX - 1) == 0 && strncmp(r->detail, detail, UI_DETAIL_MAX - 1) == 0)
+        return;
+    snprintf(r->text, UI_TEXT_MAX, "%s", text);
+    snprintf(r->detail, UI_DETAIL_MAX, "%s", detail);
+    if (row < w->row_count)
+    {
+        SDL_Rect rect = row_rect(w, row);
+        mark(ui, &rect);
+    }
+}
+
+// Fait défiler la liste pour garder la sélection affichée ; true si le défilement change
+static bool update_scroll(UIWidget *w)
+{
+    int rows = visible_rows(w), scroll = w->scroll;
+    if (w->selected < scroll)
+        scroll = w->selected;
+    else if (w->selected >= scroll + rows)
+        scroll = w->selected - rows + 1;
+    if (scroll > w->row_count - rows)
+        scroll = w->row_count - rows;
+    if (scroll < 0)
+        scroll = 0;
+
+    bool changed = scroll != w->scroll;
+    w->scroll = scroll;
+    return changed;
+}
+
+void UI_setListCount(UI *ui, int id, int count)
+{
+    UIWidget *w = get(ui, id, UI_LIST);
+    if (!w)
+        return;
+    count = SDL_clamp(count, 0, w->row_capacity);
+    if (count == w->row_count)
+        return;
+
+    w->row_count = count;
+    if (w->selected >= count)
+        w->selected = count > 0 ? count - 1 : 0;
+    update_scroll(w);
+    mark(ui, &w->bounds);
+}
+
+void UI_setListSelection(UI *ui, int id, int selected)
+{
+    UIWidget *w = get(ui, id, UI_LIST);
+    if (!w || w->row_count == 0)
+        return;
+    selected = SDL_clamp(selected, 0, w->row_count - 1);
+    if (selected == w->selected)
+        return;
+
+    SDL_Rect before = row_rect(w, w->selected);
+    w->selected = selected;
+    if (update_scroll(w))
+    {
+        mark(ui, &w->bounds);
+        return;
+    }
+    SDL_Rect after = row_rect(w, selected);
+    mark(ui, &before);
+    mark(ui, &after);
+}
+
+static void draw_text(UI *ui, SDL_Renderer *renderer, const char *text, int x, int y, SDL_Color ink)
+{
+    if (text[0])
+        Text_drawString(ui->text, renderer, text, x, y, ink);
+}
+
+static void draw_list(UI *ui, SDL_Renderer *renderer, const UIWidget *w)
+{
+    int last = SDL_min(w->row_count, w->scroll + visible_rows(w));
+    for (int row = w->scroll; row < last; row++)
+    {
+        SDL_Rect rect = row_rect(w, row);
+        if (!SDL_HasIntersection(&rect, &ui->dirty))
+            continue;
+
+        if (row == w->selected)
+        {
+            SDL_SetRenderDrawColor(renderer, w->accent.r, w->accent.g, w->accent.b, w->accent.a);
+            SDL_RenderFillRect(renderer, &rect);
+        }
+        const UIListRow *r = &ui->rows[w->first_row + row];
+        draw_text(ui, renderer, r->text, rect.x + 3, rect.y + 2, w->color);
+        if (r->detail[0])
+        {
+            TextLayout *layout = TextCache_get(ui->text, r->detail, 0);
+            if (layout)
+                Text_draw(ui->text, renderer, layout, rect.x + rect.w - 3 - layout->width, rect.y + 2, w->color, 0, -1);
+        }
+    }
+}
+
+static void draw_widget(UI *ui, SDL_Renderer *renderer, const UIWidget *w)
+{
+    switch (w->type)
+    {
+    case UI_PANEL:
+        SDL_SetRenderDrawColor(renderer, w->color.r, w->color.g, w->color.b, w->color.a);
+        SDL_RenderFillRect(renderer, &w->bounds);
+        SDL_SetRenderDrawColor(renderer, w->accent.r, w->accent.g, w->accent.b, w->accent.a);
+        SDL_RenderDrawRect(renderer, &w->bounds);
+        break;
+    case UI_LABEL:
+        draw_text(ui, renderer, w->text, w->bounds.x, w->bounds.y, w->color);
+        break;
+    case UI_LIST:
+        draw_list(ui, renderer, w);
+        break;
+    case UI_BAR:
+    {
+        SDL_Rect filled = w->bounds;
+        filled.w = w->max > 0 ? w->bounds.w * SDL_clamp(w->value, 0, w->max) / w->max : 0;
+        SDL_SetRenderDrawColor(renderer, w->accent.r, w->accent.g, w->accent.b, w->accent.a);
+        SDL_RenderFillRect(renderer, &w->bounds);
+        SDL_SetRenderDrawColor(renderer, w->color.r, w->color.g, w->color.b, w->color.a);
+        SDL_RenderFillRect(renderer, &filled);
+        break;
+    }
+    case UI_ICON:
+        if (w->texture)
+            SDL_RenderCopy(renderer, w->texture, &w->src, &w->bounds);
+        break;
+    }
+}
+
+void UI_render(UI *ui, SDL_Renderer *renderer)
+{
+    if (!ui || ui->count == 0)
+        return;
+
+    if (ui->has_dirty)
+    {
+        SDL_Texture *previous = SDL_GetRenderTarget(renderer);
+        SDL_BlendMode blend;
+        SDL_GetRenderDrawBlendMode(renderer, &blend);
+        SDL_SetRenderTarget(renderer, ui->target);
+        SDL_RenderSetClipRect(renderer, &ui->dirty);
+
+        // La zone redevient transparente, puis les widgets qui la touchent sont
+        // redessinés dans l'ordre de l'arbre
+        SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
+        SDL_SetRenderDrawColor(renderer, 0, 0, 0, 0);
+        SDL_RenderFillRect(renderer, &ui->dirty);
+        SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+
+        bool shown[UI_MAX_WIDGETS];
+        for (int i = 0; i < ui->count; i++)
+        {
+            const UIWidget *w = &ui->widgets[i];
+            shown[i] = w->visible && (w->parent == UI_NONE || shown[w->parent]);
+            if (shown[i] && SDL_HasIntersection(&w->bounds, &ui->dirty))
+                draw_widget(ui, renderer, w);
+        }
+
+        SDL_RenderSetClipRect(renderer, NULL);
+        SDL_SetRenderTarget(renderer, previous);
+        SDL_SetRenderDrawBlendMode(renderer, blend);
+        ui->has_dirty = false;
+    }
+
+    SDL_RenderCopy(renderer, ui->target, NULL, NULL);
+}
@@ -0,0 +1,105 @@
+#ifndef UI_H
+#define UI_H
+
+#include <SDL2/SDL.h>
+#include <stdbool.h>
+#include "text.h"
+
+// Interface en mode retenu : un arbre de widgets (panneaux, textes, listes, barres,
+// icônes) dessiné dans sa propre texture cible. Modifier un widget ne fait que
+// marquer son rectangle ; UI_render ne redessine que l'union des rectangles
+// marqués (les widgets qui la touchent, découpés par un clip), puis compose la
+// texture sur l'écran en une seule copie. Un menu immobile ne coûte donc qu'un
+// SDL_RenderCopy par frame.
+//
+// Un widget est toujours ajouté après son parent : l'ordre du tableau est celui
+// du dessin (parent sous ses enfants) et il n'y a pas de liens à parcourir.
+
+#define UI_MAX_WIDGETS 64
+#define UI_MAX_ROWS 64 // Lignes de toutes les listes
+#define UI_TEXT_MAX 48
+#define UI_DETAIL_MAX 16
+#define UI_NONE -1
+
+typedef enum
+{
+    UI_PANEL, // Fond plein et bordure
+    UI_LABEL, // Une ligne de texte
+    UI_LIST,  // Lignes de texte (détail aligné à droite), une sélectionnée
+    UI_BAR,   // Jauge (PV)
+    UI_ICON   // Rectangle d'une texture (frame d'un sprite)
+} UIWidgetType;
+
+typedef struct
+{
+    char text[UI_TEXT_MAX];
+    char detail[UI_DETAIL_MAX];
+} UIListRow;
+
+typedef struct
+{
+    UIWidgetType type;
+    bool visible;
+    int parent;
+    SDL_Rect bounds; // Absolu, dans la texture de l'interface
+
+    SDL_Color color;  // Fond (panneau), encre (texte, liste), remplissage (barre)
+    SDL_Color accent; // Bordure (panneau), sélection (liste), fond (barre)
+
+    char text[UI_TEXT_MAX]; // UI_LABEL
+
+    int first_row, row_capacity; // UI_LIST : lignes [first_row, first_row + row_capacity[ du pool
+    int row_count, selected, scroll;
+    int row_height;
+
+    int value, max; // UI_BAR
+
+    SDL_Texture *texture; // UI_ICON (non possédée)
+    SDL_Rect src;
+} UIWidget;
+
+typedef struct
+{
+    SDL_Texture *target;
+    int width, height;
+    TextCache *text;
+
+    UIWidget widgets[UI_MAX_WIDGETS];
+    int count;
+    UIListRow rows[UI_MAX_ROWS];
+    int row_count;
+
+    SDL_Rect dirty; // Union des zones à redessiner
+    bool has_dirty;
+} UI;
+
+UI *UI_create(SDL_Renderer *renderer, TextCache *text, int width, int height);
+void UI_free(UI *ui);
+
+// Retire tous les widgets (changement d'écran)
+void UI_clear(UI *ui);
+// Tout redessiner, par exemple quand le contenu de la texture cible est perdu
+void UI_invalidate(UI *ui);
+
+// Ajouts : 'rect' est relatif au parent (UI_NONE : l'écran). Retournent
+// l'identifiant du widget, UI_NONE si l'interface est pleine.
+int UI_addPanel(UI *ui, int parent, SDL_Rect rect, SDL_Color fill, SDL_Color border);
+int UI_addLabel(UI *ui, int parent, SDL_Rect rect, const char *text, SDL_Color ink);
+int UI_addList(UI *ui, int parent, SDL_Rect rect, int capacity, SDL_Color ink, SDL_Color highlight);
+int UI_addBar(UI *ui, int parent, SDL_Rect rect, SDL_Color fill, SDL_Color back);
+int UI_addIcon(UI *ui, int parent, SDL_Rect rect, SDL_Texture *texture, SDL_Rect src);
+
+// Modifications : ne marquent le widget que si la valeur change
+void UI_setVisible(UI *ui, int id, bool visible);
+void UI_setText(UI *ui, int id, const char *text);
+void UI_setColor(UI *ui, int id, SDL_Color color);
+void UI_setBar(UI *ui, int id, int value, int max);
+void UI_setIcon(UI *ui, int id, SDL_Texture *texture, SDL_Rect src);
+void UI_setListRow(UI *ui, int id, int row, const char *text, const char *detail);
+void UI_setListCount(UI *ui, int id, int count);
+void UI_setListSelection(UI *ui, int id, int selected);
+
+// Redessine les zones marquées dans la texture puis la compose sur l'écran
+void UI_render(UI *ui, SDL_Renderer *renderer);
+
+#endif
@@ -0,0 +1,216 @@
+#include "watcher.h"
+#include <dirent.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#ifdef __linux__
+#include <sys/inotify.h>
+#endif
+
+#define WATCHER_MAX_BATCH 32 // Fichiers distincts traités par appel à FileWatcher_poll
+
+// Empreinte FNV-1a du contenu d'un fichier, 0 s'il est illisible
+static uint64_t hash_file(const char *path)
+{
+    FILE *file = fopen(path, "rb");
+    if (!file)
+        return 0;
+
+    uint64_t hash = 1469598103934665603ULL;
+    unsigned char buffer[16384];
+    size_t read;
+    while ((read = fread(buffer, 1, sizeof(buffer), file)) > 0)
+    {
+        for (size_t i = 0; i < read; i++)
+        {
+            hash ^= buffer[i];
+            hash *= 1099511628211ULL;
+        }
+    }
+    fclose(file);
+    return hash;
+}
+
+static WatchedFile *find_file(FileWatcher *watcher, const char *path)
+{
+    for (int i = 0; i < watcher->file_count; i++)
+    {
+        if (strcmp(watcher->files[i].path, path) == 0)
+            return &watcher->files[i];
+    }
+    return NULL;
+}
+
+static void record_file(FileWatcher *watcher, const char *path, uint64_t hash)
+{
+    WatchedFile *file = find_file(watcher, path);
+    if (!file)
+    {
+        if (watcher->file_count >= WATCHER_MAX_FILES)
+            return; // Non suivi : sera signalé à chaque écriture
+        file = &watcher->files[watcher->file_count++];
+        snprintf(file->path, sizeof(file->path), "%s", path);
+    }
+    file->hash = hash;
+}
+
+#ifdef __linux__
+// Un fichier peut produire plusieurs événements : chaque chemin n'attend qu'une fois
+static void queue_change(FileWatcher *watcher, const char *path)
+{
+    for (int i = 0; i < watcher->pending_count; i++)
+    {
+        if (strcmp(watcher->pending[i], path) == 0)
+            return;
+    }
+    if (watcher->pending_count >= WATCHER_MAX_PENDING)
+    {
+        fprintf(stderr, "Trop de fichiers modifiés en attente, %s ignoré\n", path);
+        return;
+    }
+    snprintf(watcher->pending[watcher->pending_count++], WATCHER_PATH_MAX, "%s", path);
+}
+#endif
+
+FileWatcher *FileWatcher_create(void)
+{
+    FileWatcher *watcher = calloc(1, sizeof(FileWatcher));
+    if (!watcher)
+    {
+        fprintf(stderr, "Erreur d'allocation mémoire pour la surveillance des fichiers.\n");
+        return NULL;
+    }
+
+#ifdef __linux__
+    watcher->fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (watcher->fd < 0)
+        perror("inotify_init1");
+#else
+    watcher->fd = -1;
+#endif
+    return watcher;
+}
+
+void FileWatcher_free(FileWatcher *watcher)
+{
+    if (!watcher)
+        return;
+    if (watcher->fd >= 0)
+        close(watcher->fd);
+    free(watcher);
+}
+
+bool FileWatcher_addDirectory(FileWatcher *watcher, const char *path, bool recursive)
+{
+    if (!watcher || watcher->fd < 0)
+        return false;
+    if (watcher->dir_count >= WATCHER_MAX_DIRS)
+    {
+        fprintf(stderr, "Trop de répertoires surveillés, %s ignoré\n", path);
+        return false;
+    }
+
+    DIR *dir = opendir(path);
+    if (!dir)
+        return false;
+
+#ifdef __linux__
+    // Écriture terminée ou fichier remplacé (les éditeurs écrivent souvent un
+    // fichier temporaire puis le renomment)
+    int wd = inotify_add_watch(watcher->fd, path, IN_CLOSE_WRITE | IN_MOVED_TO);
+    if (wd < 0)
+    {
+        perror(path);
+        closedir(dir);
+        return false;
+    }
+    WatchedDir *watched = &watcher->dirs[watcher->dir_count++];
+    watched->wd = wd;
+    snprintf(watched->path, sizeof(watched->path), "%s", path);
+#endif
+
+    struct dirent *entry;
+    char child[WATCHER_PATH_MAX];
+    while ((entry = readdir(dir)))
+    {
+        if (entry->d_name[0] == '.')
+            continue;
+        if (snprintf(child, sizeof(child), "%s/%s", path, entry->d_name) >= (int)sizeof(child))
+            continue; // Chemin trop long
+        struct stat info;
+        if (stat(child, &info) != 0)
+            continue;
+        if (S_ISDIR(info.st_mode))
+        {
+            if (recursive)
+                FileWatcher_addDirectory(watcher, child, true);
+        }
+        else if (S_ISREG(info.st_mode))
+        {
+            record_file(watcher, child, hash_file(child));
+        }
+    }
+    closedir(dir);
+    return true;
+}
+
+int FileWatcher_poll(FileWatcher *watcher, FileWatcherCallback callback, void *user)
+{
+    if (!watcher || watcher->fd < 0)
+        return 0;
+
+#ifdef __linux__
+    char buffer[4096] __attribute__((aligned(__alignof__(struct inotify_event))));
+    ssize_t length;
+    while ((length = read(watcher->fd, buffer, sizeof(buffer))) > 0)
+    {
+        for (char *p = buffer; p < buffer + length;)
+        {
+            const struct inotify_event *event = (const struct inotify_event *)p;
+            p += sizeof(struct inotify_event) + event->len;
+            if (event->len == 0 || event->name[0] == '.' || (event->mask & IN_ISDIR))
+                continue;
+
+            const char *dir = NULL;
+            for (int d = 0; d < watcher->dir_count && !dir; d++)
+            {
+                if (watcher->dirs[d].wd == event->wd)
+                    dir = watcher->dirs[d].path;
+            }
+            if (!dir)
+                continue;
+
+            char path[WATCHER_PATH_MAX];
+            if (snprintf(path, sizeof(path), "%s/%s", dir, event->name) >= (int)sizeof(path))
+                continue;
+            queue_change(watcher, path);
+        }
+    }
+
+    // Les plus anciens d'abord, les suivants restent en attente
+    int batch = watcher->pending_count < WATCHER_MAX_BATCH ? watcher->pending_count : WATCHER_MAX_BATCH;
+    int reported = 0;
+    for (int c = 0; c < batch; c++)
+    {
+        // Contenu identique (fichier réenregistré tel quel) : rien à recharger
+        const char *changed = watcher->pending[c];
+        uint64_t hash = hash_file(changed);
+        WatchedFile *file = find_file(watcher, changed);
+        if (hash == 0 || (file && file->hash == hash))
+            continue;
+        record_file(watcher, changed, hash);
+        callback(user, changed);
+        reported++;
+    }
+    watcher->pending_count -= batch;
+    memmove(watcher->pending, watcher->pending[batch], (size_t)watcher->pending_count * WATCHER_PATH_MAX);
+    return reported;
+#else
+    (void)callback;
+    (void)user;
+    return 0;
+#endif
+}
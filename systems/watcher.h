@@ -0,0 +1,57 @@
+#ifndef WATCHER_H
+#define WATCHER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Surveillance de fichiers pour le rechargement à chaud (inotify sous Linux,
+// inactif ailleurs). FileWatcher_poll ne bloque jamais : il lit les événements
+// en attente, regroupe ceux d'un même fichier, et ne signale que les fichiers
+// dont le contenu a réellement changé (empreinte du contenu gardée par fichier),
+// pour qu'un enregistrement sans modification ne recharge rien. Au-delà d'un
+// lot par appel, les fichiers modifiés attendent les appels suivants.
+
+#define WATCHER_MAX_DIRS 64
+#define WATCHER_MAX_FILES 256
+#define WATCHER_PATH_MAX 256
+#define WATCHER_MAX_PENDING 256 // Fichiers modifiés pas encore signalés
+
+typedef struct
+{
+    int wd;
+    char path[WATCHER_PATH_MAX];
+} WatchedDir;
+
+typedef struct
+{
+    char path[WATCHER_PATH_MAX];
+    uint64_t hash; // Empreinte du contenu au dernier signalement
+} WatchedFile;
+
+// 'path' : chemin du fichier modifié, sous le répertoire surveillé
+typedef void (*FileWatcherCallback)(void *user, const char *path);
+
+typedef struct
+{
+    int fd; // -1 : surveillance indisponible
+    WatchedDir dirs[WATCHER_MAX_DIRS];
+    int dir_count;
+    WatchedFile files[WATCHER_MAX_FILES];
+    int file_count;
+    char pending[WATCHER_MAX_PENDING][WATCHER_PATH_MAX]; // Dans l'ordre des événements
+    int pending_count;
+} FileWatcher;
+
+FileWatcher *FileWatcher_create(void);
+void FileWatcher_free(FileWatcher *watcher);
+
+// Surveille les fichiers écrits ou remplacés dans 'path' (et ses sous-répertoires
+// si 'recursive') ; les fichiers déjà présents sont relevés comme référence
+bool FileWatcher_addDirectory(FileWatcher *watcher, const char *path, bool recursive);
+
+// Appelle 'callback' pour chaque fichier modifié depuis le dernier appel, au plus
+// un lot de fichiers distincts (le reste au prochain appel) ; retourne le nombre
+// de fichiers signalés
+int FileWatcher_poll(FileWatcher *watcher, FileWatcherCallback callback, void *user);
+
+#endif
@@ -0,0 +1,120 @@
+// Vérification de l'audio sur le pilote factice de SDL (voir systems/audio.h)
+//
+//   audiocheck [bruitage.wav] [musique.wav]
+//
+// Force SDL_AUDIODRIVER=dummy : le callback tourne sur le thread audio de SDL
+// sans carte son. Joue le bruitage jusqu'à ce que sa voix se libère, lance la
+// musique puis l'éteint en fondu jusqu'à la fermeture du fichier.
+// Code de sortie non nul si un fichier ne se charge pas ou si le mixage n'avance pas.
+#include "../systems/audio.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+#define DEFAULT_SOUND "resources/sounds/select.wav"
+#define DEFAULT_MUSIC "resources/sounds/town.wav"
+#define FADE_MS 100
+#define TIMEOUT_MS 2000
+
+static bool voices_idle(AudioManager *audio)
+{
+    SDL_LockAudioDevice(audio->device);
+    bool idle = true;
+    for (int v = 0; v < AUDIO_VOICES; v++)
+        idle = idle && !audio->voices[v].sound;
+    SDL_UnlockAudioDevice(audio->device);
+    return idle;
+}
+
+static Uint32 music_position(AudioManager *audio)
+{
+    SDL_LockAudioDevice(audio->device);
+    Uint32 position = audio->music[audio->current].position;
+    SDL_UnlockAudioDevice(audio->device);
+    return position;
+}
+
+static bool music_closed(AudioManager *audio)
+{
+    AudioManager_update(audio);
+    return !audio->music[0].file && !audio->music[1].file;
+}
+
+// Attend que 'done' soit vrai, au plus TIMEOUT_MS millisecondes
+static bool wait_for(AudioManager *audio, bool (*done)(AudioManager *))
+{
+    Uint32 start = SDL_GetTicks();
+    while (!done(audio))
+    {
+        if (SDL_GetTicks() - start > TIMEOUT_MS)
+            return false;
+        SDL_Delay(10);
+    }
+    return true;
+}
+
+int main(int argc, char **argv)
+{
+    const char *sound_path = argc > 1 ? argv[1] : DEFAULT_SOUND;
+    const char *music_path = argc > 2 ? argv[2] : DEFAULT_MUSIC;
+
+    setenv("SDL_AUDIODRIVER", "dummy", 1);
+    AudioManager *audio = AudioManager_create();
+    if (!audio)
+        return 1;
+    AudioManager_setVolumes(audio, 0.5f, 2.0f);
+
+    int errors = 0;
+    if (audio->music_volume != 0.5f || audio->sound_volume != 1.0f)
+    {
+        fprintf(stderr, "Volumes non bornés à [0, 1]\n");
+        errors++;
+    }
+
+    int sound = AudioManager_loadSound(audio, sound_path);
+    if (sound < 0 || audio->sounds[sound].frames == 0)
+    {
+        fprintf(stderr, "Bruitage %s non chargé\n", sound_path);
+        errors++;
+    }
+    else if (AudioManager_loadSound(audio, sound_path) != sound)
+    {
+        fprintf(stderr, "Bruitage %s chargé deux fois\n", sound_path);
+        errors++;
+    }
+    else
+    {
+        AudioManager_playSound(audio, sound, 1.0f);
+        if (!wait_for(audio, voices_idle))
+        {
+            fprintf(stderr, "Bruitage %s jamais terminé\n", sound_path);
+            errors++;
+        }
+    }
+
+    if (!AudioManager_playMusic(audio, music_path, FADE_MS))
+    {
+        fprintf(stderr, "Musique %s non ouverte\n", music_path);
+        errors++;
+    }
+    else
+    {
+        SDL_Delay(FADE_MS * 2);
+        Uint32 position = music_position(audio);
+        if (position == 0)
+        {
+            fprintf(stderr, "Musique %s : aucune frame mixée\n", music_path);
+            errors++;
+        }
+        AudioManager_playMusic(audio, NULL, FADE_MS);
+        if (!wait_for(audio, music_closed))
+        {
+            fprintf(stderr, "Musique %s jamais éteinte\n", music_path);
+            errors++;
+        }
+    }
+
+    printf("Audio (%s) : %d Hz, %d canaux, %d erreurs\n", SDL_GetCurrentAudioDriver(), audio->spec.freq, audio->spec.channels, errors);
+    AudioManager_free(audio);
+    SDL_Quit();
+    return errors > 0 ? 1 : 0;
+}
@@ -0,0 +1,125 @@
+// Simulation de combats sans affichage, pour l'équilibrage (voir game/battle.h)
+//
+//   battlesim [combats] [graine]
+//
+// Tire des couples d'espèces et de niveaux, simule tous les combats en parallèle
+// avec Battle_simulateBatch, puis les rejoue sur le thread principal : chaque
+// combat ayant sa graine, les deux passes doivent donner exactement les mêmes
+// résultats. Affiche le taux de victoire de chaque espèce ; code de sortie non
+// nul si la base est absente ou si un résultat diffère entre les deux passes.
+#include "../game/battle.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define DEFAULT_BATTLES 100000
+#define MAX_SPECIES 1024
+#define MIN_LEVEL 5
+#define MAX_LEVEL 50
+
+static double elapsed_ms(Uint64 start)
+{
+    return (SDL_GetPerformanceCounter() - start) * 1000.0 / SDL_GetPerformanceFrequency();
+}
+
+int main(int argc, char **argv)
+{
+    int count = argc > 1 ? atoi(argv[1]) : DEFAULT_BATTLES;
+    uint64_t seed = argc > 2 ? strtoull(argv[2], NULL, 10) : 1;
+    if (count <= 0)
+    {
+        fprintf(stderr, "usage: %s [combats] [graine]\n", argv[0]);
+        return 1;
+    }
+    if (!Database_load(DATABASE_PATH))
+        return 1;
+
+    // Identifiants des espèces (ils ne sont pas forcément contigus)
+    uint16_t species[MAX_SPECIES];
+    int species_count = 0;
+    for (uint32_t id = 0; id < DATABASE_NO_INDEX && species_count < Species_count() && species_count < MAX_SPECIES; id++)
+    {
+        if (Species_get((uint16_t)id))
+            species[species_count++] = (uint16_t)id;
+    }
+    if (species_count == 0)
+    {
+        fprintf(stderr, "Aucune espèce dans %s\n", DATABASE_PATH);
+        return 1;
+    }
+
+    BattleSim *parallel = malloc(count * sizeof(BattleSim));
+    BattleSim *serial = malloc(count * sizeof(BattleSim));
+    JobSystem *jobs = JobSystem_create(0);
+    if (!parallel || !serial || !jobs)
+    {
+        fprintf(stderr, "Erreur d'allocation mémoire pour la simulation.\n");
+        return 1;
+    }
+
+    Random rng;
+    Random_seed(&rng, seed);
+    for (int i = 0; i < count; i++)
+    {
+        BattleSim *sim = &parallel[i];
+        memset(sim, 0, sizeof(BattleSim));
+        for (int side = 0; side < 2; side++)
+        {
+            sim->species[side] = species[Random_range(&rng, species_count)];
+            sim->level[side] = (uint8_t)Random_between(&rng, MIN_LEVEL, MAX_LEVEL);
+        }
+        sim->seed = ((uint64_t)Random_next(&rng) << 32) | Random_next(&rng);
+    }
+    memcpy(serial, parallel, count * sizeof(BattleSim));
+
+    Uint64 start = SDL_GetPerformanceCounter();
+    Battle_simulateBatch(jobs, parallel, count);
+    double parallel_ms = elapsed_ms(start);
+
+    start = SDL_GetPerformanceCounter();
+    Battle_simulateBatch(NULL, serial, count);
+    double serial_ms = elapsed_ms(start);
+
+    int mismatches = 0;
+    for (int i = 0; i < count; i++)
+    {
+        if (parallel[i].result != serial[i].result || parallel[i].turns != serial[i].turns)
+        {
+            if (mismatches++ < 10)
+                fprintf(stderr, "Combat %d : résultats différents entre les deux passes\n", i);
+        }
+    }
+
+    // Victoires par espèce, dans l'ordre des identifiants
+    static int slot[DATABASE_NO_INDEX], fights[MAX_SPECIES], wins[MAX_SPECIES];
+    for (int s = 0; s < species_count; s++)
+        slot[species[s]] = s;
+    for (int i = 0; i < count; i++)
+    {
+        for (int side = 0; side < 2; side++)
+        {
+            int s = slot[parallel[i].species[side]];
+            fights[s]++;
+            if (parallel[i].result == (side == 0 ? BATTLE_WON : BATTLE_LOST))
+                wins[s]++;
+        }
+    }
+    for (int s = 0; s < species_count; s++)
+    {
+        if (fights[s] > 0)
+            printf("%-16s %6.2f %% (%d combats)\n", Species_name(Species_get(species[s])), wins[s] * 100.0 / fights[s], fights[s]);
+    }
+    printf("%d combats : %.1f ms sur %d threads, %.1f ms sur un seul\n", count, parallel_ms, jobs->worker_count + 1, serial_ms);
+
+    JobSystem_free(jobs);
+    free(parallel);
+    free(serial);
+    Database_unload();
+
+    if (mismatches > 0)
+    {
+        fprintf(stderr, "%d combats sur %d diffèrent entre la simulation parallèle et séquentielle\n", mismatches, count);
+        return 1;
+    }
+    return 0;
+}
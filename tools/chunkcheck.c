@@ -0,0 +1,70 @@
+// Vérification du chargement des cartes infinies (voir framework/chunkmap.h)
+//
+//   chunkcheck [carte.tmx]
+//
+// Indexe la carte, décode tous ses chunks puis compare chaque calque au premier :
+// la carte de test (resources/maps/infinite_test.tmx) contient les mêmes tuiles
+// en csv, base64, zlib, gzip et XML, dans des chunks de coordonnées négatives.
+// Code de sortie non nul si un chunk ne se décode pas ou diffère du premier calque.
+#include "../framework/chunkmap.h"
+#include <stdio.h>
+#include <string.h>
+
+#define DEFAULT_MAP "resources/maps/infinite_test.tmx"
+
+// Compare les chunks de 'layer' à ceux de 'reference', retourne le nombre d'erreurs
+static int compare_layer(ChunkedMap *cm, ChunkLayer *reference, ChunkLayer *layer)
+{
+    int errors = 0;
+    for (int b = 0; b < reference->bucket_count; b++)
+    {
+        for (MapChunk *ref = reference->buckets[b]; ref; ref = ref->next)
+        {
+            MapChunk *chunk = ChunkLayer_getChunk(cm, layer, ref->x, ref->y);
+            size_t count = (size_t)ref->width * ref->height;
+            if (!chunk || !chunk->gids || !ref->gids)
+            {
+                fprintf(stderr, "Calque '%s' : chunk (%d, %d) absent ou non décodé\n", layer->name, ref->x, ref->y);
+                errors++;
+            }
+            else if (chunk->width != ref->width || chunk->height != ref->height ||
+                     memcmp(chunk->gids, ref->gids, count * sizeof(uint32_t)) != 0 ||
+                     memcmp(chunk->transforms, ref->transforms, count) != 0)
+            {
+                fprintf(stderr, "Calque '%s' : chunk (%d, %d) différent de '%s'\n", layer->name, ref->x, ref->y, reference->name);
+                errors++;
+            }
+        }
+    }
+    if (layer->chunk_count != reference->chunk_count)
+    {
+        fprintf(stderr, "Calque '%s' : %d chunks au lieu de %d\n", layer->name, layer->chunk_count, reference->chunk_count);
+        errors++;
+    }
+    return errors;
+}
+
+int main(int argc, char **argv)
+{
+    const char *path = argc > 1 ? argv[1] : DEFAULT_MAP;
+    ChunkedMap *cm = ChunkedMap_load(path);
+    if (!cm || !cm->layers)
+    {
+        fprintf(stderr, "%s n'est pas une carte infinie avec des calques de tuiles\n", path);
+        ChunkedMap_free(cm);
+        return 1;
+    }
+
+    // Une vue qui couvre toute la carte : tous les chunks deviennent résidents
+    SDL_Rect view = {cm->min_x * cm->tile_width, cm->min_y * cm->tile_height,
+                     (cm->max_x - cm->min_x) * cm->tile_width, (cm->max_y - cm->min_y) * cm->tile_height};
+    ChunkedMap_update(cm, view, 0);
+
+    int errors = 0;
+    for (ChunkLayer *layer = cm->layers->next; layer; layer = layer->next)
+        errors += compare_layer(cm, cm->layers, layer);
+
+    printf("%s : tuiles (%d, %d) à (%d, %d), %d chunks décodés\n", path, cm->min_x, cm->min_y, cm->max_x, cm->max_y, cm->resident_count);
+    ChunkedMap_free(cm);
+    return errors > 0 ? 1 : 0;
+}
@@ -0,0 +1,405 @@
+// Compile les CSV des espèces, des attaques et des objets en base binaire (voir game/database.h)
+//
+//   dbcompile species.csv moves.csv items.csv pokedex.db
+//
+// moves.csv   : id,name,type,category,power,accuracy,pp,priority
+// species.csv : id,name,type1,type2,hp,attack,defense,sp_attack,sp_defense,speed,sprite,moves
+// items.csv   : id,name,category,price,param
+// La première ligne (en-têtes) est ignorée, '#' commence un commentaire. Les champs
+// ne sont pas entre guillemets. 'moves' liste au plus 4 noms d'attaques séparés par ';'.
+#include "../game/database.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+
+#define MAX_FIELDS 16
+#define MAX_LINE 1024
+#define MAX_ID 0xFFFE
+
+typedef struct
+{
+    char *data;
+    uint32_t size, capacity;
+} StringPool;
+
+typedef struct
+{
+    const char *file;
+    int line;
+} Source;
+
+static bool failed = false;
+
+static void error(Source *src, const char *message, const char *value)
+{
+    fprintf(stderr, "%s:%d: %s%s%s\n", src->file, src->line, message, value ? " " : "", value ? value : "");
+    failed = true;
+}
+
+// Ajoute une chaîne (une seule copie par contenu), retourne son décalage
+static uint32_t pool_add(StringPool *pool, const char *str)
+{
+    size_t len = strlen(str) + 1;
+    for (uint32_t at = 0; at < pool->size; at += strlen(pool->data + at) + 1)
+    {
+        if (strcmp(pool->data + at, str) == 0)
+            return at;
+    }
+    if (pool->size + len > pool->capacity)
+    {
+        uint32_t capacity = pool->capacity ? pool->capacity * 2 : 4096;
+        while (capacity < pool->size + len)
+            capacity *= 2;
+        char *data = realloc(pool->data, capacity);
+        if (!data)
+        {
+            fprintf(stderr, "Erreur d'allocation mémoire pour la table de chaînes.\n");
+            exit(1);
+        }
+        pool->data = data;
+        pool->capacity = capacity;
+    }
+    memcpy(pool->data + pool->size, str, len);
+    pool->size += len;
+    return pool->size - len;
+}
+
+static char *trim(char *s)
+{
+    while (isspace((unsigned char)*s))
+        s++;
+    char *end = s + strlen(s);
+    while (end > s && isspace((unsigned char)end[-1]))
+        *--end = '\0';
+    return s;
+}
+
+// Découpe une ligne sur les virgules (modifiée sur place), retourne le nombre de champs
+static int split_fields(char *line, char **fields)
+{
+    int count = 0;
+    char *p = line;
+    while (count < MAX_FIELDS)
+    {
+        char *comma = strchr(p, ',');
+        if (comma)
+            *comma = '\0';
+        fields[count++] = trim(p);
+        if (!comma)
+            break;
+        p = comma + 1;
+    }
+    return count;
+}
+
+static int parse_int(Source *src, const char *field, int min, int max)
+{
+    char *end;
+    long v = strtol(field, &end, 10);
+    if (*field == '\0' || *end != '\0' || v < min || v > max)
+    {
+        error(src, "nombre invalide", field);
+        return min;
+    }
+    return (int)v;
+}
+
+static uint8_t parse_type(Source *src, const char *field, bool optional)
+{
+    if (optional && *field == '\0')
+        return TYPE_NONE;
+    ElementType t = ElementType_parse(field);
+    if (t == TYPE_NONE)
+        error(src, "type inconnu", field);
+    return (uint8_t)t;
+}
+
+static uint8_t parse_category(Source *src, const char *field)
+{
+    if (strcmp(field, "physical") == 0)
+        return MOVE_PHYSICAL;
+    if (strcmp(field, "special") == 0)
+        return MOVE_SPECIAL;
+    if (strcmp(field, "status") == 0)
+        return MOVE_STATUS;
+    error(src, "catégorie inconnue", field);
+    return MOVE_STATUS;
+}
+
+// Lit les lignes de données d'un CSV ; 'row' est appelé pour chacune
+static bool read_csv(const char *path, int expected, void (*row)(Source *, char **, void *), void *user)
+{
+    FILE *file = fopen(path, "r");
+    if (!file)
+    {
+        fprintf(stderr, "Impossible d'ouvrir %s\n", path);
+        return false;
+    }
+
+    Source src = {path, 0};
+    char line[MAX_LINE];
+    char *fields[MAX_FIELDS];
+    while (fgets(line, sizeof(line), file))
+    {
+        src.line++;
+        char *hash = strchr(line, '#');
+        if (hash)
+            *hash = '\0';
+        char *text = trim(line);
+        if (src.line == 1 || *text == '\0')
+            continue;
+
+        int count = split_fields(text, fields);
+        if (count != expected)
+        {
+            char got[16];
+            snprintf(got, sizeof(got), "%d", count);
+            error(&src, "mauvais nombre de champs :", got);
+            continue;
+        }
+        row(&src, fields, user);
+    }
+    fclose(file);
+    return true;
+}
+
+typedef struct
+{
+    StringPool strings;
+    MoveData *moves;
+    int move_count, move_capacity;
+    SpeciesData *species;
+    int species_count, species_capacity;
+    ItemData *items;
+    int item_count, item_capacity;
+} Compiler;
+
+static void *grow(void *array, int *capacity, int count, size_t size)
+{
+    if (count < *capacity)
+        return array;
+    *capacity = *capacity ? *capacity * 2 : 64;
+    void *p = realloc(array, *capacity * size);
+    if (!p)
+    {
+        fprintf(stderr, "Erreur d'allocation mémoire.\n");
+        exit(1);
+    }
+    return p;
+}
+
+static void move_row(Source *src, char **f, void *user)
+{
+    Compiler *c = user;
+    c->moves = grow(c->moves, &c->move_capacity, c->move_count, sizeof(MoveData));
+    MoveData *m = &c->moves[c->move_count++];
+    memset(m, 0, sizeof(MoveData));
+    m->id = (uint16_t)parse_int(src, f[0], 1, MAX_ID);
+    m->name = pool_add(&c->strings, f[1]);
+    m->type = parse_type(src, f[2], false);
+    m->category = parse_category(src, f[3]);
+    m->power = (uint8_t)parse_int(src, f[4], 0, 255);
+    m->accuracy = (uint8_t)parse_int(src, f[5], 0, 100);
+    m->pp = (uint8_t)parse_int(src, f[6], 1, 64);
+    m->priority = (int8_t)parse_int(src, f[7], -7, 7);
+}
+
+static uint16_t find_move(Compiler *c, const char *name)
+{
+    for (int i = 0; i < c->move_count; i++)
+    {
+        if (strcmp(c->strings.data + c->moves[i].name, name) == 0)
+            return c->moves[i].id;
+    }
+    return 0;
+}
+
+static void species_row(Source *src, char **f, void *user)
+{
+    Compiler *c = user;
+    c->species = grow(c->species, &c->species_capacity, c->species_count, sizeof(SpeciesData));
+    SpeciesData *s = &c->species[c->species_count++];
+    memset(s, 0, sizeof(SpeciesData));
+    s->id = (uint16_t)parse_int(src, f[0], 1, MAX_ID);
+    s->name = pool_add(&c->strings, f[1]);
+    s->types[0] = parse_type(src, f[2], false);
+    s->types[1] = parse_type(src, f[3], true);
+    for (int stat = 0; stat < STAT_COUNT; stat++)
+        s->base[stat] = (uint8_t)parse_int(src, f[4 + stat], 1, 255);
+    s->sprite = pool_add(&c->strings, f[10]);
+
+    int count = 0;
+    for (char *name = strtok(f[11], ";"); name; name = strtok(NULL, ";"))
+    {
+        name = trim(name);
+        if (*name == '\0')
+            continue;
+        uint16_t id = find_move(c, name);
+        if (!id)
+            error(src, "attaque inconnue", name);
+        else if (count >= SPECIES_MAX_MOVES)
+            error(src, "trop d'attaques pour", f[1]);
+        else
+            s->moves[count++] = id;
+    }
+}
+
+static void item_row(Source *src, char **f, void *user)
+{
+    Compiler *c = user;
+    c->items = grow(c->items, &c->item_capacity, c->item_count, sizeof(ItemData));
+    ItemData *it = &c->items[c->item_count++];
+    memset(it, 0, sizeof(ItemData));
+    it->id = (uint16_t)parse_int(src, f[0], 1, MAX_ID);
+    it->name = pool_add(&c->strings, f[1]);
+    int category = ItemCategory_parse(f[2]);
+    if (category < 0)
+        error(src, "catégorie d'objet inconnue", f[2]);
+    it->category = (uint8_t)(category < 0 ? ITEM_MISC : category);
+    it->price = (uint16_t)parse_int(src, f[3], 0, 65535);
+    it->param = (uint16_t)parse_int(src, f[4], 0, 65535);
+}
+
+// Index id -> enregistrement ; refuse les identifiants en double
+static uint16_t *build_index(const char *what, const uint16_t *ids, size_t stride, int count, uint32_t *indexCount)
+{
+    uint32_t max = 0;
+    for (int i = 0; i < count; i++)
+    {
+        uint16_t id = *(const uint16_t *)((const char *)ids + i * stride);
+        if (id > max)
+            max = id;
+    }
+
+    *indexCount = max + 1;
+    uint16_t *index = malloc(*indexCount * sizeof(uint16_t));
+    if (!index)
+    {
+        fprintf(stderr, "Erreur d'allocation mémoire.\n");
+        exit(1);
+    }
+    for (uint32_t i = 0; i < *indexCount; i++)
+        index[i] = DATABASE_NO_INDEX;
+
+    for (int i = 0; i < count; i++)
+    {
+        uint16_t id = *(const uint16_t *)((const char *)ids + i * stride);
+        if (index[id] != DATABASE_NO_INDEX)
+        {
+            fprintf(stderr, "%s: identifiant %d en double\n", what, id);
+            failed = true;
+        }
+        index[id] = (uint16_t)i;
+    }
+    return index;
+}
+
+static uint32_t align4(uint32_t v)
+{
+    return (v + 3u) & ~3u;
+}
+
+static bool write_padding(FILE *file, uint32_t *at, uint32_t to)
+{
+    static const char zeros[4] = {0};
+    bool ok = fwrite(zeros, 1, to - *at, file) == to - *at;
+    *at = to;
+    return ok;
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc != 5)
+    {
+        fprintf(stderr, "Usage: %s species.csv moves.csv items.csv sortie.db\n", argv[0]);
+        return 1;
+    }
+
+    Compiler c = {0};
+    pool_add(&c.strings, ""); // Décalage 0 : chaîne vide
+
+    // Les attaques d'abord : les espèces y font référence par nom
+    if (!read_csv(argv[2], 8, move_row, &c) || !read_csv(argv[1], 12, species_row, &c) ||
+        !read_csv(argv[3], 5, item_row, &c))
+        return 1;
+
+    if (c.species_count == 0 || c.move_count == 0)
+    {
+        fprintf(stderr, "Aucune espèce ou aucune attaque, base non générée.\n");
+        return 1;
+    }
+
+    DatabaseHeader h = {0};
+    uint16_t *species_index = build_index("species", &c.species[0].id, sizeof(SpeciesData), c.species_count, &h.species_index_count);
+    uint16_t *move_index = build_index("moves", &c.moves[0].id, sizeof(MoveData), c.move_count, &h.move_index_count);
+    uint16_t *item_index = build_index("items", c.items ? &c.items[0].id : NULL, sizeof(ItemData), c.item_count, &h.item_index_count);
+    if (failed)
+    {
+        fprintf(stderr, "Base non générée.\n");
+        return 1;
+    }
+
+    h.magic = DATABASE_MAGIC;
+    h.version = DATABASE_VERSION;
+    h.species_count = c.species_count;
+    h.move_count = c.move_count;
+    h.item_count = c.item_count;
+    h.strings_size = c.strings.size;
+
+    uint32_t at = sizeof(DatabaseHeader);
+    h.species_offset = align4(at);
+    h.move_offset = align4(h.species_offset + c.species_count * sizeof(SpeciesData));
+    h.species_index_offset = align4(h.move_offset + c.move_count * sizeof(MoveData));
+    h.move_index_offset = align4(h.species_index_offset + h.species_index_count * sizeof(uint16_t));
+    h.item_offset = align4(h.move_index_offset + h.move_index_count * sizeof(uint16_t));
+    h.item_index_offset = align4(h.item_offset + c.item_count * sizeof(ItemData));
+    h.strings_offset = align4(h.item_index_offset + h.item_index_count * sizeof(uint16_t));
+
+    FILE *file = fopen(argv[4], "wb");
+    if (!file)
+    {
+        fprintf(stderr, "Impossible d'écrire %s\n", argv[4]);
+        return 1;
+    }
+
+    bool ok = fwrite(&h, sizeof(h), 1, file) == 1;
+    ok = ok && write_padding(file, &at, h.species_offset) &&
+         fwrite(c.species, sizeof(SpeciesData), c.species_count, file) == (size_t)c.species_count;
+    at = h.species_offset + c.species_count * sizeof(SpeciesData);
+    ok = ok && write_padding(file, &at, h.move_offset) &&
+         fwrite(c.moves, sizeof(MoveData), c.move_count, file) == (size_t)c.move_count;
+    at = h.move_offset + c.move_count * sizeof(MoveData);
+    ok = ok && write_padding(file, &at, h.species_index_offset) &&
+         fwrite(species_index, sizeof(uint16_t), h.species_index_count, file) == h.species_index_count;
+    at = h.species_index_offset + h.species_index_count * sizeof(uint16_t);
+    ok = ok && write_padding(file, &at, h.move_index_offset) &&
+         fwrite(move_index, sizeof(uint16_t), h.move_index_count, file) == h.move_index_count;
+    at = h.move_index_offset + h.move_index_count * sizeof(uint16_t);
+    ok = ok && write_padding(file, &at, h.item_offset) &&
+         fwrite(c.items, sizeof(ItemData), c.item_count, file) == (size_t)c.item_count;
+    at = h.item_offset + c.item_count * sizeof(ItemData);
+    ok = ok && write_padding(file, &at, h.item_index_offset) &&
+         fwrite(item_index, sizeof(uint16_t), h.item_index_count, file) == h.item_index_count;
+    at = h.item_index_offset + h.item_index_count * sizeof(uint16_t);
+    ok = ok && write_padding(file, &at, h.strings_offset) &&
+         fwrite(c.strings.data, 1, c.strings.size, file) == c.strings.size;
+    ok = (fclose(file) == 0) && ok;
+
+    if (!ok)
+    {
+        fprintf(stderr, "Erreur d'écriture de %s\n", argv[4]);
+        remove(argv[4]);
+        return 1;
+    }
+
+    printf("%s: %d espèces, %d attaques, %d objets, %u octets de chaînes\n", argv[4], c.species_count, c.move_count, c.item_count, c.strings.size);
+    free(species_index);
+    free(move_index);
+    free(item_index);
+    free(c.items);
+    free(c.species);
+    free(c.moves);
+    free(c.strings.data);
+    return 0;
+}